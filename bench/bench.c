@@ -0,0 +1,659 @@
+// RayUI widget microbenchmarks
+//
+// Runs the update and draw paths of every widget against the null backend and
+// prints one JSON object per case:
+//   {"case":"button","param":1000,"frames":200,"ns_per_widget":..,"p50_ms":..,
+//    "p99_ms":..,"draws_per_frame":..,"allocs_per_frame":..}
+// The stress case updates and draws 10k mixed widgets and fails the run
+// (exit code 1) when its p99 frame time exceeds --budget-ms. With --threads N
+// its widgets are updated through RayUIUpdateWidgets on N threads. The
+// layout_color_picker check fails the run when a laid-out picker leaves its cell,
+// layout_slider when a laid-out slider's knob is off-centre or outside its cell.
+// text_area_long_line types at the end of one line of up to 10 MB.
+//
+// Usage: bench [--frames N] [--budget-ms MS] [--filter NAME] [--deferred] [--hit-index] [--threads N]
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static unsigned long long benchAllocs = 0;
+
+static void* BenchMalloc(size_t size) { benchAllocs++; return malloc(size); }
+static void* BenchCalloc(size_t count, size_t size) { benchAllocs++; return calloc(count, size); }
+static void* BenchRealloc(void* ptr, size_t size) { benchAllocs++; return realloc(ptr, size); }
+
+#define RAYUI_MALLOC(size) BenchMalloc(size)
+#define RAYUI_CALLOC(count, size) BenchCalloc(count, size)
+#define RAYUI_REALLOC(ptr, size) BenchRealloc(ptr, size)
+#define RAYUI_FREE(ptr) free(ptr)
+
+#define RAYUI_BACKEND_NULL
+#define RAYUI_THREADS
+#define RAYUI_IMPLEMENTATION
+#include <rayui.h>
+
+#define MAX_FRAMES 100000
+#define WARMUP_FRAMES 10
+
+static double NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int CompareDouble(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// ---------------- SCENES ----------------
+
+static Font font;
+static int count;
+static bool deferred = false;
+static bool hitIndex = false;
+static int threads = 1;
+
+static RayUIButton* buttons;
+static RayUIToggleLabel* toggles;
+static RayUICheckbox* checkboxes;
+static RayUISlider* sliders;
+static RayUITextInput* textInputs;
+static RayUIProgressBar* progressBars;
+static RayUINumericInput* numericInputs;
+static RayUIDropdown dropdown;
+static const char** dropdownOptions;
+static char* dropdownText;
+static RayUIColorPicker picker;
+static RayUIWidgetSet stressSet;
+static RayUIButtonArray buttonArray;
+static RayUIToggleArray toggleArray;
+static RayUICheckboxArray checkboxArray;
+static RayUILayout layout;
+static RayUITextArea textArea;
+
+// Sweeps the mouse over a 1000x1000 area so hover states change every frame
+static void FeedInput(int frame, bool down) {
+    RayUIInput input = {0};
+    input.mouse = (Vector2){(float)((frame * 37) % 1000), (float)((frame * 91) % 1000)};
+    if (down) input.buttonsDown = 1 << MOUSE_BUTTON_LEFT;
+    input.time = frame / 60.0;
+    input.frameTime = 1.0f / 60.0f;
+    RayUISetFrameInput(&input);
+}
+
+static Vector2 GridPos(int i, float cellW, float cellH) {
+    int cols = 1000 / (int)cellW;
+    return (Vector2){(i % cols) * cellW, (i / cols % (int)(1000 / cellH)) * cellH};
+}
+
+static void SetupButtons(int n) {
+    count = n;
+    buttons = malloc(n * sizeof(*buttons));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 50, 20);
+        buttons[i] = RayUICreateButton(p.x, p.y, 48, 18, "Button");
+    }
+}
+static void FrameButtons(int f) {
+    FeedInput(f, false);
+    for (int i = 0; i < count; i++) RayUIUpdateButton(&buttons[i]);
+    for (int i = 0; i < count; i++) RayUIDrawButton(&buttons[i], font, 10, RAYWHITE, YELLOW);
+}
+static void FreeButtons(void) { free(buttons); }
+
+// The same buttons labelled with an SDF atlas, each run of labels costs a shader switch
+static Font sdfFont;
+static void SetupSDFButtons(int n) {
+    SetupButtons(n);
+    Image atlas = GenImageColor(1, 1, BLANK);
+    sdfFont = GetFontDefault();
+    sdfFont.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    RayUIRegisterSDFFont(sdfFont);
+}
+static void FrameSDFButtons(int f) {
+    FeedInput(f, false);
+    for (int i = 0; i < count; i++) RayUIUpdateButton(&buttons[i]);
+    for (int i = 0; i < count; i++) RayUIDrawButton(&buttons[i], sdfFont, 10, RAYWHITE, YELLOW);
+}
+static void FreeSDFButtons(void) { RayUIUnloadSDFFont(sdfFont); FreeButtons(); }
+
+static void SetupToggles(int n) {
+    count = n;
+    toggles = malloc(n * sizeof(*toggles));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 50, 20);
+        toggles[i] = RayUICreateToggle(p.x, p.y, 48, 18, i & 1, "On", "Off");
+    }
+}
+static void FrameToggles(int f) {
+    FeedInput(f, false);
+    Vector2 mouse = RayUIGetFrameInput()->mouse;
+    for (int i = 0; i < count; i++) RayUIUpdateToggleLabel(&toggles[i], mouse);
+    for (int i = 0; i < count; i++) RayUIDrawToggleLabel(&toggles[i], font, 10, RAYWHITE, YELLOW, DARKGRAY);
+}
+static void FreeToggles(void) { free(toggles); }
+
+static void SetupCheckboxes(int n) {
+    count = n;
+    checkboxes = malloc(n * sizeof(*checkboxes));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 20, 20);
+        checkboxes[i] = RayUICreateCheckbox(p.x, p.y, 18, i & 1);
+    }
+}
+static void FrameCheckboxes(int f) {
+    FeedInput(f, false);
+    Vector2 mouse = RayUIGetFrameInput()->mouse;
+    for (int i = 0; i < count; i++) RayUIUpdateCheckbox(&checkboxes[i], mouse);
+    for (int i = 0; i < count; i++) RayUIDrawCheckbox(&checkboxes[i]);
+}
+static void FreeCheckboxes(void) { free(checkboxes); }
+
+// The same grids as above, stored as widget arrays
+static void SetupButtonArray(int n) {
+    buttonArray = RayUICreateButtonArray();
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 50, 20);
+        RayUIAddButton(&buttonArray, p.x, p.y, 48, 18, "Button");
+    }
+}
+static void FrameButtonArray(int f) {
+    FeedInput(f, false);
+    RayUIUpdateButtons(&buttonArray);
+    RayUIDrawButtons(&buttonArray, font, 10, RAYWHITE, YELLOW);
+}
+static void FreeButtonArray(void) { RayUIFreeButtonArray(&buttonArray); }
+
+static void SetupToggleArray(int n) {
+    toggleArray = RayUICreateToggleArray();
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 50, 20);
+        RayUIAddToggle(&toggleArray, p.x, p.y, 48, 18, i & 1, "On", "Off");
+    }
+}
+static void FrameToggleArray(int f) {
+    FeedInput(f, false);
+    RayUIUpdateToggles(&toggleArray);
+    RayUIDrawToggles(&toggleArray, font, 10, RAYWHITE, YELLOW, DARKGRAY);
+}
+static void FreeToggleArray(void) { RayUIFreeToggleArray(&toggleArray); }
+
+static void SetupCheckboxArray(int n) {
+    checkboxArray = RayUICreateCheckboxArray();
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 20, 20);
+        RayUIAddCheckbox(&checkboxArray, p.x, p.y, 18, i & 1);
+    }
+}
+static void FrameCheckboxArray(int f) {
+    FeedInput(f, false);
+    RayUIUpdateCheckboxes(&checkboxArray);
+    RayUIDrawCheckboxes(&checkboxArray);
+}
+static void FreeCheckboxArray(void) { RayUIFreeCheckboxArray(&checkboxArray); }
+
+static void SetupSliders(int n) {
+    count = n;
+    sliders = malloc(n * sizeof(*sliders));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 100, 20);
+        sliders[i] = RayUICreateSlider((int)p.x + 8, (int)p.y + 5, 84, 0, 100, 0.5f);
+    }
+}
+static void FrameSliders(int f) {
+    FeedInput(f, true);
+    Vector2 mouse = RayUIGetFrameInput()->mouse;
+    for (int i = 0; i < count; i++) RayUIUpdateSlider(&sliders[i], mouse);
+    for (int i = 0; i < count; i++) RayUIDrawSlider(&sliders[i], GRAY, RAYWHITE);
+}
+static void FreeSliders(void) { free(sliders); }
+
+static void SetupTextInputs(int n) {
+    count = n;
+    textInputs = malloc(n * sizeof(*textInputs));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 100, 20);
+        textInputs[i] = RayUICreateTextInput((int)p.x, (int)p.y, 98, 18, "Some text", INPUT_TYPE_TEXT);
+    }
+}
+static void FrameTextInputs(int f) {
+    FeedInput(f, false);
+    for (int i = 0; i < count; i++) RayUIUpdateTextInput(&textInputs[i]);
+    for (int i = 0; i < count; i++) RayUIDrawTextInput(&textInputs[i], font, 10, DARKGRAY, RAYWHITE, YELLOW);
+}
+static void FreeTextInputs(void) {
+    for (int i = 0; i < count; i++) RayUIFreeTextInput(&textInputs[i]);
+    free(textInputs);
+}
+
+static void SetupProgressBars(int n) {
+    count = n;
+    progressBars = malloc(n * sizeof(*progressBars));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 100, 20);
+        progressBars[i] = RayUICreateProgressBar((int)p.x, (int)p.y, 98, 18, (i % 100) / 100.0f);
+    }
+}
+static void FrameProgressBars(int f) {
+    FeedInput(f, false);
+    for (int i = 0; i < count; i++) RayUIUpdateProgressBar(&progressBars[i]);
+    for (int i = 0; i < count; i++) RayUIDrawProgressBar(&progressBars[i], DARKGRAY, GREEN);
+}
+static void FreeProgressBars(void) { free(progressBars); }
+
+static void SetupNumericInputs(int n) {
+    count = n;
+    numericInputs = malloc(n * sizeof(*numericInputs));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 100, 40);
+        numericInputs[i] = RayUICreateNumericInput(p.x, p.y, 98, 38, 5, 0, 10, 0.5f, 1);
+    }
+}
+static void FrameNumericInputs(int f) {
+    FeedInput(f, false);
+    for (int i = 0; i < count; i++) RayUIUpdateNumericInput(&numericInputs[i]);
+    for (int i = 0; i < count; i++) RayUIDrawNumericInput(&numericInputs[i], font, 10, DARKGRAY, RAYWHITE);
+}
+static void FreeNumericInputs(void) { free(numericInputs); }
+
+// One expanded dropdown with `n` options
+static void SetupDropdown(int n) {
+    count = n;
+    dropdownOptions = malloc(n * sizeof(*dropdownOptions));
+    dropdownText = malloc((size_t)n * 24);
+    for (int i = 0; i < n; i++) {
+        snprintf(dropdownText + (size_t)i * 24, 24, "Option %d", i);
+        dropdownOptions[i] = dropdownText + (size_t)i * 24;
+    }
+    dropdown = RayUICreateDropdown(100, 0, 200, 20, dropdownOptions, n, 0);
+    dropdown.expanded = true;
+}
+static void FrameDropdown(int f) {
+    FeedInput(f, false);
+    RayUIUpdateDropdown(&dropdown);
+    dropdown.expanded = true;
+    RayUIDrawDropdownEx(&dropdown, font, 10, DARKGRAY, RAYWHITE, YELLOW, GRAY, LIGHTGRAY, 1, BLACK, "Select");
+}
+static void FreeDropdown(void) { free(dropdownOptions); free(dropdownText); }
+
+// Same, limited to 12 visible rows
+static void SetupDropdownScrolled(int n) {
+    SetupDropdown(n);
+    RayUISetDropdownMaxVisible(&dropdown, 12);
+}
+
+// One expanded HSVA picker of size `n`, dragged every frame
+static void SetupPicker(int n) {
+    count = 1;
+    picker = RayUICreateColorPicker(0, 0, (float)n, RED, COLOR_PICKER_MODE_HSVA);
+    picker.expanded = true;
+}
+static void FramePicker(int f) {
+    FeedInput(f, true);
+    RayUIUpdateColorPicker(&picker);
+    picker.expanded = true;
+    RayUIDrawColorPickerEx(&picker, 1, GRAY, WHITE);
+}
+static void FreePicker(void) { RayUIFreeColorPickerTextures(&picker); }
+
+// Hit kernels: one mouse point against a grid of rects or triangles per frame,
+// through the batch kernels and through the one-shape raylib calls
+static Rectangle* hitRects;
+static Triangle* hitTriangles;
+static unsigned int* hitMask;
+static volatile int hitSink;
+
+static void SetupHitShapes(int n) {
+    count = n;
+    hitRects = malloc(n * sizeof(*hitRects));
+    hitTriangles = malloc(n * sizeof(*hitTriangles));
+    hitMask = malloc((n + 31) / 32 * sizeof(*hitMask));
+    for (int i = 0; i < n; i++) {
+        Vector2 p = GridPos(i, 20, 20);
+        hitRects[i] = (Rectangle){p.x, p.y, 18, 18};
+        hitTriangles[i] = (Triangle){{p.x, p.y + 18}, {p.x + 18, p.y + 18}, {p.x + 9, p.y}};
+    }
+}
+static void FramePointInRects(int f) {
+    FeedInput(f, false);
+    hitSink = RayUIPointInRects(RayUIGetFrameInput()->mouse, hitRects, count, hitMask);
+}
+static void FramePointInRectsScalar(int f) {
+    FeedInput(f, false);
+    Vector2 mouse = RayUIGetFrameInput()->mouse;
+    int hits = 0;
+    for (int i = 0; i < count; i++) hits += CheckCollisionPointRec(mouse, hitRects[i]);
+    hitSink = hits;
+}
+static void FramePointInTriangles(int f) {
+    FeedInput(f, false);
+    hitSink = RayUIPointInTriangles(RayUIGetFrameInput()->mouse, hitTriangles, count, hitMask);
+}
+static void FramePointInTrianglesScalar(int f) {
+    FeedInput(f, false);
+    Vector2 mouse = RayUIGetFrameInput()->mouse;
+    int hits = 0;
+    for (int i = 0; i < count; i++) hits += CheckCollisionPointTriangle(mouse, hitTriangles[i].a, hitTriangles[i].b, hitTriangles[i].c);
+    hitSink = hits;
+}
+static void FreeHitShapes(void) { free(hitRects); free(hitTriangles); free(hitMask); }
+
+// Buttons laid out in rows of 30 inside a padded column. layout_resize
+// switches the window size every frame, layout_dirty resizes one node.
+static void SetupLayout(int n) {
+    SetupButtons(n);
+    layout = RayUICreateLayout((Rectangle){0, 0, 1000, 1000});
+    int column = RayUIAddLayoutColumn(&layout, 0, 0, 0, 2);
+    RayUISetLayoutPadding(&layout, column, 4);
+    int row = -1;
+    for (int i = 0; i < n; i++) {
+        if (i % 30 == 0) row = RayUIAddLayoutRow(&layout, column, 0, 18, 2);
+        RayUIAddLayoutWidget(&layout, row, WIDGET_TYPE_BUTTON, &buttons[i], i % 5 ? 0 : 40, 0);
+    }
+    RayUIUpdateLayout(&layout);
+}
+static void FrameLayoutResize(int f) {
+    RayUISetLayoutBounds(&layout, (Rectangle){0, 0, f & 1 ? 1000 : 800, f & 1 ? 1000 : 600});
+    RayUIUpdateLayout(&layout);
+}
+static void FrameLayoutDirty(int f) {
+    RayUISetLayoutSize(&layout, 2 + f % (layout.count - 2), f & 1 ? 40 : 30, 0);
+    RayUIUpdateLayout(&layout);
+}
+static void FreeLayout(void) { RayUIFreeLayout(&layout); FreeButtons(); }
+
+static bool RectInside(Rectangle r, Rectangle cell) {
+    if (r.width <= 0 || r.height <= 0) return true; // track not used by the mode
+    return r.x >= cell.x && r.y >= cell.y && r.x + r.width <= cell.x + cell.width && r.y + r.height <= cell.y + cell.height;
+}
+
+// Lays out a picker of every mode next to a button and checks that no part
+// of the picker leaves the cell it was given
+static bool CheckLayoutPicker(void) {
+    bool pass = true;
+    for (int mode = COLOR_PICKER_MODE_RGB; mode <= COLOR_PICKER_MODE_HSVA; mode++) {
+        RayUIColorPicker cp = RayUICreateColorPicker(0, 0, 64, RED, mode);
+        RayUIButton next = RayUICreateButton(0, 0, 1, 1, "Next");
+        RayUILayout l = RayUICreateLayout((Rectangle){0, 0, 300, 120});
+        int row = RayUIAddLayoutRow(&l, 0, 0, 0, 4);
+        int node = RayUIAddLayoutWidget(&l, row, WIDGET_TYPE_COLOR_PICKER, &cp, 0, 0);
+        RayUIAddLayoutWidget(&l, row, WIDGET_TYPE_BUTTON, &next, 100, 0);
+        RayUIUpdateLayout(&l);
+        Rectangle cell = RayUIGetLayoutRect(&l, node);
+        pass = pass && RectInside(cp.rect, cell) && RectInside(cp.valueRect, cell) && RectInside(cp.alphaRect, cell);
+        if (mode == COLOR_PICKER_MODE_RGB || mode == COLOR_PICKER_MODE_RGBA) {
+            pass = pass && RectInside(cp.sliderR, cell) && RectInside(cp.sliderG, cell) && RectInside(cp.sliderB, cell);
+        }
+        RayUIFreeLayout(&l);
+        RayUIFreeColorPickerTextures(&cp);
+    }
+    return pass;
+}
+
+// The knob is drawn at bar.y - 5 with size 16x15 around the value's x
+static bool CheckLayoutSlider(void) {
+    RayUISlider s = RayUICreateSlider(0, 0, 50, 0, 100, 0);
+    RayUIProgressBar p = RayUICreateProgressBar(0, 0, 50, 6, 0.5f);
+    RayUILayout l = RayUICreateLayout((Rectangle){0, 0, 300, 120});
+    int row = RayUIAddLayoutRow(&l, 0, 0, 40, 4);
+    int slider = RayUIAddLayoutWidget(&l, row, WIDGET_TYPE_SLIDER, &s, 0, 0);
+    int bar = RayUIAddLayoutWidget(&l, row, WIDGET_TYPE_PROGRESS_BAR, &p, 0, 0);
+    RayUIUpdateLayout(&l);
+    Rectangle cell = RayUIGetLayoutRect(&l, slider);
+    Rectangle low = {s.bar.x - 8, s.bar.y - 5, 16, 15};
+    Rectangle high = {s.bar.x + s.bar.width - 8, s.bar.y - 5, 16, 15};
+    bool pass = s.bar.height == 5 && RectInside(low, cell) && RectInside(high, cell)
+        && fabsf((low.y + low.height/2) - (cell.y + cell.height/2)) <= 0.5f;
+    Rectangle barCell = RayUIGetLayoutRect(&l, bar);
+    pass = pass && p.bar.height == 6 && RectInside(p.bar, barCell)
+        && fabsf((p.bar.y + p.bar.height/2) - (barCell.y + barCell.height/2)) <= 0.5f;
+    RayUIFreeLayout(&l);
+    return pass;
+}
+
+// One line of n bytes, typed into at its end so the view stays scrolled far
+// right; the frame cost should not grow with n
+static void SetupLongLine(int n) {
+    char* text = malloc(n + 1);
+    for (int i = 0; i < n; i++) text[i] = 'a' + i % 26;
+    text[n] = '\0';
+    textArea = RayUICreateTextArea(0, 0, 600, 400, text);
+    free(text);
+    textArea.focused = true;
+    RayUISetTextAreaCaret(&textArea, n);
+}
+static void FrameLongLine(int f) {
+    RayUIInput input = {0};
+    input.chars[input.charCount++] = 'a' + f % 26;
+    input.time = f / 60.0;
+    input.frameTime = 1.0f / 60.0f;
+    RayUISetFrameInput(&input);
+    RayUIUpdateTextArea(&textArea);
+    RayUIDrawTextArea(&textArea, font, 10, DARKGRAY, RAYWHITE, YELLOW);
+}
+static void FreeLongLine(void) { RayUIFreeTextArea(&textArea); }
+
+// 10k widgets of mixed types, the frame-budget scene
+static void SetupStress(int n) {
+    int per = n / 5;
+    SetupButtons(per);
+    SetupCheckboxes(per);
+    SetupSliders(per);
+    SetupTextInputs(per);
+    SetupProgressBars(per);
+    count = per;
+    stressSet = RayUICreateWidgetSet();
+    for (int i = 0; i < per; i++) {
+        RayUIAddWidget(&stressSet, WIDGET_TYPE_BUTTON, &buttons[i]);
+        RayUIAddWidget(&stressSet, WIDGET_TYPE_CHECKBOX, &checkboxes[i]);
+        RayUIAddWidget(&stressSet, WIDGET_TYPE_SLIDER, &sliders[i]);
+        RayUIAddWidget(&stressSet, WIDGET_TYPE_TEXT_INPUT, &textInputs[i]);
+        RayUIAddWidget(&stressSet, WIDGET_TYPE_PROGRESS_BAR, &progressBars[i]);
+    }
+}
+static void FrameStress(int f) {
+    FeedInput(f, false);
+    if (threads > 1) {
+        RayUIUpdateWidgets(&stressSet, NULL);
+    } else {
+        Vector2 mouse = RayUIGetFrameInput()->mouse;
+        for (int i = 0; i < count; i++) {
+            RayUIUpdateButton(&buttons[i]);
+            RayUIUpdateCheckbox(&checkboxes[i], mouse);
+            RayUIUpdateSlider(&sliders[i], mouse);
+            RayUIUpdateTextInput(&textInputs[i]);
+            RayUIUpdateProgressBar(&progressBars[i]);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        RayUIDrawButton(&buttons[i], font, 10, RAYWHITE, YELLOW);
+        RayUIDrawCheckbox(&checkboxes[i]);
+        RayUIDrawSlider(&sliders[i], GRAY, RAYWHITE);
+        RayUIDrawTextInput(&textInputs[i], font, 10, DARKGRAY, RAYWHITE, YELLOW);
+        RayUIDrawProgressBar(&progressBars[i], DARKGRAY, GREEN);
+    }
+}
+static void FreeStress(void) {
+    RayUIFreeWidgetSet(&stressSet);
+    FreeButtons(); FreeCheckboxes(); FreeSliders(); FreeTextInputs(); FreeProgressBars();
+}
+
+// ---------------- RUNNER ----------------
+
+typedef struct Result {
+    double p50, p99, nsPerWidget;
+    double drawsPerFrame, allocsPerFrame;
+} Result;
+
+static double* samples;
+
+static Result RunCase(const char* name, int param, int widgets, int frames,
+                      void (*setup)(int), void (*frame)(int), void (*teardown)(void)) {
+    Result r = {0};
+    setup(param);
+
+    for (int f = 0; f < WARMUP_FRAMES; f++) {
+        frame(f);
+        if (deferred) RayUIFlush();
+        EndDrawing();
+    }
+
+    RayUIResetNullBackendStats();
+    unsigned long long allocs = benchAllocs;
+    double total = 0;
+    for (int f = 0; f < frames; f++) {
+        double t0 = NowNs();
+        frame(WARMUP_FRAMES + f);
+        if (deferred) RayUIFlush();
+        samples[f] = NowNs() - t0;
+        total += samples[f];
+        EndDrawing();
+    }
+    RayUINullBackendStats stats = RayUIGetNullBackendStats();
+
+    qsort(samples, frames, sizeof(double), CompareDouble);
+    r.p50 = samples[frames / 2] / 1e6;
+    r.p99 = samples[(int)((frames - 1) * 0.99)] / 1e6;
+    r.nsPerWidget = total / frames / (widgets > 0 ? widgets : 1);
+    r.drawsPerFrame = (double)stats.drawCalls / frames;
+    r.allocsPerFrame = (double)(benchAllocs - allocs) / frames;
+
+    teardown();
+    RayUIFreeHitIndex();
+    RayUIFreeHoverInfo();
+
+    printf("{\"case\":\"%s\",\"param\":%d,\"frames\":%d,\"deferred\":%s,\"hit_index\":%s,\"threads\":%d,\"ns_per_widget\":%.1f,"
+           "\"p50_ms\":%.4f,\"p99_ms\":%.4f,\"draws_per_frame\":%.1f,\"allocs_per_frame\":%.2f",
+           name, param, frames, deferred ? "true" : "false", hitIndex ? "true" : "false", threads, r.nsPerWidget,
+           r.p50, r.p99, r.drawsPerFrame, r.allocsPerFrame);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int frames = 200;
+    double budgetMs = 16.6;
+    const char* filter = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) budgetMs = atof(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--deferred") == 0) deferred = true;
+        else if (strcmp(argv[i], "--hit-index") == 0) hitIndex = true;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--frames N] [--budget-ms MS] [--filter NAME] [--deferred] [--hit-index] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1) frames = 1;
+    if (frames > MAX_FRAMES) frames = MAX_FRAMES;
+
+    InitWindow(1000, 1000, "RayUI bench");
+    RayUISetNullBackendFrames(-1);
+    RayUISetDeferredDrawing(deferred);
+    RayUISetHitIndex(hitIndex);
+    RayUISetUpdateThreads(threads);
+    font = GetFontDefault();
+    samples = malloc(frames * sizeof(double));
+
+    static const int widgetCounts[] = {10, 100, 1000, 10000};
+    static const int optionCounts[] = {5, 50, 500, 5000, 50000};
+    static const int pickerSizes[] = {64, 128, 256, 512};
+    static const int lineLengths[] = {10000, 100000, 1000000, 10000000};
+
+    static const struct {
+        const char* name;
+        void (*setup)(int);
+        void (*frame)(int);
+        void (*teardown)(void);
+    } widgets[] = {
+        {"button", SetupButtons, FrameButtons, FreeButtons},
+        {"button_sdf", SetupSDFButtons, FrameSDFButtons, FreeSDFButtons},
+        {"toggle", SetupToggles, FrameToggles, FreeToggles},
+        {"checkbox", SetupCheckboxes, FrameCheckboxes, FreeCheckboxes},
+        {"button_array", SetupButtonArray, FrameButtonArray, FreeButtonArray},
+        {"toggle_array", SetupToggleArray, FrameToggleArray, FreeToggleArray},
+        {"checkbox_array", SetupCheckboxArray, FrameCheckboxArray, FreeCheckboxArray},
+        {"point_in_rects", SetupHitShapes, FramePointInRects, FreeHitShapes},
+        {"point_in_rects_scalar", SetupHitShapes, FramePointInRectsScalar, FreeHitShapes},
+        {"point_in_triangles", SetupHitShapes, FramePointInTriangles, FreeHitShapes},
+        {"point_in_triangles_scalar", SetupHitShapes, FramePointInTrianglesScalar, FreeHitShapes},
+        {"layout_resize", SetupLayout, FrameLayoutResize, FreeLayout},
+        {"layout_dirty", SetupLayout, FrameLayoutDirty, FreeLayout},
+        {"slider", SetupSliders, FrameSliders, FreeSliders},
+        {"text_input", SetupTextInputs, FrameTextInputs, FreeTextInputs},
+        {"progress_bar", SetupProgressBars, FrameProgressBars, FreeProgressBars},
+        {"numeric_input", SetupNumericInputs, FrameNumericInputs, FreeNumericInputs},
+    };
+
+    for (size_t w = 0; w < sizeof(widgets) / sizeof(widgets[0]); w++) {
+        if (filter && strcmp(filter, widgets[w].name) != 0) continue;
+        for (size_t i = 0; i < sizeof(widgetCounts) / sizeof(widgetCounts[0]); i++) {
+            RunCase(widgets[w].name, widgetCounts[i], widgetCounts[i], frames,
+                    widgets[w].setup, widgets[w].frame, widgets[w].teardown);
+            printf("}\n");
+        }
+    }
+
+    if (!filter || strcmp(filter, "dropdown") == 0) {
+        for (size_t i = 0; i < sizeof(optionCounts) / sizeof(optionCounts[0]); i++) {
+            RunCase("dropdown", optionCounts[i], optionCounts[i], frames, SetupDropdown, FrameDropdown, FreeDropdown);
+            printf("}\n");
+        }
+    }
+
+    if (!filter || strcmp(filter, "dropdown_scrolled") == 0) {
+        for (size_t i = 0; i < sizeof(optionCounts) / sizeof(optionCounts[0]); i++) {
+            RunCase("dropdown_scrolled", optionCounts[i], optionCounts[i], frames, SetupDropdownScrolled, FrameDropdown, FreeDropdown);
+            printf("}\n");
+        }
+    }
+
+    if (!filter || strcmp(filter, "color_picker") == 0) {
+        for (size_t i = 0; i < sizeof(pickerSizes) / sizeof(pickerSizes[0]); i++) {
+            RunCase("color_picker", pickerSizes[i], 1, frames, SetupPicker, FramePicker, FreePicker);
+            printf("}\n");
+        }
+    }
+
+    if (!filter || strcmp(filter, "text_area_long_line") == 0) {
+        for (size_t i = 0; i < sizeof(lineLengths) / sizeof(lineLengths[0]); i++) {
+            RunCase("text_area_long_line", lineLengths[i], 1, frames, SetupLongLine, FrameLongLine, FreeLongLine);
+            printf("}\n");
+        }
+    }
+
+    int status = 0;
+    if (!filter || strcmp(filter, "layout_color_picker") == 0) {
+        bool pass = CheckLayoutPicker();
+        printf("{\"case\":\"layout_color_picker\",\"pass\":%s}\n", pass ? "true" : "false");
+        if (!pass) status = 1;
+    }
+
+    if (!filter || strcmp(filter, "layout_slider") == 0) {
+        bool pass = CheckLayoutSlider();
+        printf("{\"case\":\"layout_slider\",\"pass\":%s}\n", pass ? "true" : "false");
+        if (!pass) status = 1;
+    }
+
+    if (!filter || strcmp(filter, "stress") == 0) {
+        Result r = RunCase("stress", 10000, 10000, frames, SetupStress, FrameStress, FreeStress);
+        bool pass = r.p99 <= budgetMs;
+        printf(",\"budget_ms\":%.3f,\"pass\":%s}\n", budgetMs, pass ? "true" : "false");
+        if (!pass) status = 1;
+    }
+
+    free(samples);
+    RayUISetUpdateThreads(1);
+    RayUIFreeDrawCommands();
+    CloseWindow();
+    return status;
+}
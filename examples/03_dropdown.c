@@ -20,6 +20,8 @@ int main() {
     Font font = GetFontDefault();
 
     while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
         BeginDrawing();
         ClearBackground(DARKGRAY);
 
@@ -12,6 +12,8 @@ int main() {
     Font font = GetFontDefault();
 
     while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
         BeginDrawing();
         ClearBackground(DARKGRAY);
 
@@ -27,6 +29,7 @@ int main() {
         EndDrawing();
     }
 
+    RayUIFreeTextInput(&textInput);
     CloseWindow();
     return 0;
 }
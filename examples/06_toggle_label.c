@@ -11,6 +11,8 @@ int main() {
     Font font = GetFontDefault();
 
     while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
         Vector2 mousePoint = GetMousePosition();
 
         BeginDrawing();
@@ -13,6 +13,8 @@ int main() {
     Font font = GetFontDefault();
 
     while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
         Vector2 mousePoint = GetMousePosition();
 
         BeginDrawing();
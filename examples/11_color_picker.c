@@ -11,6 +11,8 @@ int main() {
     Font font = GetFontDefault();
 
     while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
         BeginDrawing();
         ClearBackground(DARKGRAY);
 
@@ -30,6 +32,7 @@ int main() {
         EndDrawing();
     }
 
+    RayUIFreeColorPickerTextures(&colorPicker);
     CloseWindow();
     return 0;
 }
@@ -0,0 +1,40 @@
+#include <raylib.h>
+#include <math.h>
+
+#define RAYUI_IMPLEMENTATION
+#include <rayui.h>
+
+int main(int argc, char** argv) {
+    InitWindow(800, 600, "RayUI Text Area Example");
+    SetTargetFPS(60);
+
+    RayUITextArea textArea = RayUICreateTextArea(50, 50, 700, 480, "");
+    Font font = GetFontDefault();
+
+    // Open the file given on the command line, or fill the area with a log
+    if (argc < 2 || !RayUILoadTextAreaFile(&textArea, argv[1])) {
+        for (int i = 0; i < 10000; i++) {
+            RayUIAppendTextArea(&textArea, TextFormat("[%05d] Everything is fine, nothing to report.\n", i));
+        }
+    }
+
+    while (!WindowShouldClose()) {
+        RayUIBeginFrame();
+
+        BeginDrawing();
+        ClearBackground(DARKGRAY);
+
+        RayUIUpdateTextArea(&textArea);
+
+        RayUIDrawTextArea(&textArea, font, 20, BLACK, LIGHTGRAY, WHITE);
+
+        DrawText(TextFormat("Line %d of %d", RayUIGetTextAreaLine(&textArea, textArea.caret) + 1,
+                            RayUIGetTextAreaLineCount(&textArea)), 50, 545, 20, GREEN);
+
+        EndDrawing();
+    }
+
+    RayUIFreeTextArea(&textArea);
+    CloseWindow();
+    return 0;
+}
@@ -8,16 +8,63 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 
 #ifndef DEFAULT_HOVER_INFO_DELAY
 #define DEFAULT_HOVER_INFO_DELAY 0.7
 #endif
-#ifndef MAX_HOVERABLES
-#define MAX_HOVERABLES 256
-#endif
 #ifndef CHECKBOX_DEFAULT_TEXTURE_SIZE
 #define CHECKBOX_DEFAULT_TEXTURE_SIZE 32
 #endif
+#ifndef RAYUI_TEXT_CACHE_SIZE
+#define RAYUI_TEXT_CACHE_SIZE 1024
+#endif
+#ifndef RAYUI_HIT_CELL_SIZE
+#define RAYUI_HIT_CELL_SIZE 64
+#endif
+
+#ifndef RAYUI_HIT_BUCKETS
+#define RAYUI_HIT_BUCKETS 1024
+#endif
+
+#ifndef RAYUI_INPUT_MAX_KEYS
+#define RAYUI_INPUT_MAX_KEYS 16
+#endif
+
+#ifndef RAYUI_INPUT_MAX_CHARS
+#define RAYUI_INPUT_MAX_CHARS 32
+#endif
+
+#define RAYUI_INPUT_KEY_BITS 512
+
+#ifndef RAYUI_DROPDOWN_QUERY_SIZE
+#define RAYUI_DROPDOWN_QUERY_SIZE 64
+#endif
+
+#ifndef RAYUI_STATS_OVERLAY_KEY
+#define RAYUI_STATS_OVERLAY_KEY KEY_F10
+#endif
+
+#ifndef RAYUI_FLUSH_CELL_SIZE
+#define RAYUI_FLUSH_CELL_SIZE 64
+#endif
+
+#ifndef RAYUI_UPDATE_CHUNK
+#define RAYUI_UPDATE_CHUNK 256
+#endif
+
+#ifndef RAYUI_FRAME_ARENA_SIZE
+#define RAYUI_FRAME_ARENA_SIZE 16384
+#endif
+
+#ifndef RAYUI_MAX_SDF_FONTS
+#define RAYUI_MAX_SDF_FONTS 8
+#endif
+
+#ifndef RAYUI_TEXT_AREA_ANCHORS
+#define RAYUI_TEXT_AREA_ANCHORS 64
+#endif
 
 #ifndef MIN_INT
 #define MIN_INT -2147483648
@@ -57,10 +104,56 @@
     #endif
 #endif
 
+// The null backend stands in for raylib, so it has to provide GetKeyName as well
+#if defined(RAYUI_BACKEND_NULL) && !defined(OVERRIDE_RAYLIB_GETKEYNAME)
+    #define OVERRIDE_RAYLIB_GETKEYNAME
+#endif
+
+#ifndef RAYUI_NULL_FRAMES
+#define RAYUI_NULL_FRAMES 120
+#endif
+
 #ifndef Clamp
 #define Clamp(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
 #endif
 
+#ifndef RAYUI_MALLOC
+#define RAYUI_MALLOC(size) malloc(size)
+#endif
+#ifndef RAYUI_CALLOC
+#define RAYUI_CALLOC(n, size) calloc(n, size)
+#endif
+#ifndef RAYUI_REALLOC
+#define RAYUI_REALLOC(ptr, size) realloc(ptr, size)
+#endif
+#ifndef RAYUI_FREE
+#define RAYUI_FREE(ptr) free(ptr)
+#endif
+
+// SIMD paths are picked at compile time, define RAYUI_NO_SIMD to force the scalar code
+#ifndef RAYUI_NO_SIMD
+    #if defined(__AVX2__)
+        #define RAYUI_SIMD_AVX2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define RAYUI_SIMD_SSE2
+    #elif defined(__ARM_NEON) && defined(__aarch64__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define RAYUI_SIMD_NEON
+    #endif
+#endif
+
+// Storage class of the current context pointer, define it empty when threads are not available
+#ifndef RAYUI_THREAD_LOCAL
+    #if defined(_MSC_VER)
+        #define RAYUI_THREAD_LOCAL __declspec(thread)
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define RAYUI_THREAD_LOCAL __thread
+    #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+        #define RAYUI_THREAD_LOCAL _Thread_local
+    #else
+        #define RAYUI_THREAD_LOCAL
+    #endif
+#endif
+
 #define RAYUI_VERSION_MAJOR  1
 #define RAYUI_VERSION_MINOR  1
 #define RAYUI_VERSION_PATCH  0
@@ -81,6 +174,8 @@ typedef struct RAYUI_WITH_PREFIX(Hoverable) {
     bool drawAtTop;
     bool active;
     Vector2 lastMousePos;
+    unsigned int handle; // hover registry handle, 0 when not registered
+    unsigned int hitHandle; // hit index handle, 0 when not registered
 } RAYUI_WITH_PREFIX(Hoverable);
 
 typedef struct RAYUI_WITH_PREFIX(HoverText) {
@@ -156,7 +251,21 @@ typedef enum {
 
 typedef struct RAYUI_WITH_PREFIX(TextInput) {
     Rectangle rect;
-    char text[128];
+    char* buffer;   // gap buffer, read the text with TextInputValue
+    int capacity;
+    int gapStart;
+    int gapEnd;
+    int length;     // bytes of UTF-8 text
+    int caret;      // byte offset of the caret, always on a codepoint boundary
+    int anchor;     // other end of the selection, equal to caret when nothing is selected
+    float scrollX;  // horizontal scroll of the text, keeps the caret in view
+    float* widths;  // prefix widths, widths[i] is the x offset of byte i
+    int* glyphs;    // font glyph index of the codepoint starting at byte i, -1 without glyph data
+    int widthsCapacity;
+    int widthsValid; // widths[0..widthsValid] are up to date
+    unsigned int widthsFont;
+    float widthsSize;
+    double blinkStart; // caret blink phase, restarted by focus and edits
     bool focused;
     bool cleared;
     bool hovered;
@@ -169,12 +278,60 @@ typedef struct RAYUI_WITH_PREFIX(TextInput) {
     RAYUI_WITH_PREFIX(Hoverable) hover;
 } RAYUI_WITH_PREFIX(TextInput);
 
+struct _rayui_PieceTable;
+
+// A measured x in a TextArea line, so long lines are measured from the nearest
+// known point instead of from their start. The zero value (column 0 of line 0)
+// is always valid
+struct _rayui_TextAreaAnchor {
+    int line;
+    int column; // bytes from the start of the line
+    float x;    // relative to the start of the line
+};
+
+typedef struct RAYUI_WITH_PREFIX(TextArea) {
+    Rectangle rect;
+    struct _rayui_PieceTable* text; // piece table, read with GetTextAreaText
+    int caret;          // byte offset of the caret
+    float preferredX;   // caret x kept across Up/Down, -1 when unset
+    float scrollX;
+    float scrollY;
+    float contentWidth; // widest line seen so far, bounds horizontal scrolling
+    float lineHeight;
+    bool readOnly;
+    bool focused;
+    bool hovered;
+    bool followCaret;   // scroll the caret into view on the next draw
+    double blinkStart;  // caret blink phase, restarted by focus, edits and caret moves
+    bool dragging;      // scrollbar thumb held
+    float dragOffset;
+    int repeatKey;      // held key that repeats, -1 for none
+    float repeatStart;
+    float repeatTime;
+    Font font;          // font and size of the last draw, used to map clicks to offsets
+    float fontSize;
+    float advances[128];
+    bool measured;
+    struct _rayui_TextAreaAnchor caretAnchor; // x of the caret
+    struct _rayui_TextAreaAnchor viewAnchors[RAYUI_TEXT_AREA_ANCHORS]; // first visible column of drawn lines, slot line % RAYUI_TEXT_AREA_ANCHORS
+    char* scratch;      // visible text is copied here when the frame arena is full
+    int scratchCapacity;
+    Sound hoverSound;
+    Sound clickSound;
+    RAYUI_WITH_PREFIX(Hoverable) hover;
+} RAYUI_WITH_PREFIX(TextArea);
+
 typedef struct RAYUI_WITH_PREFIX(ProgressBar) {
     Rectangle bar;
     float progress; // 0.0 to 1.0
     RAYUI_WITH_PREFIX(Hoverable) hover;
 } RAYUI_WITH_PREFIX(ProgressBar);
 
+// Returns the text of option `index`; used instead of `options` when set
+typedef const char* (*RAYUI_WITH_PREFIX(DropdownSource))(int index, void* userData);
+
+struct _rayui_DropdownIndex;
+
 typedef struct RAYUI_WITH_PREFIX(Dropdown) {
     Rectangle rect;
     const char** options;
@@ -182,6 +339,15 @@ typedef struct RAYUI_WITH_PREFIX(Dropdown) {
     int selectedIndex;
     bool expanded;
     bool hovered;
+    RAYUI_WITH_PREFIX(DropdownSource) source;
+    void* userData;
+    int maxVisible;  // rows shown when expanded, 0 = all
+    int scrollIndex; // first visible option
+    bool dragging;   // scrollbar thumb held
+    float dragOffset;
+    char query[RAYUI_DROPDOWN_QUERY_SIZE]; // type-ahead filter text
+    int queryLength;
+    struct _rayui_DropdownIndex* index;    // search index, set while filtering is enabled
     Sound hoverSound;
     Sound clickSound;
     RAYUI_WITH_PREFIX(Hoverable) hover;
@@ -199,12 +365,15 @@ typedef struct RAYUI_WITH_PREFIX(ColorPicker) {
     Rectangle alphaRect;
     Color selectedColor;
     Vector2 selectorPos;
+    float value; // HSV value/brightness, 0.0 to 1.0
+    Rectangle valueRect;
     Rectangle sliderR, sliderG, sliderB;
     bool draggingSliderR;
     bool draggingSliderG;
     bool draggingSliderB;
     bool draggingAlpha;
     bool draggingColor;
+    bool draggingValue;
     RAYUI_WITH_PREFIX(ColorPickerMode) mode;
     bool expanded;
     bool hovered;
@@ -212,6 +381,11 @@ typedef struct RAYUI_WITH_PREFIX(ColorPicker) {
     Sound hoverSound;
     Sound clickSound;
     RAYUI_WITH_PREFIX(Hoverable) hover;
+    // Cached gradients, rebuilt lazily when rect or mode change
+    Texture gradientTexture; // HSV square
+    Texture rampTexture;     // column 0: channel ramp, column 1: alpha ramp
+    Rectangle cachedRect;
+    RAYUI_WITH_PREFIX(ColorPickerMode) cachedMode;
 } RAYUI_WITH_PREFIX(ColorPicker);
 
 typedef struct Triangle {
@@ -236,23 +410,217 @@ typedef struct RAYUI_WITH_PREFIX(NumericInput) {
     RAYUI_WITH_PREFIX(Hoverable) hover;
 } RAYUI_WITH_PREFIX(NumericInput);
 
-static RAYUI_WITH_PREFIX(Hoverable)* HOVER_INFO_ARRAY[MAX_HOVERABLES];
-static int HOVER_INFO_COUNT = 0;
-
-static Sound _rayui_DefaultSound = {0};
+// Owns all shared library state: tooltips, caches, draw commands, input and
+// the default sound and checkbox textures. Every call works on the calling
+// thread's current context, a built-in default until SetContext selects another.
+typedef struct RAYUI_WITH_PREFIX(Context) RAYUI_WITH_PREFIX(Context);
 
-static Texture defaultCheckboxOnTexture = {0};
-static Texture defaultCheckboxOffTexture = {0};
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(CreateContext)(void);
+void RAYUI_WITH_PREFIX(FreeContext)(RAYUI_WITH_PREFIX(Context)* ctx);
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(SetContext)(RAYUI_WITH_PREFIX(Context)* ctx); // returns the previous context, NULL selects the default
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(GetContext)(void);
+void RAYUI_WITH_PREFIX(SetDefaultSound)(Sound sound); // hover and click sound of widgets created without one
 
 #ifdef OVERRIDE_RAYLIB_GETKEYNAME
 const char* GetKeyName(int key);
 #endif
 
+#ifdef RAYUI_BACKEND_NULL
+typedef struct RAYUI_WITH_PREFIX(NullBackendStats) {
+    int frames;
+    unsigned int drawCalls;     // every shape, text and texture draw
+    unsigned int textDraws;
+    unsigned int textureDraws;
+    unsigned int textMeasures;
+    unsigned int textureLoads;  // textures and render textures
+    unsigned int textureUnloads;
+    unsigned int soundPlays;
+    unsigned int shaderModes;   // BeginShaderMode calls
+} RAYUI_WITH_PREFIX(NullBackendStats);
+
+RAYUI_WITH_PREFIX(NullBackendStats) RAYUI_WITH_PREFIX(GetNullBackendStats)(void);
+void RAYUI_WITH_PREFIX(ResetNullBackendStats)(void); // keeps the frame count
+void RAYUI_WITH_PREFIX(SetNullBackendFrames)(int frames); // WindowShouldClose turns true after this many frames, -1 never
+#endif
+
 void RAYUI_WITH_PREFIX(SetHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h, const char* info, bool drawAtTop);
 void RAYUI_WITH_PREFIX(DisableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h);
 void RAYUI_WITH_PREFIX(EnableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h);
+void RAYUI_WITH_PREFIX(RemoveHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h);
+int RAYUI_WITH_PREFIX(GetHoverInfoCount)(void);
+void RAYUI_WITH_PREFIX(FreeHoverInfo)(void);
 void RAYUI_WITH_PREFIX(DrawHoverables)(Font font, int fontSize);
 
+typedef struct RAYUI_WITH_PREFIX(TextCacheStats) {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    int count;
+    int capacity;
+} RAYUI_WITH_PREFIX(TextCacheStats);
+
+Vector2 RAYUI_WITH_PREFIX(MeasureTextCached)(Font font, const char* text, float fontSize, float spacing);
+RAYUI_WITH_PREFIX(TextCacheStats) RAYUI_WITH_PREFIX(GetTextCacheStats)(void);
+void RAYUI_WITH_PREFIX(ClearTextCache)(void);
+
+// SDF fonts keep one atlas per face that stays sharp at any fontSize. Text
+// drawn with a registered atlas goes through the SDF shader.
+// NULL codepoints loads ASCII 32..126. Returns an empty Font (texture.id 0)
+// when the file can't be loaded or RAYUI_MAX_SDF_FONTS are already registered.
+Font RAYUI_WITH_PREFIX(LoadSDFFont)(const char* fileName, int baseSize, int* codepoints, int codepointCount);
+bool RAYUI_WITH_PREFIX(RegisterSDFFont)(Font font); // an SDF atlas built elsewhere, false when RAYUI_MAX_SDF_FONTS are registered
+bool RAYUI_WITH_PREFIX(IsSDFFont)(Font font);
+void RAYUI_WITH_PREFIX(UnloadSDFFont)(Font font);
+void RAYUI_WITH_PREFIX(SetSDFShader)(Shader shader); // replaces the built-in shader, the caller keeps ownership; a zero shader restores it
+
+typedef struct RAYUI_WITH_PREFIX(FlushStats) {
+    int commands;
+    int layers;
+    int stateChanges;         // texture/primitive switches emitted by the last flush
+    int stateChangesUnsorted; // switches the same commands would cost in submission order
+} RAYUI_WITH_PREFIX(FlushStats);
+
+void RAYUI_WITH_PREFIX(SetDeferredDrawing)(bool enabled);
+bool RAYUI_WITH_PREFIX(IsDeferredDrawing)(void);
+void RAYUI_WITH_PREFIX(Flush)(void);
+RAYUI_WITH_PREFIX(FlushStats) RAYUI_WITH_PREFIX(GetFlushStats)(void);
+void RAYUI_WITH_PREFIX(FreeDrawCommands)(void);
+
+// Input for one frame, captured by BeginFrame or supplied with SetFrameInput
+typedef struct RAYUI_WITH_PREFIX(Input) {
+    Vector2 mouse;
+    float wheel;
+    unsigned char buttonsDown;     // bit per MouseButton
+    unsigned char buttonsPressed;
+    unsigned char buttonsReleased;
+    unsigned char keysDown[RAYUI_INPUT_KEY_BITS / 8]; // held editing/navigation/modifier keys
+    int keys[RAYUI_INPUT_MAX_KEYS];   // keys pressed this frame, in order
+    int keyCount;
+    int chars[RAYUI_INPUT_MAX_CHARS]; // unicode codepoints typed this frame
+    int charCount;
+    double time;
+    float frameTime;
+} RAYUI_WITH_PREFIX(Input);
+
+void RAYUI_WITH_PREFIX(BeginFrame)(void);
+void RAYUI_WITH_PREFIX(SetFrameInput)(const RAYUI_WITH_PREFIX(Input)* input);
+const RAYUI_WITH_PREFIX(Input)* RAYUI_WITH_PREFIX(GetFrameInput)(void);
+
+// Transient strings and scratch arrays of draw calls come from a per-frame
+// bump arena, reset by BeginFrame and SetFrameInput
+typedef struct RAYUI_WITH_PREFIX(FrameArenaStats) {
+    int used;      // bytes handed out since the last reset
+    int highWater; // most bytes any frame has asked for
+    int capacity;  // grows to the high-water mark on the next reset
+    int overflows; // requests that did not fit and wrapped around or failed
+} RAYUI_WITH_PREFIX(FrameArenaStats);
+
+RAYUI_WITH_PREFIX(FrameArenaStats) RAYUI_WITH_PREFIX(GetFrameArenaStats)(void);
+
+// Records every frame snapshot into a compact in-memory log
+void RAYUI_WITH_PREFIX(StartInputRecording)(void);
+void RAYUI_WITH_PREFIX(StopInputRecording)(void);
+bool RAYUI_WITH_PREFIX(IsInputRecording)(void);
+int RAYUI_WITH_PREFIX(GetInputRecordingFrames)(void);
+bool RAYUI_WITH_PREFIX(SaveInputRecording)(const char* fileName);
+void RAYUI_WITH_PREFIX(FreeInputRecording)(void);
+
+// Recorded session played back through SetFrameInput
+typedef struct RAYUI_WITH_PREFIX(InputReplay) {
+    unsigned char* data;
+    int size;
+    int offset;
+    int frame;
+    int frameCount;
+    long long time; // microseconds
+    RAYUI_WITH_PREFIX(Input) input;
+} RAYUI_WITH_PREFIX(InputReplay);
+
+RAYUI_WITH_PREFIX(InputReplay) RAYUI_WITH_PREFIX(LoadInputReplay)(const char* fileName);
+bool RAYUI_WITH_PREFIX(ReplayInputFrame)(RAYUI_WITH_PREFIX(InputReplay)* r);
+void RAYUI_WITH_PREFIX(RewindInputReplay)(RAYUI_WITH_PREFIX(InputReplay)* r);
+void RAYUI_WITH_PREFIX(FreeInputReplay)(RAYUI_WITH_PREFIX(InputReplay)* r);
+
+typedef struct RAYUI_WITH_PREFIX(HitIndexStats) {
+    int count;      // registered widgets
+    int candidates; // widgets under the cursor cell at the last query
+    unsigned int tests;   // hit tests that reached CheckCollision*
+    unsigned int skipped; // hit tests rejected by the index
+} RAYUI_WITH_PREFIX(HitIndexStats);
+
+void RAYUI_WITH_PREFIX(SetHitIndex)(bool enabled);
+bool RAYUI_WITH_PREFIX(IsHitIndexEnabled)(void);
+void RAYUI_WITH_PREFIX(RemoveHitRect)(RAYUI_WITH_PREFIX(Hoverable)* h);
+RAYUI_WITH_PREFIX(HitIndexStats) RAYUI_WITH_PREFIX(GetHitIndexStats)(void);
+void RAYUI_WITH_PREFIX(FreeHitIndex)(void);
+
+typedef enum {
+    WIDGET_TYPE_BUTTON,
+    WIDGET_TYPE_TOGGLE,
+    WIDGET_TYPE_CHECKBOX,
+    WIDGET_TYPE_SLIDER,
+    WIDGET_TYPE_OPTION_SLIDER,
+    WIDGET_TYPE_KEYBIND,
+    WIDGET_TYPE_TEXT_INPUT,
+    WIDGET_TYPE_PROGRESS_BAR,
+    WIDGET_TYPE_DROPDOWN,
+    WIDGET_TYPE_COLOR_PICKER,
+    WIDGET_TYPE_NUMERIC_INPUT,
+    WIDGET_TYPE_TEXT_AREA,
+    WIDGET_TYPE_HOVER_TEXT,
+    WIDGET_TYPE_TOOLTIPS, // DrawHoverables
+    WIDGET_TYPE_COUNT
+} RAYUI_WITH_PREFIX(WidgetType);
+
+typedef struct RAYUI_WITH_PREFIX(WidgetStats) {
+    unsigned int updates;
+    unsigned int draws;
+    unsigned int drawCalls; // primitives issued (or recorded) by this widget type
+    double updateTime;      // seconds
+    double drawTime;
+} RAYUI_WITH_PREFIX(WidgetStats);
+
+// Work done during the previous frame, counted only when compiled with RAYUI_STATS
+typedef struct RAYUI_WITH_PREFIX(FrameStats) {
+    RAYUI_WITH_PREFIX(WidgetStats) widgets[WIDGET_TYPE_COUNT];
+    unsigned int updates;
+    unsigned int draws;
+    unsigned int drawCalls;
+    unsigned int textMeasures; // MeasureTextEx calls, i.e. text cache misses
+    unsigned int soundPlays;
+    int hoverCount;            // enabled tooltips
+    double updateTime;
+    double drawTime;
+} RAYUI_WITH_PREFIX(FrameStats);
+
+RAYUI_WITH_PREFIX(FrameStats) RAYUI_WITH_PREFIX(GetFrameStats)(void);
+const char* RAYUI_WITH_PREFIX(GetWidgetTypeName)(RAYUI_WITH_PREFIX(WidgetType) type);
+void RAYUI_WITH_PREFIX(SetStatsOverlay)(bool enabled);
+bool RAYUI_WITH_PREFIX(IsStatsOverlayEnabled)(void);
+void RAYUI_WITH_PREFIX(DrawStatsOverlay)(Font font, int fontSize);
+
+// Retained group of widgets rendered into a texture, redrawn only when its content changes
+typedef struct RAYUI_WITH_PREFIX(Panel) {
+    Rectangle rect;
+    RenderTexture2D target;
+    unsigned long long contentHash;
+    unsigned long long savedNestedHash;
+    int commandStart;
+    int textStart;
+    bool wasDeferred;
+    bool dirty;
+    unsigned int renderCount;
+    unsigned int reuseCount;
+} RAYUI_WITH_PREFIX(Panel);
+
+RAYUI_WITH_PREFIX(Panel) RAYUI_WITH_PREFIX(CreatePanel)(float x, float y, float width, float height);
+void RAYUI_WITH_PREFIX(BeginPanel)(RAYUI_WITH_PREFIX(Panel)* p);
+void RAYUI_WITH_PREFIX(EndPanel)(RAYUI_WITH_PREFIX(Panel)* p);
+void RAYUI_WITH_PREFIX(MarkPanelDirty)(RAYUI_WITH_PREFIX(Panel)* p);
+unsigned int RAYUI_WITH_PREFIX(GetPanelRenderCount)(RAYUI_WITH_PREFIX(Panel)* p);
+unsigned int RAYUI_WITH_PREFIX(GetPanelReuseCount)(RAYUI_WITH_PREFIX(Panel)* p);
+void RAYUI_WITH_PREFIX(FreePanelTexture)(RAYUI_WITH_PREFIX(Panel)* p);
+
 RAYUI_WITH_PREFIX(HoverText) RAYUI_WITH_PREFIX(CreateHoverText)(const char* text, Vector2 position, float delay);
 void RAYUI_WITH_PREFIX(DrawHoverText)(Font font, int fontSize, RAYUI_WITH_PREFIX(HoverText)* hoverText);
 void RAYUI_WITH_PREFIX(UpdateHoverText)(RAYUI_WITH_PREFIX(HoverText)* hoverText, Vector2 mousePoint);
@@ -294,6 +662,78 @@ void RAYUI_WITH_PREFIX(FreeCheckboxTextures)(RAYUI_WITH_PREFIX(Checkbox)* c);
 Texture RAYUI_WITH_PREFIX(GetCheckboxOnTexture)(void);
 Texture RAYUI_WITH_PREFIX(GetCheckboxOffTexture)(void);
 
+// Structure-of-arrays collections for large grids of buttons, checkboxes and
+// toggles. Rects, labels and states live in separate arrays and flags in
+// bitsets (bit i of word i / 32), so an update only streams the rect array.
+// Sounds are shared by all elements and play whenever they are set.
+typedef struct RAYUI_WITH_PREFIX(ButtonArray) {
+    Rectangle* rects;
+    const char** texts;
+    unsigned int* hovered;
+    unsigned int* clicked; // clicked during the last update
+    int count;
+    int capacity;
+    Sound hoverSound;
+    Sound clickSound;
+} RAYUI_WITH_PREFIX(ButtonArray);
+
+typedef struct RAYUI_WITH_PREFIX(CheckboxArray) {
+    Rectangle* rects;
+    unsigned int* values;
+    unsigned int* hovered;
+    unsigned int* changed; // toggled during the last update
+    int count;
+    int capacity;
+    Texture onTexture;
+    Texture offTexture;
+    Sound hoverSound;
+    Sound clickSound;
+} RAYUI_WITH_PREFIX(CheckboxArray);
+
+typedef struct RAYUI_WITH_PREFIX(ToggleArray) {
+    Rectangle* rects;
+    const char** onLabels;
+    const char** offLabels;
+    unsigned int* values;
+    unsigned int* hovered;
+    unsigned int* changed;
+    int count;
+    int capacity;
+    Sound hoverSound;
+    Sound clickSound;
+} RAYUI_WITH_PREFIX(ToggleArray);
+
+bool RAYUI_WITH_PREFIX(IsBitSet)(const unsigned int* bits, int index);
+
+// Batch hit tests of one point against packed shapes. Bit i of mask (word i / 32)
+// is set when shape i contains the point, mask needs (count + 31) / 32 words.
+// Same results as CheckCollisionPointRec/PointTriangle, returns the hit count.
+int RAYUI_WITH_PREFIX(PointInRects)(Vector2 point, const Rectangle* rects, int count, unsigned int* mask);
+int RAYUI_WITH_PREFIX(PointInTriangles)(Vector2 point, const Triangle* triangles, int count, unsigned int* mask);
+
+RAYUI_WITH_PREFIX(ButtonArray) RAYUI_WITH_PREFIX(CreateButtonArray)(void);
+int RAYUI_WITH_PREFIX(AddButton)(RAYUI_WITH_PREFIX(ButtonArray)* a, float x, float y, float width, float height, const char* text); // returns the index, -1 on failure
+const unsigned int* RAYUI_WITH_PREFIX(UpdateButtons)(RAYUI_WITH_PREFIX(ButtonArray)* a); // returns the clicked bitset
+void RAYUI_WITH_PREFIX(DrawButtons)(RAYUI_WITH_PREFIX(ButtonArray)* a, Font font, int fontSize, Color color, Color hoverColor);
+void RAYUI_WITH_PREFIX(FreeButtonArray)(RAYUI_WITH_PREFIX(ButtonArray)* a);
+
+RAYUI_WITH_PREFIX(CheckboxArray) RAYUI_WITH_PREFIX(CreateCheckboxArray)(void);
+int RAYUI_WITH_PREFIX(AddCheckbox)(RAYUI_WITH_PREFIX(CheckboxArray)* a, float x, float y, float size, bool initial);
+const unsigned int* RAYUI_WITH_PREFIX(UpdateCheckboxes)(RAYUI_WITH_PREFIX(CheckboxArray)* a); // returns the changed bitset
+void RAYUI_WITH_PREFIX(DrawCheckboxes)(RAYUI_WITH_PREFIX(CheckboxArray)* a);
+void RAYUI_WITH_PREFIX(DrawCheckboxesColors)(RAYUI_WITH_PREFIX(CheckboxArray)* a, Color onColor, Color offColor);
+bool RAYUI_WITH_PREFIX(GetCheckboxArrayValue)(RAYUI_WITH_PREFIX(CheckboxArray)* a, int index);
+void RAYUI_WITH_PREFIX(SetCheckboxArrayValue)(RAYUI_WITH_PREFIX(CheckboxArray)* a, int index, bool value);
+void RAYUI_WITH_PREFIX(FreeCheckboxArray)(RAYUI_WITH_PREFIX(CheckboxArray)* a);
+
+RAYUI_WITH_PREFIX(ToggleArray) RAYUI_WITH_PREFIX(CreateToggleArray)(void);
+int RAYUI_WITH_PREFIX(AddToggle)(RAYUI_WITH_PREFIX(ToggleArray)* a, float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel);
+const unsigned int* RAYUI_WITH_PREFIX(UpdateToggles)(RAYUI_WITH_PREFIX(ToggleArray)* a); // returns the changed bitset
+void RAYUI_WITH_PREFIX(DrawToggles)(RAYUI_WITH_PREFIX(ToggleArray)* a, Font font, int fontSize, Color color, Color hoverColor, Color backgroundColor);
+bool RAYUI_WITH_PREFIX(GetToggleArrayValue)(RAYUI_WITH_PREFIX(ToggleArray)* a, int index);
+void RAYUI_WITH_PREFIX(SetToggleArrayValue)(RAYUI_WITH_PREFIX(ToggleArray)* a, int index, bool value);
+void RAYUI_WITH_PREFIX(FreeToggleArray)(RAYUI_WITH_PREFIX(ToggleArray)* a);
+
 RAYUI_WITH_PREFIX(Slider) RAYUI_WITH_PREFIX(CreateSlider)(int x, int y, int width, int minVal, int maxVal, float initial);
 void RAYUI_WITH_PREFIX(UpdateSlider)(RAYUI_WITH_PREFIX(Slider)* s, Vector2 mousePoint);
 int RAYUI_WITH_PREFIX(SliderValue)(RAYUI_WITH_PREFIX(Slider)* s);
@@ -315,6 +755,32 @@ void RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)(RAYUI_WITH_PREFIX(TextInpu
 void RAYUI_WITH_PREFIX(DrawTextInput)(RAYUI_WITH_PREFIX(TextInput)* ti, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor);
 const char* RAYUI_WITH_PREFIX(TextInputValue)(RAYUI_WITH_PREFIX(TextInput)* ti);
 void RAYUI_WITH_PREFIX(SetTextInputValue)(RAYUI_WITH_PREFIX(TextInput)* ti, const char* value);
+int RAYUI_WITH_PREFIX(GetTextInputLength)(RAYUI_WITH_PREFIX(TextInput)* ti);
+void RAYUI_WITH_PREFIX(SetTextInputCaret)(RAYUI_WITH_PREFIX(TextInput)* ti, int caret);
+void RAYUI_WITH_PREFIX(SetTextInputSelection)(RAYUI_WITH_PREFIX(TextInput)* ti, int start, int end);
+void RAYUI_WITH_PREFIX(InsertTextInput)(RAYUI_WITH_PREFIX(TextInput)* ti, const char* text);
+void RAYUI_WITH_PREFIX(FreeTextInput)(RAYUI_WITH_PREFIX(TextInput)* ti);
+
+// When out of memory the created area's text is NULL and it acts as freed,
+// and the edit calls below return false leaving the text as it was
+RAYUI_WITH_PREFIX(TextArea) RAYUI_WITH_PREFIX(CreateTextArea)(int x, int y, int width, int height, const char* initial);
+RAYUI_WITH_PREFIX(TextArea) RAYUI_WITH_PREFIX(CreateTextAreaWithSound)(int x, int y, int width, int height, const char* initial, Sound hoverSound, Sound clickSound);
+void RAYUI_WITH_PREFIX(UpdateTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta);
+void RAYUI_WITH_PREFIX(UpdateTextAreaWithMousePoint)(RAYUI_WITH_PREFIX(TextArea)* ta, Vector2 mousePoint);
+void RAYUI_WITH_PREFIX(DrawTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor);
+bool RAYUI_WITH_PREFIX(SetTextAreaValue)(RAYUI_WITH_PREFIX(TextArea)* ta, const char* value);
+bool RAYUI_WITH_PREFIX(LoadTextAreaFile)(RAYUI_WITH_PREFIX(TextArea)* ta, const char* fileName);
+int RAYUI_WITH_PREFIX(GetTextAreaLength)(RAYUI_WITH_PREFIX(TextArea)* ta);
+int RAYUI_WITH_PREFIX(GetTextAreaLineCount)(RAYUI_WITH_PREFIX(TextArea)* ta);
+int RAYUI_WITH_PREFIX(GetTextAreaLineStart)(RAYUI_WITH_PREFIX(TextArea)* ta, int line);
+int RAYUI_WITH_PREFIX(GetTextAreaLine)(RAYUI_WITH_PREFIX(TextArea)* ta, int offset);
+int RAYUI_WITH_PREFIX(GetTextAreaText)(RAYUI_WITH_PREFIX(TextArea)* ta, int offset, int length, char* out);
+bool RAYUI_WITH_PREFIX(InsertTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta, int offset, const char* text);
+bool RAYUI_WITH_PREFIX(AppendTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta, const char* text);
+bool RAYUI_WITH_PREFIX(DeleteTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta, int offset, int length);
+void RAYUI_WITH_PREFIX(SetTextAreaCaret)(RAYUI_WITH_PREFIX(TextArea)* ta, int caret);
+void RAYUI_WITH_PREFIX(ScrollTextAreaToLine)(RAYUI_WITH_PREFIX(TextArea)* ta, int line);
+void RAYUI_WITH_PREFIX(FreeTextArea)(RAYUI_WITH_PREFIX(TextArea)* ta);
 
 RAYUI_WITH_PREFIX(ProgressBar) RAYUI_WITH_PREFIX(CreateProgressBar)(int x, int y, int width, int height, float initialValue);
 void RAYUI_WITH_PREFIX(UpdateProgressBar)(RAYUI_WITH_PREFIX(ProgressBar)* pb);
@@ -340,6 +806,16 @@ const char* RAYUI_WITH_PREFIX(DropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d);
 void RAYUI_WITH_PREFIX(SetDropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d, int index);
 int RAYUI_WITH_PREFIX(GetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d);
 void RAYUI_WITH_PREFIX(SetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d, int index);
+void RAYUI_WITH_PREFIX(SetDropdownSource)(RAYUI_WITH_PREFIX(Dropdown)* d, RAYUI_WITH_PREFIX(DropdownSource) source, int optionCount, void* userData);
+void RAYUI_WITH_PREFIX(SetDropdownMaxVisible)(RAYUI_WITH_PREFIX(Dropdown)* d, int rows);
+void RAYUI_WITH_PREFIX(ScrollDropdownTo)(RAYUI_WITH_PREFIX(Dropdown)* d, int index);
+void RAYUI_WITH_PREFIX(SetDropdownFilter)(RAYUI_WITH_PREFIX(Dropdown)* d, bool enabled);
+void RAYUI_WITH_PREFIX(SetDropdownQuery)(RAYUI_WITH_PREFIX(Dropdown)* d, const char* query);
+int RAYUI_WITH_PREFIX(GetDropdownFilteredCount)(RAYUI_WITH_PREFIX(Dropdown)* d);
+int RAYUI_WITH_PREFIX(GetDropdownFilteredIndex)(RAYUI_WITH_PREFIX(Dropdown)* d, int row);
+
+void RAYUI_WITH_PREFIX(ColorsFromHSV)(const Vector3* hsv, Color* colors, int count);
+void RAYUI_WITH_PREFIX(ColorsToHSV)(const Color* colors, Vector3* hsv, int count);
 
 RAYUI_WITH_PREFIX(ColorPicker) RAYUI_WITH_PREFIX(CreateColorPicker)(float x, float y, float size, Color initialColor, RAYUI_WITH_PREFIX(ColorPickerMode) mode);
 RAYUI_WITH_PREFIX(ColorPicker) RAYUI_WITH_PREFIX(CreateColorPickerWithSound)(float x, float y, float size, Color initialColor, RAYUI_WITH_PREFIX(ColorPickerMode) mode, Sound hoverSound, Sound clickSound);
@@ -351,6 +827,8 @@ void RAYUI_WITH_PREFIX(DrawColorPickerEx)(RAYUI_WITH_PREFIX(ColorPicker)* cp,
                                           Color thumbColor);
 Color RAYUI_WITH_PREFIX(GetColorPickerValue)(RAYUI_WITH_PREFIX(ColorPicker)* cp);
 void RAYUI_WITH_PREFIX(SetColorPickerValue)(RAYUI_WITH_PREFIX(ColorPicker)* cp, Color color);
+void RAYUI_WITH_PREFIX(FreeColorPickerTextures)(RAYUI_WITH_PREFIX(ColorPicker)* cp);
+void RAYUI_WITH_PREFIX(SetColorPickerRect)(RAYUI_WITH_PREFIX(ColorPicker)* cp, Rectangle rect); // moves the value, channel and alpha tracks too
 
 RAYUI_WITH_PREFIX(NumericInput) RAYUI_WITH_PREFIX(CreateNumericInput)(
     float x, float y, float width, float height, float initialValue,
@@ -362,11 +840,369 @@ void RAYUI_WITH_PREFIX(DrawNumericInputEx)(RAYUI_WITH_PREFIX(NumericInput)* n,
                                          Color bgColor, Color textColor, Color triangleColor, Color triangleHoverColor, int outline_width, Color outlineColor);
 float RAYUI_WITH_PREFIX(GetNumericInputValue)(RAYUI_WITH_PREFIX(NumericInput)* n);
 void RAYUI_WITH_PREFIX(SetNumericInputValue)(RAYUI_WITH_PREFIX(NumericInput)* n, float value);
+void RAYUI_WITH_PREFIX(SetNumericInputRect)(RAYUI_WITH_PREFIX(NumericInput)* n, Rectangle rect); // rebuilds the arrow triangles
+
+// Widgets updated together by UpdateWidgets, across worker threads when built with RAYUI_THREADS
+typedef struct RAYUI_WITH_PREFIX(WidgetRef) {
+    RAYUI_WITH_PREFIX(WidgetType) type;
+    void* widget;
+    bool result; // return value of the last update: click, new key bind or dropdown change
+} RAYUI_WITH_PREFIX(WidgetRef);
+
+typedef struct RAYUI_WITH_PREFIX(WidgetSet) {
+    RAYUI_WITH_PREFIX(WidgetRef)* items;
+    int count;
+    int capacity;
+} RAYUI_WITH_PREFIX(WidgetSet);
+
+RAYUI_WITH_PREFIX(WidgetSet) RAYUI_WITH_PREFIX(CreateWidgetSet)(void);
+int RAYUI_WITH_PREFIX(AddWidget)(RAYUI_WITH_PREFIX(WidgetSet)* set, RAYUI_WITH_PREFIX(WidgetType) type, void* widget); // returns the item index, -1 on failure
+void RAYUI_WITH_PREFIX(ClearWidgetSet)(RAYUI_WITH_PREFIX(WidgetSet)* set);
+void RAYUI_WITH_PREFIX(FreeWidgetSet)(RAYUI_WITH_PREFIX(WidgetSet)* set);
+void RAYUI_WITH_PREFIX(UpdateWidgets)(RAYUI_WITH_PREFIX(WidgetSet)* set, const RAYUI_WITH_PREFIX(Input)* input); // NULL input keeps the current frame snapshot
+void RAYUI_WITH_PREFIX(SetUpdateThreads)(int count); // threads UpdateWidgets may use, including the caller
+int RAYUI_WITH_PREFIX(GetUpdateThreads)(void);
+
+// Moves any widget, including the geometry derived from its rect. A color
+// picker fits its square and tracks inside the rect. Sliders and progress
+// bars keep their bar height, centred in the rect, and sliders leave room for
+// the knob at both ends. HoverText only takes the position.
+void RAYUI_WITH_PREFIX(SetWidgetRect)(RAYUI_WITH_PREFIX(WidgetType) type, void* widget, Rectangle rect);
+
+// Tree of containers that computes widget rects. Sizes of 0 stretch to the
+// space the parent gives, row and column children share what is left after
+// fixed sizes and sized children are centred. UpdateLayout only revisits
+// branches changed since the last call and moves only widgets whose rect changed.
+typedef enum {
+    LAYOUT_KIND_ANCHOR, // children pinned to an edge, corner or the centre
+    LAYOUT_KIND_ROW,    // children left to right
+    LAYOUT_KIND_COLUMN, // children top to bottom
+    LAYOUT_KIND_GRID,   // children fill equal cells, row by row
+    LAYOUT_KIND_WIDGET  // leaf, its rect goes to the widget
+} RAYUI_WITH_PREFIX(LayoutKind);
+
+typedef enum {
+    LAYOUT_ANCHOR_TOP_LEFT,
+    LAYOUT_ANCHOR_TOP,
+    LAYOUT_ANCHOR_TOP_RIGHT,
+    LAYOUT_ANCHOR_LEFT,
+    LAYOUT_ANCHOR_CENTER,
+    LAYOUT_ANCHOR_RIGHT,
+    LAYOUT_ANCHOR_BOTTOM_LEFT,
+    LAYOUT_ANCHOR_BOTTOM,
+    LAYOUT_ANCHOR_BOTTOM_RIGHT
+} RAYUI_WITH_PREFIX(LayoutAnchor);
+
+struct _rayui_LayoutNode;
+
+typedef struct RAYUI_WITH_PREFIX(Layout) {
+    struct _rayui_LayoutNode* nodes; // node 0 is the root, an anchor container covering the bounds
+    int count;
+    int capacity;
+    int arranged; // containers re-arranged by the last UpdateLayout
+    int moved;    // widgets moved by the last UpdateLayout
+} RAYUI_WITH_PREFIX(Layout);
+
+RAYUI_WITH_PREFIX(Layout) RAYUI_WITH_PREFIX(CreateLayout)(Rectangle bounds);
+// Add functions return the node index, -1 on failure or when parent is not a container
+int RAYUI_WITH_PREFIX(AddLayoutRow)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, float spacing);
+int RAYUI_WITH_PREFIX(AddLayoutColumn)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, float spacing);
+int RAYUI_WITH_PREFIX(AddLayoutGrid)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, int columns, float rowHeight, float spacing); // rowHeight 0 splits the height
+int RAYUI_WITH_PREFIX(AddLayoutAnchor)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height);
+int RAYUI_WITH_PREFIX(AddLayoutWidget)(RAYUI_WITH_PREFIX(Layout)* l, int parent, RAYUI_WITH_PREFIX(WidgetType) type, void* widget, float width, float height); // NULL widget only reserves space
+void RAYUI_WITH_PREFIX(SetLayoutBounds)(RAYUI_WITH_PREFIX(Layout)* l, Rectangle bounds);
+void RAYUI_WITH_PREFIX(SetLayoutSize)(RAYUI_WITH_PREFIX(Layout)* l, int node, float width, float height);
+void RAYUI_WITH_PREFIX(SetLayoutAnchor)(RAYUI_WITH_PREFIX(Layout)* l, int node, RAYUI_WITH_PREFIX(LayoutAnchor) anchor, Vector2 offset); // placement inside an anchor container, offsets point inwards
+void RAYUI_WITH_PREFIX(SetLayoutPadding)(RAYUI_WITH_PREFIX(Layout)* l, int node, float padding);
+void RAYUI_WITH_PREFIX(SetLayoutSpacing)(RAYUI_WITH_PREFIX(Layout)* l, int node, float spacing);
+Rectangle RAYUI_WITH_PREFIX(GetLayoutRect)(RAYUI_WITH_PREFIX(Layout)* l, int node); // as of the last UpdateLayout
+void RAYUI_WITH_PREFIX(UpdateLayout)(RAYUI_WITH_PREFIX(Layout)* l);
+void RAYUI_WITH_PREFIX(FreeLayout)(RAYUI_WITH_PREFIX(Layout)* l);
 
 
 // IMPLEMENTATION
 #ifdef RAYUI_IMPLEMENTATION
 
+#if defined(RAYUI_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(RAYUI_SIMD_SSE2)
+    #include <emmintrin.h>
+#elif defined(RAYUI_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+#if defined(RAYUI_THREADS) && !defined(__GNUC__) && !defined(__clang__)
+    #error "RAYUI_THREADS needs GCC or Clang (pthreads and __atomic builtins)"
+#endif
+#ifdef RAYUI_THREADS
+    #include <pthread.h>
+#endif
+
+#include <stdarg.h>
+
+#ifdef RAYUI_BACKEND_NULL
+// ---------------- NULL BACKEND ----------------
+// Stand-in for the part of raylib RayUI (and a typical app loop) uses. Nothing
+// is drawn, played or uploaded; calls are counted instead. Time advances by one
+// target frame per EndDrawing and text is measured with fixed metrics
+// (advance = fontSize/2 per codepoint, height = fontSize per line), so runs are
+// deterministic. Don't link raylib together with this.
+
+static RAYUI_WITH_PREFIX(NullBackendStats) _rayui_Null = {0};
+static int _rayui_NullFrameLimit = -1;
+static int _rayui_NullFps = 60;
+static int _rayui_NullWidth = 800;
+static int _rayui_NullHeight = 600;
+static unsigned int _rayui_NullNextId = 1;
+
+RAYUI_WITH_PREFIX(NullBackendStats) RAYUI_WITH_PREFIX(GetNullBackendStats)(void) { return _rayui_Null; }
+void RAYUI_WITH_PREFIX(ResetNullBackendStats)(void) { int frames = _rayui_Null.frames; memset(&_rayui_Null, 0, sizeof(_rayui_Null)); _rayui_Null.frames = frames; }
+void RAYUI_WITH_PREFIX(SetNullBackendFrames)(int frames) { _rayui_NullFrameLimit = frames; }
+
+// Window and frame
+void InitWindow(int width, int height, const char* title) {
+    (void)title;
+    _rayui_NullWidth = width;
+    _rayui_NullHeight = height;
+    if (_rayui_NullFrameLimit < 0) {
+        const char* env = getenv("RAYUI_NULL_FRAMES");
+        _rayui_NullFrameLimit = env ? atoi(env) : RAYUI_NULL_FRAMES;
+    }
+}
+void CloseWindow(void) {
+    if (getenv("RAYUI_NULL_REPORT")) {
+        printf("RAYUI NULL: frames=%d draws=%u text=%u textures=%u measures=%u loads=%u unloads=%u sounds=%u shaders=%u\n",
+               _rayui_Null.frames, _rayui_Null.drawCalls, _rayui_Null.textDraws, _rayui_Null.textureDraws,
+               _rayui_Null.textMeasures, _rayui_Null.textureLoads, _rayui_Null.textureUnloads, _rayui_Null.soundPlays,
+               _rayui_Null.shaderModes);
+    }
+}
+bool WindowShouldClose(void) { return _rayui_NullFrameLimit >= 0 && _rayui_Null.frames >= _rayui_NullFrameLimit; }
+void SetTargetFPS(int fps) { _rayui_NullFps = fps > 0 ? fps : 60; }
+int GetScreenWidth(void) { return _rayui_NullWidth; }
+int GetScreenHeight(void) { return _rayui_NullHeight; }
+double GetTime(void) { return (double)_rayui_Null.frames / _rayui_NullFps; }
+float GetFrameTime(void) { return 1.0f / _rayui_NullFps; }
+void BeginDrawing(void) {}
+void EndDrawing(void) { _rayui_Null.frames++; }
+void ClearBackground(Color color) { (void)color; }
+void BeginMode2D(Camera2D camera) { (void)camera; }
+void EndMode2D(void) {}
+void BeginTextureMode(RenderTexture2D target) { (void)target; }
+void EndTextureMode(void) {}
+void BeginScissorMode(int x, int y, int width, int height) { (void)x; (void)y; (void)width; (void)height; }
+void EndScissorMode(void) {}
+void TraceLog(int logLevel, const char* text, ...) { (void)logLevel; (void)text; }
+
+const char* TextFormat(const char* text, ...) {
+    static char buffers[4][1024];
+    static int index = 0;
+    char* buffer = buffers[index];
+    index = (index + 1) % 4;
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return buffer;
+}
+
+// Input, always idle; drive widgets with SetFrameInput or an input replay instead
+Vector2 GetMousePosition(void) { return (Vector2){0, 0}; }
+float GetMouseWheelMove(void) { return 0; }
+bool IsMouseButtonPressed(int button) { (void)button; return false; }
+bool IsMouseButtonDown(int button) { (void)button; return false; }
+bool IsMouseButtonReleased(int button) { (void)button; return false; }
+bool IsKeyPressed(int key) { (void)key; return false; }
+bool IsKeyDown(int key) { (void)key; return false; }
+int GetKeyPressed(void) { return 0; }
+int GetCharPressed(void) { return 0; }
+
+// Drawing
+void DrawRectangle(int x, int y, int w, int h, Color c) { (void)x; (void)y; (void)w; (void)h; (void)c; _rayui_Null.drawCalls++; }
+void DrawRectangleRec(Rectangle r, Color c) { (void)r; (void)c; _rayui_Null.drawCalls++; }
+void DrawRectangleLinesEx(Rectangle r, float t, Color c) { (void)r; (void)t; (void)c; _rayui_Null.drawCalls++; }
+void DrawRectangleRounded(Rectangle r, float rn, int s, Color c) { (void)r; (void)rn; (void)s; (void)c; _rayui_Null.drawCalls++; }
+void DrawRectangleRoundedLines(Rectangle r, float rn, int s, Color c) { (void)r; (void)rn; (void)s; (void)c; _rayui_Null.drawCalls++; }
+void DrawTriangle(Vector2 a, Vector2 b, Vector2 c, Color col) { (void)a; (void)b; (void)c; (void)col; _rayui_Null.drawCalls++; }
+void DrawCircle(int x, int y, float r, Color c) { (void)x; (void)y; (void)r; (void)c; _rayui_Null.drawCalls++; }
+void DrawCircleLines(int x, int y, float r, Color c) { (void)x; (void)y; (void)r; (void)c; _rayui_Null.drawCalls++; }
+void DrawPixel(int x, int y, Color c) { (void)x; (void)y; (void)c; _rayui_Null.drawCalls++; }
+void DrawText(const char* t, int x, int y, int s, Color c) { (void)t; (void)x; (void)y; (void)s; (void)c; _rayui_Null.drawCalls++; _rayui_Null.textDraws++; }
+void DrawTextEx(Font f, const char* t, Vector2 p, float s, float sp, Color c) { (void)f; (void)t; (void)p; (void)s; (void)sp; (void)c; _rayui_Null.drawCalls++; _rayui_Null.textDraws++; }
+void DrawFPS(int x, int y) { (void)x; (void)y; _rayui_Null.drawCalls++; _rayui_Null.textDraws++; }
+void DrawTexturePro(Texture2D t, Rectangle s, Rectangle d, Vector2 o, float r, Color c) { (void)t; (void)s; (void)d; (void)o; (void)r; (void)c; _rayui_Null.drawCalls++; _rayui_Null.textureDraws++; }
+
+// Collision and color, same math as raylib
+bool CheckCollisionPointRec(Vector2 p, Rectangle r) {
+    return p.x >= r.x && p.x < r.x + r.width && p.y >= r.y && p.y < r.y + r.height;
+}
+
+bool CheckCollisionPointTriangle(Vector2 p, Vector2 p1, Vector2 p2, Vector2 p3) {
+    float alpha = ((p2.y - p3.y)*(p.x - p3.x) + (p3.x - p2.x)*(p.y - p3.y)) /
+                  ((p2.y - p3.y)*(p1.x - p3.x) + (p3.x - p2.x)*(p1.y - p3.y));
+    float beta = ((p3.y - p1.y)*(p.x - p3.x) + (p1.x - p3.x)*(p.y - p3.y)) /
+                 ((p2.y - p3.y)*(p1.x - p3.x) + (p3.x - p2.x)*(p1.y - p3.y));
+    float gamma = 1.0f - alpha - beta;
+    return alpha > 0 && beta > 0 && gamma > 0;
+}
+
+Color ColorFromHSV(float hue, float saturation, float value) {
+    Color color = {0, 0, 0, 255};
+    float k = fmodf((5.0f + hue/60.0f), 6);
+    float t = 4.0f - k;
+    k = (t < k)? t : k;
+    k = (k < 1)? k : 1;
+    k = (k > 0)? k : 0;
+    color.r = (unsigned char)((value - value*saturation*k)*255.0f);
+    k = fmodf((3.0f + hue/60.0f), 6);
+    t = 4.0f - k;
+    k = (t < k)? t : k;
+    k = (k < 1)? k : 1;
+    k = (k > 0)? k : 0;
+    color.g = (unsigned char)((value - value*saturation*k)*255.0f);
+    k = fmodf((1.0f + hue/60.0f), 6);
+    t = 4.0f - k;
+    k = (t < k)? t : k;
+    k = (k < 1)? k : 1;
+    k = (k > 0)? k : 0;
+    color.b = (unsigned char)((value - value*saturation*k)*255.0f);
+    return color;
+}
+
+// Images live in memory so CPU-side pixel writes still work, textures are just ids
+Image GenImageColor(int width, int height, Color color) {
+    Image img = {0};
+    img.data = RAYUI_MALLOC((size_t)width * height * sizeof(Color));
+    if (!img.data) return img;
+    Color* pixels = (Color*)img.data;
+    for (int i = 0; i < width * height; i++) pixels[i] = color;
+    img.width = width;
+    img.height = height;
+    img.mipmaps = 1;
+    img.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return img;
+}
+void UnloadImage(Image image) { RAYUI_FREE(image.data); }
+void ImageDrawLine(Image* dst, int x0, int y0, int x1, int y1, Color c) { (void)dst; (void)x0; (void)y0; (void)x1; (void)y1; (void)c; }
+void ImageDrawRectangleLines(Image* dst, Rectangle r, int t, Color c) { (void)dst; (void)r; (void)t; (void)c; }
+
+Texture2D LoadTextureFromImage(Image image) {
+    Texture2D t = {0};
+    t.id = _rayui_NullNextId++;
+    t.width = image.width;
+    t.height = image.height;
+    t.mipmaps = 1;
+    t.format = image.format;
+    _rayui_Null.textureLoads++;
+    return t;
+}
+void UnloadTexture(Texture2D texture) { if (texture.id) _rayui_Null.textureUnloads++; }
+
+RenderTexture2D LoadRenderTexture(int width, int height) {
+    RenderTexture2D rt = {0};
+    rt.id = _rayui_NullNextId++;
+    rt.texture.id = _rayui_NullNextId++;
+    rt.texture.width = width;
+    rt.texture.height = height;
+    rt.texture.mipmaps = 1;
+    rt.texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    _rayui_Null.textureLoads++;
+    return rt;
+}
+void UnloadRenderTexture(RenderTexture2D target) { if (target.id) _rayui_Null.textureUnloads++; }
+void SetTextureFilter(Texture2D texture, int filter) { (void)texture; (void)filter; }
+
+// Shaders compile to nothing
+Shader LoadShaderFromMemory(const char* vsCode, const char* fsCode) {
+    (void)vsCode; (void)fsCode;
+    Shader shader = {0};
+    shader.id = _rayui_NullNextId++;
+    return shader;
+}
+void UnloadShader(Shader shader) { (void)shader; }
+void BeginShaderMode(Shader shader) { (void)shader; _rayui_Null.shaderModes++; }
+void EndShaderMode(void) {}
+
+// Files are read for real
+unsigned char* LoadFileData(const char* fileName, int* dataSize) {
+    *dataSize = 0;
+    FILE* file = fopen(fileName, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = size > 0 ? (unsigned char*)RAYUI_MALLOC(size) : NULL;
+    if (data && fread(data, 1, size, file) != (size_t)size) { RAYUI_FREE(data); data = NULL; }
+    fclose(file);
+    if (data) *dataSize = (int)size;
+    return data;
+}
+void UnloadFileData(unsigned char* data) { RAYUI_FREE(data); }
+
+// Audio
+void PlaySound(Sound sound) { (void)sound; _rayui_Null.soundPlays++; }
+
+// Fonts
+Font GetFontDefault(void) {
+    Font font = {0};
+    font.baseSize = 10;
+    font.glyphCount = 224;
+    font.texture.id = 0xFFFFFFFFu; // fixed id so the text cache has a stable key
+    return font;
+}
+
+int GetGlyphIndex(Font font, int codepoint) { (void)font; (void)codepoint; return 0; }
+
+// Font files are not parsed: glyphs have no bitmaps and the atlas is a single pixel
+GlyphInfo* LoadFontData(const unsigned char* fileData, int dataSize, int fontSize, int* codepoints, int codepointCount, int type) {
+    (void)type;
+    if (!fileData || dataSize <= 0) return NULL;
+    if (codepointCount <= 0) codepointCount = 95;
+    GlyphInfo* glyphs = (GlyphInfo*)RAYUI_CALLOC(codepointCount, sizeof(GlyphInfo));
+    if (!glyphs) return NULL;
+    for (int i = 0; i < codepointCount; i++) {
+        glyphs[i].value = codepoints ? codepoints[i] : 32 + i;
+        glyphs[i].advanceX = fontSize / 2;
+    }
+    return glyphs;
+}
+void UnloadFontData(GlyphInfo* glyphs, int glyphCount) { (void)glyphCount; RAYUI_FREE(glyphs); }
+
+Image GenImageFontAtlas(const GlyphInfo* glyphs, Rectangle** glyphRecs, int glyphCount, int fontSize, int padding, int packMethod) {
+    (void)glyphs; (void)fontSize; (void)padding; (void)packMethod;
+    *glyphRecs = glyphCount > 0 ? (Rectangle*)RAYUI_CALLOC(glyphCount, sizeof(Rectangle)) : NULL;
+    return GenImageColor(1, 1, BLANK);
+}
+
+void UnloadFont(Font font) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    RAYUI_FREE(font.recs);
+    UnloadTexture(font.texture);
+}
+
+Vector2 MeasureTextEx(Font font, const char* text, float fontSize, float spacing) {
+    (void)font;
+    _rayui_Null.textMeasures++;
+    if (!text) return (Vector2){0, 0};
+
+    int lines = 1, count = 0, widest = 0;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (*p == '\n') {
+            if (count > widest) widest = count;
+            count = 0;
+            lines++;
+        } else if ((*p & 0xC0) != 0x80) {
+            count++;
+        }
+    }
+    if (count > widest) widest = count;
+
+    float width = widest * fontSize * 0.5f + (widest > 0 ? (widest - 1) * spacing : 0);
+    return (Vector2){width, lines * fontSize};
+}
+
+#endif // RAYUI_BACKEND_NULL
+
 #ifdef OVERRIDE_RAYLIB_GETKEYNAME
 const char* GetKeyName(int key) {
     switch (key) {
@@ -506,801 +1342,4746 @@ const char* GetKeyName(int key) {
 }
 #endif
 
-void RAYUI_WITH_PREFIX(SetHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h, const char* info, bool drawAtTop) {
-    h->hoverInfo = info;
-    h->drawAtTop = drawAtTop;
-    h->lastMousePos = (Vector2){-1, -1};
-    h->active = true;
-    HOVER_INFO_ARRAY[HOVER_INFO_COUNT++] = h;
+// ---------------- CONTEXT ----------------
+// Everything the library shares between widgets lives in a context. Internal
+// functions fetch the current one once with _rayui_Ctx(), the default context
+// is set up on first use so the API works without ever creating one.
+
+typedef struct _rayui_TextCacheEntry {
+    unsigned long long hash;
+    unsigned int fontId;
+    float fontSize;
+    float spacing;
+    Vector2 size;
+    int hashNext;
+    int lruPrev, lruNext;
+} _rayui_TextCacheEntry;
+
+#define _RAYUI_TEXT_CACHE_BUCKETS (RAYUI_TEXT_CACHE_SIZE * 2)
+
+struct _rayui_DrawCommand;
+struct _rayui_FlushCellEntry;
+struct _rayui_HoverEntry;
+struct _rayui_HoverSlot;
+struct _rayui_HitEntry;
+struct _rayui_HitBucket;
+
+struct RAYUI_WITH_PREFIX(Context) {
+    Sound defaultSound;
+    Texture checkboxOnTexture;
+    Texture checkboxOffTexture;
+
+#ifdef RAYUI_STATS
+    RAYUI_WITH_PREFIX(FrameStats) statsCurrent;
+    RAYUI_WITH_PREFIX(FrameStats) statsLast;
+    int statsDepth;
+    int statsType; // -1 outside a widget call
+    bool statsPaused;
+    bool statsOverlay;
+#endif
+
+    _rayui_TextCacheEntry textCache[RAYUI_TEXT_CACHE_SIZE];
+    int textCacheBuckets[_RAYUI_TEXT_CACHE_BUCKETS];
+    int textCacheCount;
+    int textCacheHead; // most recently used
+    int textCacheTail; // least recently used
+    bool textCacheReady;
+    RAYUI_WITH_PREFIX(TextCacheStats) textCacheStats;
+
+    bool deferred;
+    struct _rayui_DrawCommand* commands;
+    int commandCount;
+    int commandCapacity;
+    char* commandText;
+    int commandTextSize;
+    int commandTextCapacity;
+    int* commandOrder;
+    int commandOrderCapacity;
+    int* flushCells; // head of each cell's entry list
+    int flushCellCapacity;
+    struct _rayui_FlushCellEntry* flushEntries;
+    int flushEntryCapacity;
+    RAYUI_WITH_PREFIX(FlushStats) flushStats;
+    Vector2 flushOrigin; // scissor rects are not affected by the panel camera
+
+    unsigned long long panelNestedHash;
+
+    unsigned int sdfAtlases[RAYUI_MAX_SDF_FONTS]; // texture ids of registered SDF fonts
+    int sdfCount;
+    Shader sdfShader;
+    bool sdfShaderOwned; // built-in shader, loaded on first use
+
+    char* frameArena;
+    int frameArenaUsed;
+    int frameArenaCapacity;
+    int frameArenaHighWater;
+    int frameArenaOverflows;
+
+    RAYUI_WITH_PREFIX(Input) input;
+    bool inputValid;
+
+    bool recording;
+    unsigned char* recData;
+    int recSize;
+    int recCapacity;
+    int recFrames;
+    bool recFailed;
+    RAYUI_WITH_PREFIX(Input) recPrev;
+    long long recPrevTime;
+
+    struct _rayui_HoverEntry* hoverEntries;
+    int hoverCount;
+    int hoverCapacity;
+    struct _rayui_HoverSlot* hoverSlots;
+    int hoverSlotCount;
+    int hoverSlotCapacity;
+    int* hoverFreeSlots;
+    int hoverFreeCount;
+    int hoverHoveredCount; // lets DrawHoverables return early when nothing is hovered
+
+    bool hitEnabled;
+    struct _rayui_HitEntry* hitEntries;
+    int hitEntryCount;
+    int hitEntryCapacity;
+    int* hitFree;
+    int hitFreeCount;
+    int hitLive;
+    struct _rayui_HitBucket* hitBuckets;
+    unsigned int hitStamp;
+    int hitCellX;
+    int hitCellY;
+    int hitCandidates;
+    unsigned int hitTests;
+    unsigned int hitSkipped;
+
+    int updateThreads;
+    struct _rayui_UpdatePool* updatePool; // started by the first parallel UpdateWidgets
+};
+
+static RAYUI_WITH_PREFIX(Context) _rayui_DefaultContext;
+static bool _rayui_DefaultContextReady = false;
+static RAYUI_THREAD_LOCAL RAYUI_WITH_PREFIX(Context)* _rayui_CurrentContext = NULL;
+
+// Set while a thread runs part of a parallel UpdateWidgets. Sounds and tooltip
+// changes are then queued with _rayui_QueueEffect instead of applied.
+struct _rayui_UpdateWorker;
+static RAYUI_THREAD_LOCAL struct _rayui_UpdateWorker* _rayui_CurrentWorker = NULL;
+static void _rayui_QueueEffect(Sound sound, unsigned int hoverHandle, bool hovered);
+
+static void _rayui_InitContext(RAYUI_WITH_PREFIX(Context)* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+#ifdef RAYUI_STATS
+    ctx->statsType = -1;
+#endif
+    ctx->textCacheHead = -1;
+    ctx->textCacheTail = -1;
+    ctx->textCacheStats.capacity = RAYUI_TEXT_CACHE_SIZE;
+    ctx->hitStamp = 1;
+    ctx->hitCellX = 0x7FFFFFFF;
+    ctx->hitCellY = 0x7FFFFFFF;
+    ctx->updateThreads = 1;
 }
 
-void RAYUI_WITH_PREFIX(DisableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h) {
-    h->active = false;
-    for (int i = 0; i < HOVER_INFO_COUNT; i++) {
-        if (HOVER_INFO_ARRAY[i] == h) {
-            for (int j = i; j < HOVER_INFO_COUNT - 1; j++) {
-                HOVER_INFO_ARRAY[j] = HOVER_INFO_ARRAY[j + 1];
-            }
-            HOVER_INFO_COUNT--;
-            break;
-        }
+static inline RAYUI_WITH_PREFIX(Context)* _rayui_Ctx(void) {
+    if (_rayui_CurrentContext) return _rayui_CurrentContext;
+    if (!_rayui_DefaultContextReady) {
+        _rayui_InitContext(&_rayui_DefaultContext);
+        _rayui_DefaultContextReady = true;
     }
+    return &_rayui_DefaultContext;
 }
 
-void RAYUI_WITH_PREFIX(EnableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h) {
-    h->active = true;
-    bool found = false;
-    for (int i = 0; i < HOVER_INFO_COUNT; i++) {
-        if (HOVER_INFO_ARRAY[i] == h) {
-            found = true;
-            break;
-        }
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(CreateContext)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = (RAYUI_WITH_PREFIX(Context)*)RAYUI_MALLOC(sizeof(RAYUI_WITH_PREFIX(Context)));
+    if (ctx) _rayui_InitContext(ctx);
+    return ctx;
+}
+
+// Freeing the default context only releases its resources, it stays usable
+void RAYUI_WITH_PREFIX(FreeContext)(RAYUI_WITH_PREFIX(Context)* ctx) {
+    if (!ctx) return;
+    RAYUI_WITH_PREFIX(Context)* previous = RAYUI_WITH_PREFIX(SetContext)(ctx);
+    RAYUI_WITH_PREFIX(FreeHoverInfo)();
+    RAYUI_WITH_PREFIX(FreeDrawCommands)();
+    RAYUI_WITH_PREFIX(FreeInputRecording)();
+    RAYUI_WITH_PREFIX(FreeHitIndex)();
+    RAYUI_WITH_PREFIX(SetUpdateThreads)(1);
+    RAYUI_FREE(ctx->frameArena);
+    if (ctx->checkboxOnTexture.id) UnloadTexture(ctx->checkboxOnTexture);
+    if (ctx->checkboxOffTexture.id) UnloadTexture(ctx->checkboxOffTexture);
+    if (ctx->sdfShaderOwned) UnloadShader(ctx->sdfShader);
+    _rayui_CurrentContext = previous == ctx ? NULL : previous;
+
+    if (ctx == &_rayui_DefaultContext) _rayui_InitContext(ctx);
+    else RAYUI_FREE(ctx);
+}
+
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(SetContext)(RAYUI_WITH_PREFIX(Context)* ctx) {
+    RAYUI_WITH_PREFIX(Context)* previous = _rayui_Ctx();
+    _rayui_CurrentContext = ctx;
+    return previous;
+}
+
+RAYUI_WITH_PREFIX(Context)* RAYUI_WITH_PREFIX(GetContext)(void) {
+    return _rayui_Ctx();
+}
+
+void RAYUI_WITH_PREFIX(SetDefaultSound)(Sound sound) {
+    _rayui_Ctx()->defaultSound = sound;
+}
+
+// ---------------- FRAME ARENA ----------------
+// One block per context, handed out front to back and reset at frame start, so
+// formatting a label costs a pointer bump and no draw call keeps static state.
+// A request that doesn't fit wraps to the front, which only clobbers strings
+// from earlier calls; everything allocated here is dead once the draw call that
+// asked for it returns (deferred drawing copies text). The block is resized to
+// the high-water mark on the next reset, so a steady frame never allocates.
+// Without BeginFrame/SetFrameInput it is never reset and simply acts as a ring.
+// Update workers get NULL, the arena belongs to the context's drawing thread.
+
+static void* _rayui_FrameAlloc(int bytes) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (_rayui_CurrentWorker || bytes < 0) return NULL;
+    bytes = (bytes + 7) & ~7;
+    if (!ctx->frameArena) {
+        ctx->frameArena = (char*)RAYUI_MALLOC(RAYUI_FRAME_ARENA_SIZE);
+        if (!ctx->frameArena) return NULL;
+        ctx->frameArenaCapacity = RAYUI_FRAME_ARENA_SIZE;
     }
-    if (!found && HOVER_INFO_COUNT < MAX_HOVERABLES) {
-        HOVER_INFO_ARRAY[HOVER_INFO_COUNT++] = h;
+    if (ctx->frameArenaUsed + bytes > ctx->frameArenaHighWater) ctx->frameArenaHighWater = ctx->frameArenaUsed + bytes;
+    if (ctx->frameArenaUsed + bytes > ctx->frameArenaCapacity) {
+        ctx->frameArenaOverflows++;
+        if (bytes > ctx->frameArenaCapacity) return NULL;
+        ctx->frameArenaUsed = 0;
     }
+    void* p = ctx->frameArena + ctx->frameArenaUsed;
+    ctx->frameArenaUsed += bytes;
+    return p;
 }
 
-void RAYUI_WITH_PREFIX(DrawHoverables)(Font font, int fontSize) {
-    Vector2 mousePoint = GetMousePosition();
-
-    for (int i = 0; i < HOVER_INFO_COUNT; i++) {
-        RAYUI_WITH_PREFIX(Hoverable)* h = HOVER_INFO_ARRAY[i];
-        if (!h->hoverInfo) continue;
+// printf into the arena, NULL when it doesn't fit
+static const char* _rayui_FrameFormat(const char* format, ...) {
+    va_list args, copy;
+    va_start(args, format);
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    char* text = length < 0 ? NULL : (char*)_rayui_FrameAlloc(length + 1);
+    if (text) vsnprintf(text, length + 1, format, args);
+    va_end(args);
+    return text;
+}
 
-        if (h->hoverStartTime > 0 &&
-            (h->lastMousePos.x != mousePoint.x || h->lastMousePos.y != mousePoint.y ||
-             IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonDown(MOUSE_RIGHT_BUTTON))) {
-            h->hoverStartTime = 0;
-        }
+static void _rayui_ResetFrameArena(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->frameArenaUsed = 0;
+    if (ctx->frameArenaHighWater <= ctx->frameArenaCapacity) return;
+
+    // Nothing in the old block is live between frames, no need to copy it
+    int capacity = ctx->frameArenaCapacity;
+    while (capacity < ctx->frameArenaHighWater) capacity *= 2;
+    char* block = (char*)RAYUI_MALLOC(capacity);
+    if (!block) return;
+    RAYUI_FREE(ctx->frameArena);
+    ctx->frameArena = block;
+    ctx->frameArenaCapacity = capacity;
+}
 
-        if (h->hovered && h->hoverStartTime == 0) {
-            h->hoverStartTime = GetTime();
-        }
+RAYUI_WITH_PREFIX(FrameArenaStats) RAYUI_WITH_PREFIX(GetFrameArenaStats)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(FrameArenaStats) s;
+    s.used = ctx->frameArenaUsed;
+    s.highWater = ctx->frameArenaHighWater;
+    s.capacity = ctx->frameArenaCapacity;
+    s.overflows = ctx->frameArenaOverflows;
+    return s;
+}
 
-        if (h->lastMousePos.x == -1 && h->lastMousePos.y == -1) {
-            h->lastMousePos = mousePoint;
-        } else {
-            h->lastMousePos = mousePoint;
-        }
+// ---------------- FRAME STATS ----------------
+// Compiled only with RAYUI_STATS. Otherwise the macros below expand to nothing
+// and widgets carry no instrumentation at all. Nested public calls (DrawButton
+// -> DrawButtonPro) are counted once, by the outermost call.
 
-        double t = GetTime() - h->hoverStartTime;
-        if (h->hovered && t >= h->delay) {
-            Vector2 infoSize = MeasureTextEx(font, h->hoverInfo, fontSize, 1);
-            float boxX = h->drawAtTop ? 10 : mousePoint.x + 16;
-            float boxY = h->drawAtTop ? 10 : mousePoint.y + 16;
+#ifdef RAYUI_STATS
 
-            DrawRectangle((int)boxX, (int)boxY, (int)infoSize.x + 10, (int)infoSize.y + 6, BLACK);
-            DrawTextEx(font, h->hoverInfo, (Vector2){boxX + 5, boxY + 3}, fontSize, 1, RAYWHITE);
+// Update workers are not instrumented, UpdateWidgets counts their work instead
+static inline double _rayui_StatsBegin(int type) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (_rayui_CurrentWorker) return 0;
+    if (ctx->statsDepth++ > 0) return 0;
+    ctx->statsType = type;
+    return GetTime();
+}
 
-            break;
-        }
+static inline void _rayui_StatsEnd(int type, bool draw, double start) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (_rayui_CurrentWorker) return;
+    if (--ctx->statsDepth > 0) return;
+    double elapsed = GetTime() - start;
+    RAYUI_WITH_PREFIX(WidgetStats)* w = &ctx->statsCurrent.widgets[type];
+    if (draw) {
+        w->draws++;
+        w->drawTime += elapsed;
+        ctx->statsCurrent.draws++;
+        ctx->statsCurrent.drawTime += elapsed;
+    } else {
+        w->updates++;
+        w->updateTime += elapsed;
+        ctx->statsCurrent.updates++;
+        ctx->statsCurrent.updateTime += elapsed;
     }
+    ctx->statsType = -1;
 }
 
-// ---------------- HOVER TEXT ----------------
-RAYUI_WITH_PREFIX(HoverText) RAYUI_WITH_PREFIX(CreateHoverText)(const char* text, Vector2 position, float delay) {
-    RAYUI_WITH_PREFIX(HoverText) ht;
-    ht.text = text;
-    ht.position = position;
-    ht.hover.hoverInfo = text;
-    ht.hover.hoverStartTime = 0;
-    ht.hover.hovered = false;
-    ht.hover.drawAtTop = true;
-    ht.hover.delay = delay;
-    ht.hover.active = false;
-    ht.hover.lastMousePos = (Vector2){-1, -1};
-    return ht;
+static inline void _rayui_StatsDrawCall(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->statsPaused || _rayui_CurrentWorker) return;
+    ctx->statsCurrent.drawCalls++;
+    if (ctx->statsType >= 0) ctx->statsCurrent.widgets[ctx->statsType].drawCalls++;
 }
 
-void RAYUI_WITH_PREFIX(DrawHoverText)(Font font, int fontSize, RAYUI_WITH_PREFIX(HoverText)* hoverText) {
-    if (!hoverText || !hoverText->text) return;
+#define _RAYUI_STATS_BEGIN(type) double _rayui_statsStart = _rayui_StatsBegin(type)
+#define _RAYUI_STATS_END(type, draw) _rayui_StatsEnd(type, draw, _rayui_statsStart)
+#define _RAYUI_STATS_DRAW_CALL() _rayui_StatsDrawCall()
+#define _RAYUI_STATS_COUNT(field) ((_rayui_Ctx()->statsPaused || _rayui_CurrentWorker) ? (void)0 : (void)_rayui_Ctx()->statsCurrent.field++)
+#else
+#define _RAYUI_STATS_BEGIN(type) ((void)0)
+#define _RAYUI_STATS_END(type, draw) ((void)0)
+#define _RAYUI_STATS_DRAW_CALL() ((void)0)
+#define _RAYUI_STATS_COUNT(field) ((void)0)
+#endif
 
-    DrawTextEx(font, hoverText->text, hoverText->position, fontSize, 1, RAYWHITE);
+static inline void _rayui_PlaySound(Sound sound) {
+    if (_rayui_CurrentWorker) { _rayui_QueueEffect(sound, 0, false); return; }
+    _RAYUI_STATS_COUNT(soundPlays);
+    PlaySound(sound);
 }
 
-void RAYUI_WITH_PREFIX(UpdateHoverText)(RAYUI_WITH_PREFIX(HoverText)* hoverText, Vector2 mousePoint) {
-    if (!hoverText) return;
+// ---------------- TEXT MEASURE CACHE ----------------
+// Fixed-size hash table with an LRU list threaded through the entries.
+// Entries are keyed by font texture, size, spacing and a 64-bit hash of the string.
 
-    Rectangle rect = {hoverText->position.x, hoverText->position.y,
-                      MeasureTextEx(GetFontDefault(), hoverText->text, 20, 1).x,
-                      MeasureTextEx(GetFontDefault(), hoverText->text, 20, 1).y};
-
-    if (!hoverText->hover.active) return;
-    hoverText->hover.hovered = CheckCollisionPointRec(mousePoint, rect);
+static unsigned long long _rayui_HashText(const char* text, unsigned int fontId, float fontSize, float spacing) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    unsigned int sizeBits, spacingBits;
+    memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+    memcpy(&spacingBits, &spacing, sizeof(spacingBits));
+    h ^= ((unsigned long long)fontId << 32) ^ sizeBits;
+    h *= 1099511628211ULL;
+    h ^= spacingBits;
+    h *= 1099511628211ULL;
+    return h;
 }
 
-// ---------------- BUTTON ----------------
-
-RAYUI_WITH_PREFIX(Button) RAYUI_WITH_PREFIX(CreateButton)(float x, float y, float width, float height, const char* text) {
-    RAYUI_WITH_PREFIX(Button) b;
-    b.rect = (Rectangle){x, y, width, height};
-    b.text = text;
-    b.hovered = false;
-    b.hover.hoverInfo = NULL;
-    b.hover.hoverStartTime = 0;
-    b.hover.hovered = false;
-    b.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    b.hover.active = false;
-    b.hoverSound = _rayui_DefaultSound;
-    b.clickSound = _rayui_DefaultSound;
-    return b;
+static void _rayui_TextCacheUnlink(int i) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_TextCacheEntry* e = &ctx->textCache[i];
+    if (e->lruPrev >= 0) ctx->textCache[e->lruPrev].lruNext = e->lruNext; else ctx->textCacheHead = e->lruNext;
+    if (e->lruNext >= 0) ctx->textCache[e->lruNext].lruPrev = e->lruPrev; else ctx->textCacheTail = e->lruPrev;
 }
 
-RAYUI_WITH_PREFIX(Button) RAYUI_WITH_PREFIX(CreateButtonWithSound)(float x, float y, float width, float height, const char* text, Sound hoverSound, Sound clickSound) {
-    RAYUI_WITH_PREFIX(Button) b;
-    b.rect = (Rectangle){x, y, width, height};
-    b.text = text;
-    b.hovered = false;
-    b.hover.hoverInfo = NULL;
-    b.hover.hoverStartTime = 0;
-    b.hover.hovered = false;
-    b.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    b.hover.active = false;
-    b.hoverSound = hoverSound;
-    b.clickSound = clickSound;
-    return b;
+static void _rayui_TextCachePushFront(int i) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_TextCacheEntry* e = &ctx->textCache[i];
+    e->lruPrev = -1;
+    e->lruNext = ctx->textCacheHead;
+    if (ctx->textCacheHead >= 0) ctx->textCache[ctx->textCacheHead].lruPrev = i;
+    ctx->textCacheHead = i;
+    if (ctx->textCacheTail < 0) ctx->textCacheTail = i;
 }
 
-bool RAYUI_WITH_PREFIX(UpdateButton)(RAYUI_WITH_PREFIX(Button)* b) {
-    b->hovered = CheckCollisionPointRec(GetMousePosition(), b->rect);
-    b->hover.hovered = b->hovered;
+void RAYUI_WITH_PREFIX(ClearTextCache)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    for (int i = 0; i < _RAYUI_TEXT_CACHE_BUCKETS; i++) ctx->textCacheBuckets[i] = -1;
+    ctx->textCacheCount = 0;
+    ctx->textCacheHead = -1;
+    ctx->textCacheTail = -1;
+    ctx->textCacheReady = true;
+    ctx->textCacheStats.count = 0;
+}
 
-    if (b->hover.hovered && b->hover.hoverStartTime == 0) {
-        b->hover.hoverStartTime = GetTime();
-        if (b->hoverSound.frameCount > 0 && b->hover.active) PlaySound(b->hoverSound);
+Vector2 RAYUI_WITH_PREFIX(MeasureTextCached)(Font font, const char* text, float fontSize, float spacing) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!text || !text[0]) return (Vector2){0, 0};
+    // Update workers only read the cache, misses are measured without storing them
+    bool worker = _rayui_CurrentWorker != NULL;
+    if (!ctx->textCacheReady) {
+        if (worker) return MeasureTextEx(font, text, fontSize, spacing);
+        RAYUI_WITH_PREFIX(ClearTextCache)();
     }
 
-    if (!b->hover.hovered) {
-        b->hover.hoverStartTime = 0;
+    unsigned long long hash = _rayui_HashText(text, font.texture.id, fontSize, spacing);
+    int bucket = (int)(hash % _RAYUI_TEXT_CACHE_BUCKETS);
+
+    for (int i = ctx->textCacheBuckets[bucket]; i >= 0; i = ctx->textCache[i].hashNext) {
+        _rayui_TextCacheEntry* e = &ctx->textCache[i];
+        if (e->hash == hash && e->fontId == font.texture.id && e->fontSize == fontSize && e->spacing == spacing) {
+            if (worker) return e->size;
+            if (i != ctx->textCacheHead) {
+                _rayui_TextCacheUnlink(i);
+                _rayui_TextCachePushFront(i);
+            }
+            ctx->textCacheStats.hits++;
+            return e->size;
+        }
     }
 
-    if (b->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (b->clickSound.frameCount > 0 && b->hover.active) PlaySound(b->clickSound);
-        return true;
+    if (worker) return MeasureTextEx(font, text, fontSize, spacing);
+    ctx->textCacheStats.misses++;
+
+    int slot;
+    if (ctx->textCacheCount < RAYUI_TEXT_CACHE_SIZE) {
+        slot = ctx->textCacheCount++;
+    } else {
+        // Evict the least recently used entry and unhook it from its bucket chain
+        slot = ctx->textCacheTail;
+        _rayui_TextCacheUnlink(slot);
+        int old = (int)(ctx->textCache[slot].hash % _RAYUI_TEXT_CACHE_BUCKETS);
+        int* link = &ctx->textCacheBuckets[old];
+        while (*link != slot) link = &ctx->textCache[*link].hashNext;
+        *link = ctx->textCache[slot].hashNext;
+        ctx->textCacheStats.evictions++;
     }
 
-    return false;
+    _rayui_TextCacheEntry* e = &ctx->textCache[slot];
+    e->hash = hash;
+    e->fontId = font.texture.id;
+    e->fontSize = fontSize;
+    e->spacing = spacing;
+    e->size = MeasureTextEx(font, text, fontSize, spacing);
+    _RAYUI_STATS_COUNT(textMeasures);
+    e->hashNext = ctx->textCacheBuckets[bucket];
+    ctx->textCacheBuckets[bucket] = slot;
+    _rayui_TextCachePushFront(slot);
+
+    ctx->textCacheStats.count = ctx->textCacheCount;
+    return e->size;
 }
 
-bool RAYUI_WITH_PREFIX(UpdateButtonWithMousePoint)(RAYUI_WITH_PREFIX(Button)* b, Vector2 mousePoint) {
-    b->hovered = CheckCollisionPointRec(mousePoint, b->rect);
-    b->hover.hovered = b->hovered;
+RAYUI_WITH_PREFIX(TextCacheStats) RAYUI_WITH_PREFIX(GetTextCacheStats)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->textCacheStats;
+}
 
-    if (b->hover.hovered && b->hover.hoverStartTime == 0) {
-        b->hover.hoverStartTime = GetTime();
-        if (b->hoverSound.frameCount > 0 && b->hover.active) PlaySound(b->hoverSound);
-    }
+// ---------------- SDF FONTS ----------------
+// Registered atlases are kept by texture id. Immediate draws wrap each text in
+// the SDF shader; deferred draws are grouped by texture at flush time, so each
+// run of SDF text costs one shader switch. The built-in shader is the raylib
+// SDF example's: alpha is smoothstepped around the 0.5 edge over one pixel's
+// worth of distance, whatever the scale.
+
+#if defined(PLATFORM_WEB) || defined(PLATFORM_ANDROID) || defined(GRAPHICS_API_OPENGL_ES2)
+static const char* _rayui_SDFShaderCode =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "void main() {\n"
+    "    float distance = texture2D(texture0, fragTexCoord).a - 0.5;\n"
+    "    float width = length(vec2(dFdx(distance), dFdy(distance)));\n"
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a*smoothstep(-width, width, distance));\n"
+    "}\n";
+#else
+static const char* _rayui_SDFShaderCode =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float distance = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float width = length(vec2(dFdx(distance), dFdy(distance)));\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a*smoothstep(-width, width, distance));\n"
+    "}\n";
+#endif
 
-    if (!b->hover.hovered) {
-        b->hover.hoverStartTime = 0;
+static bool _rayui_IsSDFAtlas(RAYUI_WITH_PREFIX(Context)* ctx, unsigned int textureId) {
+    for (int i = 0; i < ctx->sdfCount; i++) {
+        if (ctx->sdfAtlases[i] == textureId) return true;
     }
+    return false;
+}
 
-    if (b->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (b->clickSound.frameCount > 0 && b->hover.active) PlaySound(b->clickSound);
-        return true;
+static void _rayui_BeginSDFShader(RAYUI_WITH_PREFIX(Context)* ctx) {
+    if (!ctx->sdfShader.id) {
+        ctx->sdfShader = LoadShaderFromMemory(NULL, _rayui_SDFShaderCode);
+        ctx->sdfShaderOwned = true;
     }
+    BeginShaderMode(ctx->sdfShader);
+}
 
-    return false;
+// Immediate drawing only, deferred commands get the shader at flush time
+static bool _rayui_BeginSDF(Font font) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->deferred || ctx->sdfCount == 0 || !_rayui_IsSDFAtlas(ctx, font.texture.id)) return false;
+    _rayui_BeginSDFShader(ctx);
+    return true;
 }
 
-bool RAYUI_WITH_PREFIX(ButtonDown)(RAYUI_WITH_PREFIX(Button)* b) {
-    b->hovered = CheckCollisionPointRec(GetMousePosition(), b->rect);
-    return b->hovered && IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+static void _rayui_EndSDF(bool active) {
+    if (active) EndShaderMode();
 }
 
-void RAYUI_WITH_PREFIX(DrawButton)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize, Color color, Color hoverColor) {
-    Color col = b->hovered ? hoverColor : color;
+// Switches the shader when a flush moves between SDF and other textures
+static bool _rayui_FlushSDF(bool active, unsigned int textureId) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    bool sdf = ctx->sdfCount > 0 && textureId && _rayui_IsSDFAtlas(ctx, textureId);
+    if (sdf && !active) _rayui_BeginSDFShader(ctx);
+    else if (!sdf && active) EndShaderMode();
+    return sdf;
+}
 
-    Vector2 textSize = MeasureTextEx(font, b->text, fontSize, 2);
-    Vector2 pos = {
-        b->rect.x + b->rect.width/2 - textSize.x/2,
-        b->rect.y + b->rect.height/2 - textSize.y/2
-    };
-    DrawTextEx(font, b->text, pos, fontSize, 2, col);
+Font RAYUI_WITH_PREFIX(LoadSDFFont)(const char* fileName, int baseSize, int* codepoints, int codepointCount) {
+    Font font = {0};
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fileName, &dataSize);
+    if (!data) return font;
+
+    font.baseSize = baseSize;
+    font.glyphCount = codepointCount > 0 ? codepointCount : 95;
+    font.glyphPadding = 0;
+    font.glyphs = LoadFontData(data, dataSize, baseSize, codepoints, font.glyphCount, FONT_SDF);
+    UnloadFileData(data);
+    if (!font.glyphs) return (Font){0};
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, baseSize, 0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    // The shader needs interpolated distances between texels
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    // An unregistered atlas would be drawn without the shader, as blurry halos
+    if (!RAYUI_WITH_PREFIX(RegisterSDFFont)(font)) {
+        TraceLog(LOG_WARNING, "SDF FONT: [%s] Not loaded, %d SDF fonts already registered (RAYUI_MAX_SDF_FONTS)", fileName, RAYUI_MAX_SDF_FONTS);
+        UnloadFont(font);
+        return (Font){0};
+    }
+    return font;
 }
 
-void RAYUI_WITH_PREFIX(DrawButtonEx)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize,
-                                     Color color, Color hoverColor, int outline_width,
-                                     Color outlineColor, Color backgroundColor) 
-{
-    Color textCol = b->hovered ? hoverColor : color;
+bool RAYUI_WITH_PREFIX(RegisterSDFFont)(Font font) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!font.texture.id) return false;
+    if (_rayui_IsSDFAtlas(ctx, font.texture.id)) return true;
+    if (ctx->sdfCount == RAYUI_MAX_SDF_FONTS) return false;
+    ctx->sdfAtlases[ctx->sdfCount++] = font.texture.id;
+    return true;
+}
 
-    DrawRectangleRounded(b->rect, 0.1f, 0, backgroundColor);
+bool RAYUI_WITH_PREFIX(IsSDFFont)(Font font) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return font.texture.id && _rayui_IsSDFAtlas(ctx, font.texture.id);
+}
 
-    if (outline_width > 0) {
-        Rectangle borderRect = {b->rect.x - outline_width/2.0f, b->rect.y - outline_width/2.0f,
-                                b->rect.width + outline_width, b->rect.height + outline_width};
-        DrawRectangleRoundedLines(borderRect, 0.1f, 0, outlineColor);
+void RAYUI_WITH_PREFIX(UnloadSDFFont)(Font font) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    for (int i = 0; i < ctx->sdfCount; i++) {
+        if (ctx->sdfAtlases[i] == font.texture.id) {
+            ctx->sdfAtlases[i] = ctx->sdfAtlases[--ctx->sdfCount];
+            break;
+        }
     }
+    if (ctx->sdfCount == 0 && ctx->sdfShaderOwned) {
+        UnloadShader(ctx->sdfShader);
+        ctx->sdfShader = (Shader){0};
+        ctx->sdfShaderOwned = false;
+    }
+    UnloadFont(font);
+}
 
-    Vector2 textSize = MeasureTextEx(font, b->text, fontSize, 2);
+void RAYUI_WITH_PREFIX(SetSDFShader)(Shader shader) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->sdfShaderOwned) UnloadShader(ctx->sdfShader);
+    ctx->sdfShader = shader;
+    ctx->sdfShaderOwned = false;
+}
 
-    Vector2 textPos = {
-        b->rect.x + b->rect.width/2 - textSize.x/2,
-        b->rect.y + b->rect.height/2 - textSize.y/2
-    };
+// ---------------- DRAW COMMANDS ----------------
+// With deferred drawing on, widgets record commands instead of calling raylib.
+// Flush assigns every command the lowest layer that keeps it above anything it
+// overlaps with a different texture/primitive, then emits layer by layer grouped
+// by texture and primitive. Only non-overlapping commands are ever reordered.
+// Scissor changes are barriers: nothing is moved across them.
 
-    if (RAYUI_WITH_PREFIX(ButtonDown)(b)) {
-        textPos.x += 2;
-        textPos.y += 2;
+typedef enum {
+    _RAYUI_CMD_RECT,
+    _RAYUI_CMD_RECT_LINES,
+    _RAYUI_CMD_ROUNDED_RECT,
+    _RAYUI_CMD_ROUNDED_LINES,
+    _RAYUI_CMD_TRIANGLE,
+    _RAYUI_CMD_CIRCLE,
+    _RAYUI_CMD_CIRCLE_LINES,
+    _RAYUI_CMD_TEXTURE,
+    _RAYUI_CMD_TEXT,
+    _RAYUI_CMD_SCISSOR_BEGIN,
+    _RAYUI_CMD_SCISSOR_END
+} _rayui_DrawCommandType;
+
+typedef enum {
+    _RAYUI_PRIM_SOLID, // quads/triangles on the shapes texture
+    _RAYUI_PRIM_LINES,
+    _RAYUI_PRIM_TEXTURED
+} _rayui_DrawPrimitive;
+
+typedef struct _rayui_DrawCommand {
+    unsigned char type;
+    unsigned char primitive;
+    unsigned int textureId;
+    int layer;
+    Rectangle bounds;
+    Color color;
+    union {
+        struct { Rectangle rect; float param; int segments; } shape; // param: thickness, roundness or radius
+        struct { Vector2 a, b, c; } tri;
+        struct { Texture texture; Rectangle src, dst; } tex;
+        struct { Font font; int textOffset; Vector2 pos; float size, spacing; } text;
+    } as;
+} _rayui_DrawCommand;
+
+typedef struct _rayui_FlushCellEntry {
+    int command;
+    int next;
+} _rayui_FlushCellEntry;
+
+
+static _rayui_DrawCommand* _rayui_PushCommand(unsigned char type, unsigned char primitive, unsigned int textureId, Rectangle bounds, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->commandCount == ctx->commandCapacity) {
+        int capacity = ctx->commandCapacity ? ctx->commandCapacity * 2 : 256;
+        _rayui_DrawCommand* commands = (_rayui_DrawCommand*)RAYUI_REALLOC(ctx->commands, capacity * sizeof(_rayui_DrawCommand));
+        if (!commands) return NULL;
+        ctx->commands = commands;
+        ctx->commandCapacity = capacity;
     }
+    _rayui_DrawCommand* c = &ctx->commands[ctx->commandCount++];
+    c->type = type;
+    c->primitive = primitive;
+    c->textureId = textureId;
+    c->layer = 0;
+    c->bounds = bounds;
+    c->color = color;
+    return c;
+}
 
-    DrawTextEx(font, b->text, textPos, fontSize, 2, textCol);
+static int _rayui_PushCommandText(const char* text) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    int len = (int)strlen(text) + 1;
+    if (ctx->commandTextSize + len > ctx->commandTextCapacity) {
+        int capacity = ctx->commandTextCapacity ? ctx->commandTextCapacity : 4096;
+        while (capacity < ctx->commandTextSize + len) capacity *= 2;
+        char* pool = (char*)RAYUI_REALLOC(ctx->commandText, capacity);
+        if (!pool) return -1;
+        ctx->commandText = pool;
+        ctx->commandTextCapacity = capacity;
+    }
+    int offset = ctx->commandTextSize;
+    memcpy(ctx->commandText + offset, text, len);
+    ctx->commandTextSize += len;
+    return offset;
 }
 
-void RAYUI_WITH_PREFIX(DrawButtonPro)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize,
-                                     Color color, Color hoverColor, int outline_width,
-                                     Color outlineColor, Color backgroundColor,
-                                     int textPressOffsetRight, int textPressOffsetDown,
-                                     Color shadowColor, bool shadowEnabled) 
-{
-    Color textCol = b->hovered ? hoverColor : color;
+static Rectangle _rayui_ExpandRect(Rectangle r, float by) {
+    return (Rectangle){r.x - by, r.y - by, r.width + 2*by, r.height + 2*by};
+}
 
-    DrawRectangleRounded(b->rect, 0.1f, 0, backgroundColor);
+static void _rayui_DrawRectangleRec(Rectangle rect, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawRectangleRec(rect, color); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_RECT, _RAYUI_PRIM_SOLID, 0, rect, color);
+    if (c) c->as.shape.rect = rect;
+}
 
-    if (outline_width > 0) {
-        Rectangle borderRect = {b->rect.x - outline_width/2.0f, b->rect.y - outline_width/2.0f,
-                                b->rect.width + outline_width, b->rect.height + outline_width};
-        DrawRectangleRoundedLines(borderRect, 0.1f, 0, outlineColor);
-    }
+static void _rayui_DrawRectangleLinesEx(Rectangle rect, float thickness, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawRectangleLinesEx(rect, thickness, color); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_RECT_LINES, _RAYUI_PRIM_SOLID, 0, rect, color);
+    if (c) { c->as.shape.rect = rect; c->as.shape.param = thickness; }
+}
 
-    Vector2 textSize = MeasureTextEx(font, b->text, fontSize, 2);
+static void _rayui_DrawRectangleRounded(Rectangle rect, float roundness, int segments, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawRectangleRounded(rect, roundness, segments, color); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_ROUNDED_RECT, _RAYUI_PRIM_SOLID, 0, rect, color);
+    if (c) { c->as.shape.rect = rect; c->as.shape.param = roundness; c->as.shape.segments = segments; }
+}
 
-    Vector2 textPos = {
-        b->rect.x + b->rect.width/2 - textSize.x/2,
-        b->rect.y + b->rect.height/2 - textSize.y/2
-    };
+static void _rayui_DrawRectangleRoundedLines(Rectangle rect, float roundness, int segments, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawRectangleRoundedLines(rect, roundness, segments, color); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_ROUNDED_LINES, _RAYUI_PRIM_LINES, 0, _rayui_ExpandRect(rect, 1), color);
+    if (c) { c->as.shape.rect = rect; c->as.shape.param = roundness; c->as.shape.segments = segments; }
+}
 
-    if (RAYUI_WITH_PREFIX(ButtonDown)(b)) {
-        textPos.x += textPressOffsetRight;
-        textPos.y += textPressOffsetDown;
-    }
+static void _rayui_DrawTriangle(Vector2 a, Vector2 b, Vector2 c, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawTriangle(a, b, c, color); return; }
+    float minX = fminf(a.x, fminf(b.x, c.x)), minY = fminf(a.y, fminf(b.y, c.y));
+    float maxX = fmaxf(a.x, fmaxf(b.x, c.x)), maxY = fmaxf(a.y, fmaxf(b.y, c.y));
+    _rayui_DrawCommand* cmd = _rayui_PushCommand(_RAYUI_CMD_TRIANGLE, _RAYUI_PRIM_SOLID, 0,
+                                                 (Rectangle){minX, minY, maxX - minX, maxY - minY}, color);
+    if (cmd) { cmd->as.tri.a = a; cmd->as.tri.b = b; cmd->as.tri.c = c; }
+}
 
-    if (shadowEnabled) {
-        Vector2 shadowPos = { textPos.x + textPressOffsetRight, textPos.y + textPressOffsetDown };
-        DrawTextEx(font, b->text, shadowPos, fontSize, 2, shadowColor);
-    }
+static void _rayui_DrawCircle(int x, int y, float radius, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawCircle(x, y, radius, color); return; }
+    Rectangle bounds = {x - radius, y - radius, 2*radius, 2*radius};
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_CIRCLE, _RAYUI_PRIM_SOLID, 0, bounds, color);
+    if (c) { c->as.shape.rect = bounds; c->as.shape.param = radius; }
+}
 
-    DrawTextEx(font, b->text, textPos, fontSize, 2, textCol);
+static void _rayui_DrawCircleLines(int x, int y, float radius, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawCircleLines(x, y, radius, color); return; }
+    Rectangle bounds = {x - radius, y - radius, 2*radius, 2*radius};
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_CIRCLE_LINES, _RAYUI_PRIM_LINES, 0, _rayui_ExpandRect(bounds, 1), color);
+    if (c) { c->as.shape.rect = bounds; c->as.shape.param = radius; }
 }
 
+static void _rayui_DrawTexturePro(Texture texture, Rectangle src, Rectangle dst, Color tint) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) { DrawTexturePro(texture, src, dst, (Vector2){0, 0}, 0.0f, tint); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_TEXTURE, _RAYUI_PRIM_TEXTURED, texture.id, dst, tint);
+    if (c) { c->as.tex.texture = texture; c->as.tex.src = src; c->as.tex.dst = dst; }
+}
 
-// ---------------- TOGGLE ----------------
+static void _rayui_DrawTextEx(Font font, const char* text, Vector2 pos, float fontSize, float spacing, Color color) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _RAYUI_STATS_DRAW_CALL();
+    if (!ctx->deferred) {
+        bool sdf = _rayui_BeginSDF(font);
+        DrawTextEx(font, text, pos, fontSize, spacing, color);
+        _rayui_EndSDF(sdf);
+        return;
+    }
+    if (!text || !text[0]) return;
+
+    // Text is copied, callers may pass stack or static buffers
+    int offset = _rayui_PushCommandText(text);
+    if (offset < 0) return;
+    Vector2 size = RAYUI_WITH_PREFIX(MeasureTextCached)(font, text, fontSize, spacing);
+    Rectangle bounds = {pos.x, pos.y, size.x, size.y};
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_TEXT, _RAYUI_PRIM_TEXTURED, font.texture.id, bounds, color);
+    if (c) {
+        c->as.text.font = font;
+        c->as.text.textOffset = offset;
+        c->as.text.pos = pos;
+        c->as.text.size = fontSize;
+        c->as.text.spacing = spacing;
+    }
+}
 
-RAYUI_WITH_PREFIX(ToggleLabel) RAYUI_WITH_PREFIX(CreateToggle)(float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel) {
-    RAYUI_WITH_PREFIX(ToggleLabel) t;
-    t.rect = (Rectangle){x, y, width, height};
-    t.value = initial;
-    t.hovered = false;
-    t.hover.hoverInfo = NULL;
-    t.onLabel = onLabel;
-    t.offLabel = offLabel;
-    t.hover.hoverStartTime = 0;
-    t.hover.hovered = false;
-    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    t.hover.active = false;
-    t.hoverSound = _rayui_DefaultSound;
-    t.clickSound = _rayui_DefaultSound;
-    return t;
+// Draws one glyph by font index, the same way DrawTextCodepoint does but
+// without looking the codepoint up again
+static void _rayui_DrawGlyph(Font font, int index, Vector2 pos, float fontSize, Color color) {
+    int value = font.glyphs[index].value;
+    if (value == ' ' || value == '\t') return;
+    float scale = fontSize / (float)font.baseSize;
+    float pad = (float)font.glyphPadding;
+    Rectangle src = { font.recs[index].x - pad, font.recs[index].y - pad, font.recs[index].width + 2*pad, font.recs[index].height + 2*pad };
+    Rectangle dst = { pos.x + (font.glyphs[index].offsetX - pad)*scale, pos.y + (font.glyphs[index].offsetY - pad)*scale,
+                      src.width*scale, src.height*scale };
+    _rayui_DrawTexturePro(font.texture, src, dst, color);
 }
 
-RAYUI_WITH_PREFIX(ToggleLabel) RAYUI_WITH_PREFIX(CreateToggleWithSound)(float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel, Sound hoverSound, Sound clickSound) {
-    RAYUI_WITH_PREFIX(ToggleLabel) t;
-    t.rect = (Rectangle){x, y, width, height};
-    t.value = initial;
-    t.hovered = false;
-    t.hover.hoverInfo = NULL;
-    t.onLabel = onLabel;
-    t.offLabel = offLabel;
-    t.hover.hoverStartTime = 0;
-    t.hover.hovered = false;
-    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    t.hover.active = false;
-    t.hoverSound = hoverSound;
-    t.clickSound = clickSound;
-    return t;
+static void _rayui_BeginScissor(Rectangle rect) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->deferred) { BeginScissorMode((int)rect.x, (int)rect.y, (int)rect.width, (int)rect.height); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_SCISSOR_BEGIN, _RAYUI_PRIM_SOLID, 0, rect, BLANK);
+    if (c) c->as.shape.rect = rect;
 }
 
-void RAYUI_WITH_PREFIX(UpdateToggleLabel)(RAYUI_WITH_PREFIX(ToggleLabel)* t, Vector2 mousePoint) {
-    t->hovered = CheckCollisionPointRec(mousePoint, t->rect);
-    t->hover.hovered = t->hovered;
+static void _rayui_EndScissor(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->deferred) { EndScissorMode(); return; }
+    _rayui_DrawCommand* c = _rayui_PushCommand(_RAYUI_CMD_SCISSOR_END, _RAYUI_PRIM_SOLID, 0, (Rectangle){0}, BLANK);
+    if (c) c->as.shape.rect = (Rectangle){0};
+}
 
-    if (t->hover.hovered && t->hover.hoverStartTime == 0) {
-        t->hover.hoverStartTime = GetTime();
-        if (t->hoverSound.frameCount > 0 && t->hover.active) PlaySound(t->hoverSound);
-    }
+static bool _rayui_IsBarrier(const _rayui_DrawCommand* c) {
+    return c->type == _RAYUI_CMD_SCISSOR_BEGIN || c->type == _RAYUI_CMD_SCISSOR_END;
+}
 
-    if (!t->hover.hovered) {
-        t->hover.hoverStartTime = 0;
-    }
+static unsigned int _rayui_CommandKey(const _rayui_DrawCommand* c) {
+    return (c->textureId << 2) | c->primitive;
+}
 
-    if (t->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (t->clickSound.frameCount > 0 && t->hover.active) PlaySound(t->clickSound);
-        t->value = !t->value;
+static void _rayui_ExecuteCommand(const _rayui_DrawCommand* c) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    switch (c->type) {
+        case _RAYUI_CMD_RECT: DrawRectangleRec(c->as.shape.rect, c->color); break;
+        case _RAYUI_CMD_RECT_LINES: DrawRectangleLinesEx(c->as.shape.rect, c->as.shape.param, c->color); break;
+        case _RAYUI_CMD_ROUNDED_RECT: DrawRectangleRounded(c->as.shape.rect, c->as.shape.param, c->as.shape.segments, c->color); break;
+        case _RAYUI_CMD_ROUNDED_LINES: DrawRectangleRoundedLines(c->as.shape.rect, c->as.shape.param, c->as.shape.segments, c->color); break;
+        case _RAYUI_CMD_TRIANGLE: DrawTriangle(c->as.tri.a, c->as.tri.b, c->as.tri.c, c->color); break;
+        case _RAYUI_CMD_CIRCLE:
+            DrawCircle((int)(c->as.shape.rect.x + c->as.shape.param), (int)(c->as.shape.rect.y + c->as.shape.param), c->as.shape.param, c->color);
+            break;
+        case _RAYUI_CMD_CIRCLE_LINES:
+            DrawCircleLines((int)(c->as.shape.rect.x + c->as.shape.param), (int)(c->as.shape.rect.y + c->as.shape.param), c->as.shape.param, c->color);
+            break;
+        case _RAYUI_CMD_TEXTURE:
+            DrawTexturePro(c->as.tex.texture, c->as.tex.src, c->as.tex.dst, (Vector2){0, 0}, 0.0f, c->color);
+            break;
+        case _RAYUI_CMD_TEXT:
+            DrawTextEx(c->as.text.font, ctx->commandText + c->as.text.textOffset, c->as.text.pos,
+                       c->as.text.size, c->as.text.spacing, c->color);
+            break;
+        case _RAYUI_CMD_SCISSOR_BEGIN:
+            BeginScissorMode((int)(c->as.shape.rect.x - ctx->flushOrigin.x), (int)(c->as.shape.rect.y - ctx->flushOrigin.y),
+                             (int)c->as.shape.rect.width, (int)c->as.shape.rect.height);
+            break;
+        case _RAYUI_CMD_SCISSOR_END: EndScissorMode(); break;
     }
 }
 
-void RAYUI_WITH_PREFIX(DrawToggleLabel)(RAYUI_WITH_PREFIX(ToggleLabel)* t, Font font, int fontSize, Color color, Color hoverColor, Color backgroundColor) {
-    Color col = t->hovered ? hoverColor : color;
-    DrawRectangleRec(t->rect, backgroundColor);
-    DrawTextEx(font, t->value ? t->onLabel : t->offLabel, (Vector2){t->rect.x + 5, t->rect.y + 5}, fontSize, 2, col);
+static RAYUI_THREAD_LOCAL const _rayui_DrawCommand* _rayui_SortBase = NULL;
+
+static int _rayui_CompareCommands(const void* pa, const void* pb) {
+    int ia = *(const int*)pa, ib = *(const int*)pb;
+    const _rayui_DrawCommand* a = &_rayui_SortBase[ia];
+    const _rayui_DrawCommand* b = &_rayui_SortBase[ib];
+    if (a->layer != b->layer) return a->layer < b->layer ? -1 : 1;
+    unsigned int ka = _rayui_CommandKey(a), kb = _rayui_CommandKey(b);
+    if (ka != kb) return ka < kb ? -1 : 1;
+    return (ia > ib) - (ia < ib);
 }
 
-void RAYUI_WITH_PREFIX(DrawToggleLabelEx)(
-    RAYUI_WITH_PREFIX(ToggleLabel)* t, Font font, int fontSize,
-    Color color, Color hoverColor, Color backgroundColor,
-    int outline_width, Color outlineColor
-) {
-    Color col = t->hovered ? hoverColor : color;
+void RAYUI_WITH_PREFIX(SetDeferredDrawing)(bool enabled) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->deferred && !enabled) RAYUI_WITH_PREFIX(Flush)();
+    ctx->deferred = enabled;
+}
+
+bool RAYUI_WITH_PREFIX(IsDeferredDrawing)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->deferred;
+}
 
-    DrawRectangleRec(t->rect, backgroundColor);
+// Sorts and emits commands [start, count), then drops them from the buffer
+static void _rayui_FlushCommands(int start, int textStart, RAYUI_WITH_PREFIX(FlushStats)* stats) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_DrawCommand* commands = ctx->commands + start;
+    int n = ctx->commandCount - start;
+    *stats = (RAYUI_WITH_PREFIX(FlushStats)){0};
+    stats->commands = n;
+    if (n <= 0) return;
+
+    int cols = GetScreenWidth() / RAYUI_FLUSH_CELL_SIZE + 1;
+    int rows = GetScreenHeight() / RAYUI_FLUSH_CELL_SIZE + 1;
+    if (cols < 1) cols = 1;
+    if (rows < 1) rows = 1;
+
+    if (cols*rows > ctx->flushCellCapacity) {
+        int* cells = (int*)RAYUI_REALLOC(ctx->flushCells, cols*rows * sizeof(int));
+        if (cells) { ctx->flushCells = cells; ctx->flushCellCapacity = cols*rows; }
+    }
+    if (n > ctx->commandOrderCapacity) {
+        int* order = (int*)RAYUI_REALLOC(ctx->commandOrder, n * sizeof(int));
+        if (order) { ctx->commandOrder = order; ctx->commandOrderCapacity = n; }
+    }
 
-    if (outline_width > 0) {
-        
-        DrawRectangleLinesEx(t->rect, (float)outline_width, outlineColor);
+    bool failed = (cols*rows > ctx->flushCellCapacity || n > ctx->commandOrderCapacity);
+    int entryCount = 0;
+    int maxLayer = 0;
+    int minLayer = 0; // lowest layer allowed after the last barrier
+
+    if (!failed) for (int i = 0; i < cols*rows; i++) ctx->flushCells[i] = -1;
+
+    // Pass 1: a command goes one layer above every earlier command it overlaps
+    // with a different state, and on the same layer as overlapping ones sharing it
+    for (int i = 0; i < n && !failed; i++) {
+        _rayui_DrawCommand* c = &commands[i];
+        Rectangle r = c->bounds;
+        unsigned int key = _rayui_CommandKey(c);
+        ctx->commandOrder[i] = i;
+
+        // A barrier gets a layer of its own above everything submitted so far
+        if (_rayui_IsBarrier(c)) {
+            c->layer = ++maxLayer;
+            minLayer = maxLayer + 1;
+            continue;
+        }
+
+        int x0 = (int)Clamp(floorf(r.x / RAYUI_FLUSH_CELL_SIZE), 0, cols - 1);
+        int y0 = (int)Clamp(floorf(r.y / RAYUI_FLUSH_CELL_SIZE), 0, rows - 1);
+        int x1 = (int)Clamp(floorf((r.x + r.width) / RAYUI_FLUSH_CELL_SIZE), 0, cols - 1);
+        int y1 = (int)Clamp(floorf((r.y + r.height) / RAYUI_FLUSH_CELL_SIZE), 0, rows - 1);
+
+        int layer = minLayer;
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                for (int e = ctx->flushCells[y*cols + x]; e >= 0; e = ctx->flushEntries[e].next) {
+                    const _rayui_DrawCommand* o = &commands[ctx->flushEntries[e].command];
+                    Rectangle q = o->bounds;
+                    if (r.x >= q.x + q.width || q.x >= r.x + r.width || r.y >= q.y + q.height || q.y >= r.y + r.height) continue;
+                    int need = (_rayui_CommandKey(o) != key) ? o->layer + 1 : o->layer;
+                    if (need > layer) layer = need;
+                }
+            }
+        }
+        c->layer = layer;
+        if (layer > maxLayer) maxLayer = layer;
+
+        int needed = entryCount + (x1 - x0 + 1)*(y1 - y0 + 1);
+        if (needed > ctx->flushEntryCapacity) {
+            int capacity = ctx->flushEntryCapacity ? ctx->flushEntryCapacity : 1024;
+            while (capacity < needed) capacity *= 2;
+            _rayui_FlushCellEntry* entries = (_rayui_FlushCellEntry*)RAYUI_REALLOC(ctx->flushEntries, capacity * sizeof(_rayui_FlushCellEntry));
+            if (!entries) { failed = true; break; }
+            ctx->flushEntries = entries;
+            ctx->flushEntryCapacity = capacity;
+        }
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                ctx->flushEntries[entryCount] = (_rayui_FlushCellEntry){i, ctx->flushCells[y*cols + x]};
+                ctx->flushCells[y*cols + x] = entryCount++;
+            }
+        }
+
+        if (i > 0 && _rayui_CommandKey(&commands[i - 1]) != key) stats->stateChangesUnsorted++;
     }
 
-    const char* text = t->value ? t->onLabel : t->offLabel;
-    Vector2 textSize = MeasureTextEx(font, text, fontSize, 2);
+    if (failed) {
+        // Out of memory: emit in submission order
+        bool sdf = false;
+        for (int i = 0; i < n; i++) {
+            sdf = _rayui_FlushSDF(sdf, commands[i].textureId);
+            _rayui_ExecuteCommand(&commands[i]);
+        }
+        _rayui_FlushSDF(sdf, 0);
+        ctx->commandCount = start;
+        ctx->commandTextSize = textStart;
+        return;
+    }
 
-    Vector2 textPos = {
-        t->rect.x + t->rect.width / 2 - textSize.x / 2,
-        t->rect.y + t->rect.height / 2 - textSize.y / 2
-    };
+    // Pass 2: stable order by (layer, state)
+    _rayui_SortBase = commands;
+    qsort(ctx->commandOrder, n, sizeof(int), _rayui_CompareCommands);
+
+    unsigned int lastKey = 0;
+    bool sdf = false;
+    for (int i = 0; i < n; i++) {
+        const _rayui_DrawCommand* c = &commands[ctx->commandOrder[i]];
+        unsigned int key = _rayui_CommandKey(c);
+        if (i > 0 && key != lastKey) stats->stateChanges++;
+        if (i == 0 || key != lastKey) sdf = _rayui_FlushSDF(sdf, c->textureId);
+        lastKey = key;
+        _rayui_ExecuteCommand(c);
+    }
+    _rayui_FlushSDF(sdf, 0);
 
-    DrawTextEx(font, text, textPos, fontSize, 2, col);
+    stats->layers = maxLayer + 1;
+    ctx->commandCount = start;
+    ctx->commandTextSize = textStart;
 }
 
-bool RAYUI_WITH_PREFIX(GetToggleValue)(RAYUI_WITH_PREFIX(ToggleLabel)* t) {
-    return t->value;
+void RAYUI_WITH_PREFIX(Flush)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_FlushCommands(0, 0, &ctx->flushStats);
 }
 
-void RAYUI_WITH_PREFIX(SetToggleValue)(RAYUI_WITH_PREFIX(ToggleLabel)* t, bool value) {
-    t->value = value;
+RAYUI_WITH_PREFIX(FlushStats) RAYUI_WITH_PREFIX(GetFlushStats)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->flushStats;
 }
 
+void RAYUI_WITH_PREFIX(FreeDrawCommands)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_FREE(ctx->commands);
+    RAYUI_FREE(ctx->commandText);
+    RAYUI_FREE(ctx->commandOrder);
+    RAYUI_FREE(ctx->flushCells);
+    RAYUI_FREE(ctx->flushEntries);
+    ctx->commands = NULL;
+    ctx->commandText = NULL;
+    ctx->commandOrder = NULL;
+    ctx->flushCells = NULL;
+    ctx->flushEntries = NULL;
+    ctx->commandCount = ctx->commandCapacity = 0;
+    ctx->commandTextSize = ctx->commandTextCapacity = 0;
+    ctx->commandOrderCapacity = 0;
+    ctx->flushCellCapacity = 0;
+    ctx->flushEntryCapacity = 0;
+}
 
-// ---------------- CHECKBOX ----------------
+// ---------------- PANEL ----------------
+// Members are drawn between BeginPanel/EndPanel as usual, but only recorded.
+// EndPanel hashes the recorded commands; the hash covers everything visible
+// (hover, values, focus, expansion, cursor blink), so an unchanged hash means
+// the cached texture is still valid and the commands are dropped.
 
-RAYUI_WITH_PREFIX(Checkbox) RAYUI_WITH_PREFIX(CreateCheckbox)(float x, float y, float size, bool initial) {
-    RAYUI_WITH_PREFIX(Checkbox) c;
-    c.value = initial;
-    c.hovered = false;
-    c.hover.hoverInfo = NULL;
-    c.hover.hoverStartTime = 0;
-    c.hover.hovered = false;
-    c.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    c.hover.active = false;
-    c.hoverSound = _rayui_DefaultSound;
-    c.clickSound = _rayui_DefaultSound;
 
-    c.checkboxOnImage = RAYUI_WITH_PREFIX(GetCheckboxOnTexture)();
-    c.checkboxOffImage = RAYUI_WITH_PREFIX(GetCheckboxOffTexture)();
+static unsigned long long _rayui_HashBytes(unsigned long long h, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
 
-    c.rect = (Rectangle){ x, y, size, size };
+static unsigned long long _rayui_HashCommand(unsigned long long h, const _rayui_DrawCommand* c) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    h = _rayui_HashBytes(h, &c->type, sizeof(c->type));
+    h = _rayui_HashBytes(h, &c->textureId, sizeof(c->textureId));
+    h = _rayui_HashBytes(h, &c->color, sizeof(c->color));
+    switch (c->type) {
+        case _RAYUI_CMD_TRIANGLE:
+            h = _rayui_HashBytes(h, &c->as.tri, sizeof(c->as.tri));
+            break;
+        case _RAYUI_CMD_TEXTURE:
+            h = _rayui_HashBytes(h, &c->as.tex.src, sizeof(c->as.tex.src));
+            h = _rayui_HashBytes(h, &c->as.tex.dst, sizeof(c->as.tex.dst));
+            break;
+        case _RAYUI_CMD_TEXT: {
+            const char* text = ctx->commandText + c->as.text.textOffset;
+            h = _rayui_HashBytes(h, text, strlen(text));
+            h = _rayui_HashBytes(h, &c->as.text.pos, sizeof(c->as.text.pos));
+            h = _rayui_HashBytes(h, &c->as.text.size, sizeof(c->as.text.size));
+            h = _rayui_HashBytes(h, &c->as.text.spacing, sizeof(c->as.text.spacing));
+            break;
+        }
+        default:
+            h = _rayui_HashBytes(h, &c->as.shape.rect, sizeof(c->as.shape.rect));
+            h = _rayui_HashBytes(h, &c->as.shape.param, sizeof(c->as.shape.param));
+            if (c->type == _RAYUI_CMD_ROUNDED_RECT || c->type == _RAYUI_CMD_ROUNDED_LINES)
+                h = _rayui_HashBytes(h, &c->as.shape.segments, sizeof(c->as.shape.segments));
+            break;
+    }
+    return h;
+}
 
-    return c;
+RAYUI_WITH_PREFIX(Panel) RAYUI_WITH_PREFIX(CreatePanel)(float x, float y, float width, float height) {
+    RAYUI_WITH_PREFIX(Panel) p;
+    p.rect = (Rectangle){x, y, width, height};
+    p.target = (RenderTexture2D){0};
+    p.contentHash = 0;
+    p.savedNestedHash = 0;
+    p.commandStart = 0;
+    p.textStart = 0;
+    p.wasDeferred = false;
+    p.dirty = true;
+    p.renderCount = 0;
+    p.reuseCount = 0;
+    return p;
 }
 
-void RAYUI_WITH_PREFIX(UpdateCheckbox)(RAYUI_WITH_PREFIX(Checkbox)* c, Vector2 mousePoint) {
-    c->hovered = CheckCollisionPointRec(mousePoint, c->rect);
-    c->hover.hovered = c->hovered;
+void RAYUI_WITH_PREFIX(BeginPanel)(RAYUI_WITH_PREFIX(Panel)* p) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    p->wasDeferred = ctx->deferred;
+    p->commandStart = ctx->commandCount;
+    p->textStart = ctx->commandTextSize;
+    p->savedNestedHash = ctx->panelNestedHash;
+    ctx->panelNestedHash = 0;
+    ctx->deferred = true;
+}
 
-    if (c->hover.hovered && c->hover.hoverStartTime == 0) {
-        c->hover.hoverStartTime = GetTime();
-        if (c->hoverSound.frameCount > 0 && c->hover.active) PlaySound(c->hoverSound);
+void RAYUI_WITH_PREFIX(EndPanel)(RAYUI_WITH_PREFIX(Panel)* p) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i = p->commandStart; i < ctx->commandCount; i++) h = _rayui_HashCommand(h, &ctx->commands[i]);
+    h = _rayui_HashBytes(h, &p->rect, sizeof(p->rect));
+    h ^= ctx->panelNestedHash; // content of panels nested inside this one
+
+    int w = (int)p->rect.width;
+    int hgt = (int)p->rect.height;
+    if (p->target.id == 0 || p->target.texture.width != w || p->target.texture.height != hgt) {
+        if (p->target.id) UnloadRenderTexture(p->target);
+        p->target = LoadRenderTexture(w > 0 ? w : 1, hgt > 0 ? hgt : 1);
+        p->dirty = true;
     }
 
-    if (!c->hover.hovered) {
-        c->hover.hoverStartTime = 0;
+    if (p->dirty || h != p->contentHash) {
+        RAYUI_WITH_PREFIX(FlushStats) stats;
+        Camera2D camera = {{-p->rect.x, -p->rect.y}, {0, 0}, 0.0f, 1.0f};
+        BeginTextureMode(p->target);
+        ClearBackground(BLANK);
+        BeginMode2D(camera);
+        Vector2 origin = ctx->flushOrigin;
+        ctx->flushOrigin = (Vector2){p->rect.x, p->rect.y};
+        _rayui_FlushCommands(p->commandStart, p->textStart, &stats);
+        ctx->flushOrigin = origin;
+        EndMode2D();
+        EndTextureMode();
+        p->contentHash = h;
+        p->dirty = false;
+        p->renderCount++;
+    } else {
+        ctx->commandCount = p->commandStart;
+        ctx->commandTextSize = p->textStart;
+        p->reuseCount++;
     }
 
-    if (c->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (c->clickSound.frameCount > 0 && c->hover.active) PlaySound(c->clickSound);
-        c->value = !c->value;
-    }
+    ctx->panelNestedHash = p->savedNestedHash ^ (h * 1099511628211ULL);
+    ctx->deferred = p->wasDeferred;
+
+    // Render textures are stored upside down
+    Rectangle src = {0, 0, (float)p->target.texture.width, -(float)p->target.texture.height};
+    _rayui_DrawTexturePro(p->target.texture, src, p->rect, WHITE);
 }
 
-void RAYUI_WITH_PREFIX(DrawCheckboxColors)(RAYUI_WITH_PREFIX(Checkbox)* c, Color onColor, Color offColor) {
-    DrawRectangleRec(c->rect, c->value ? onColor : offColor);
+void RAYUI_WITH_PREFIX(MarkPanelDirty)(RAYUI_WITH_PREFIX(Panel)* p) {
+    p->dirty = true;
 }
 
-void RAYUI_WITH_PREFIX(DrawCheckboxColorsEx)(RAYUI_WITH_PREFIX(Checkbox)* c, Color onColor, Color offColor, int outline_width, Color outlineColor) {
-    DrawRectangleRec(c->rect, c->value ? onColor : offColor);
+unsigned int RAYUI_WITH_PREFIX(GetPanelRenderCount)(RAYUI_WITH_PREFIX(Panel)* p) {
+    return p->renderCount;
+}
 
-    if (outline_width > 0) {
-        DrawRectangleLinesEx(c->rect, (float)outline_width, outlineColor);
-    }
+unsigned int RAYUI_WITH_PREFIX(GetPanelReuseCount)(RAYUI_WITH_PREFIX(Panel)* p) {
+    return p->reuseCount;
 }
 
-void RAYUI_WITH_PREFIX(DrawCheckbox)(RAYUI_WITH_PREFIX(Checkbox)* c) {
-    Texture tex = c->value ? c->checkboxOnImage : c->checkboxOffImage;
+void RAYUI_WITH_PREFIX(FreePanelTexture)(RAYUI_WITH_PREFIX(Panel)* p) {
+    if (p->target.id) UnloadRenderTexture(p->target);
+    p->target = (RenderTexture2D){0};
+    p->dirty = true;
+}
 
-    Rectangle src = { 0, 0, (float)tex.width, (float)tex.height };
+// ---------------- INPUT ----------------
+// Widgets read input through these helpers. Once BeginFrame (or SetFrameInput)
+// has been called they only look at the snapshot, so an update is a function
+// of widget state and the snapshot alone. Without a snapshot they fall back to
+// querying raylib directly.
 
-    Rectangle dest = c->rect;
 
-    DrawTexturePro(tex, src, dest, (Vector2){0, 0}, 0.0f, RAYWHITE);
+static void _rayui_RecordFrame(const RAYUI_WITH_PREFIX(Input)* in);
+
+// Keys whose held state is captured each frame, other keys only report presses
+static const int _rayui_TrackedKeys[] = {
+    KEY_BACKSPACE, KEY_DELETE, KEY_ENTER, KEY_ESCAPE, KEY_TAB,
+    KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_HOME, KEY_END, KEY_PAGE_UP, KEY_PAGE_DOWN,
+    KEY_LEFT_SHIFT, KEY_RIGHT_SHIFT, KEY_LEFT_CONTROL, KEY_RIGHT_CONTROL,
+    KEY_LEFT_ALT, KEY_RIGHT_ALT, KEY_LEFT_SUPER, KEY_RIGHT_SUPER
+};
+
+static inline Vector2 _rayui_MousePosition(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? ctx->input.mouse : GetMousePosition();
 }
 
-bool RAYUI_WITH_PREFIX(GetCheckboxValue)(RAYUI_WITH_PREFIX(Checkbox)* c) {
-    return c->value;
+static inline bool _rayui_MousePressed(int button) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? (ctx->input.buttonsPressed >> button) & 1 : IsMouseButtonPressed(button);
 }
 
-void RAYUI_WITH_PREFIX(SetCheckboxValue)(RAYUI_WITH_PREFIX(Checkbox)* c, bool value) {
-    c->value = value;
+static inline bool _rayui_MouseDown(int button) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? (ctx->input.buttonsDown >> button) & 1 : IsMouseButtonDown(button);
 }
 
-void RAYUI_WITH_PREFIX(SetCheckboxTextures)(RAYUI_WITH_PREFIX(Checkbox)* c, Texture onTexture, Texture offTexture) {
-    c->checkboxOnImage = onTexture;
-    c->checkboxOffImage = offTexture;
+static inline bool _rayui_MouseReleased(int button) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? (ctx->input.buttonsReleased >> button) & 1 : IsMouseButtonReleased(button);
 }
 
-void RAYUI_WITH_PREFIX(FreeCheckboxTextures)(RAYUI_WITH_PREFIX(Checkbox)* c) {
-    UnloadTexture(c->checkboxOnImage);
-    UnloadTexture(c->checkboxOffImage);
+static inline float _rayui_MouseWheel(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? ctx->input.wheel : GetMouseWheelMove();
 }
 
-Texture RAYUI_WITH_PREFIX(GetCheckboxOnTexture)(void) {
-    if (defaultCheckboxOnTexture.id) return defaultCheckboxOnTexture;
+static inline double _rayui_Time(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? ctx->input.time : GetTime();
+}
 
-    int size = CHECKBOX_DEFAULT_TEXTURE_SIZE;
-    Image img = GenImageColor(size, size, RAYWHITE);
-    ImageDrawRectangleLines(&img, (Rectangle){0, 0, size, size}, 1, BLACK);
-    ImageDrawLine(&img, 8, 16, 14, 24, DARKGREEN);
-    ImageDrawLine(&img, 14, 24, 24, 8, DARKGREEN);
+static inline bool _rayui_KeyDown(int key) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->inputValid) return IsKeyDown(key);
+    if (key < 0 || key >= RAYUI_INPUT_KEY_BITS) return false;
+    return (ctx->input.keysDown[key >> 3] >> (key & 7)) & 1;
+}
 
-    TraceLog(LOG_INFO, "CHECKBOX: Generating default checkbox ON texture");
+static bool _rayui_KeyPressed(int key) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->inputValid) return IsKeyPressed(key);
+    for (int i = 0; i < ctx->input.keyCount; i++) {
+        if (ctx->input.keys[i] == key) return true;
+    }
+    return false;
+}
 
-    defaultCheckboxOnTexture = LoadTextureFromImage(img);
-    UnloadImage(img);
-    return defaultCheckboxOnTexture;
+// Pops from raylib's key/char queues without a snapshot, otherwise walks the
+// snapshot with a caller-owned cursor
+static inline int _rayui_NextKeyPressed(int* cursor) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->inputValid) return GetKeyPressed();
+    return *cursor < ctx->input.keyCount ? ctx->input.keys[(*cursor)++] : 0;
 }
 
-Texture RAYUI_WITH_PREFIX(GetCheckboxOffTexture)(void) {
-    if (defaultCheckboxOffTexture.id) return defaultCheckboxOffTexture;
+static inline int _rayui_NextCharPressed(int* cursor) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->inputValid) return GetCharPressed();
+    return *cursor < ctx->input.charCount ? ctx->input.chars[(*cursor)++] : 0;
+}
 
-    int size = CHECKBOX_DEFAULT_TEXTURE_SIZE;
-    Image img = GenImageColor(size, size, RAYWHITE);
-    ImageDrawRectangleLines(&img, (Rectangle){0, 0, size, size}, 1, BLACK);
-    ImageDrawLine(&img, 8, 8, 24, 24, MAROON);
-    ImageDrawLine(&img, 24, 8, 8, 24, MAROON);
+void RAYUI_WITH_PREFIX(BeginFrame)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(Input)* in = &ctx->input;
+    memset(in, 0, sizeof(*in));
+
+    in->mouse = GetMousePosition();
+    in->wheel = GetMouseWheelMove();
+    for (int b = 0; b <= MOUSE_BUTTON_BACK; b++) {
+        if (IsMouseButtonDown(b)) in->buttonsDown |= (unsigned char)(1 << b);
+        if (IsMouseButtonPressed(b)) in->buttonsPressed |= (unsigned char)(1 << b);
+        if (IsMouseButtonReleased(b)) in->buttonsReleased |= (unsigned char)(1 << b);
+    }
 
-    TraceLog(LOG_INFO, "CHECKBOX: Generating default checkbox OFF texture");
+    for (int i = 0; i < (int)(sizeof(_rayui_TrackedKeys) / sizeof(_rayui_TrackedKeys[0])); i++) {
+        int key = _rayui_TrackedKeys[i];
+        if (key < RAYUI_INPUT_KEY_BITS && IsKeyDown(key)) in->keysDown[key >> 3] |= (unsigned char)(1 << (key & 7));
+    }
 
-    defaultCheckboxOffTexture = LoadTextureFromImage(img);
-    UnloadImage(img);
-    return defaultCheckboxOffTexture;
-}
+    int key;
+    while ((key = GetKeyPressed()) > 0) {
+        if (in->keyCount < RAYUI_INPUT_MAX_KEYS) in->keys[in->keyCount++] = key;
+    }
+    int ch;
+    while ((ch = GetCharPressed()) > 0) {
+        if (in->charCount < RAYUI_INPUT_MAX_CHARS) in->chars[in->charCount++] = ch;
+    }
 
-// ---------------- SLIDER ----------------
+    in->time = GetTime();
+    in->frameTime = GetFrameTime();
+    ctx->inputValid = true;
+    _rayui_ResetFrameArena();
 
-RAYUI_WITH_PREFIX(Slider) RAYUI_WITH_PREFIX(CreateSlider)(int x, int y, int width, int minVal, int maxVal, float initial) {
-    RAYUI_WITH_PREFIX(Slider) s;
-    s.bar = (Rectangle){x, y, width, 5};
-    s.value = initial;
-    s.minVal = minVal;
-    s.maxVal = maxVal;
-    s.dragging = false;
-    s.hover.hoverInfo = NULL;
-    s.hover.hoverStartTime = 0;
-    s.hover.hovered = false;
-    s.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    s.hover.active = false;
-    return s;
+#ifdef RAYUI_STATS
+    ctx->statsLast = ctx->statsCurrent;
+    memset(&ctx->statsCurrent, 0, sizeof(ctx->statsCurrent));
+    if (_rayui_KeyPressed(RAYUI_STATS_OVERLAY_KEY)) ctx->statsOverlay = !ctx->statsOverlay;
+#endif
+    if (ctx->recording) _rayui_RecordFrame(in);
 }
 
-void RAYUI_WITH_PREFIX(UpdateSlider)(RAYUI_WITH_PREFIX(Slider)* s, Vector2 mousePoint) {
-    float knobX = s->bar.x + s->value * s->bar.width;
-    Rectangle knob = {knobX - 8, s->bar.y - 5, 16, 15};
+void RAYUI_WITH_PREFIX(SetFrameInput)(const RAYUI_WITH_PREFIX(Input)* input) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!input) {
+        ctx->inputValid = false;
+        return;
+    }
+    ctx->input = *input;
+    if (ctx->input.keyCount > RAYUI_INPUT_MAX_KEYS) ctx->input.keyCount = RAYUI_INPUT_MAX_KEYS;
+    if (ctx->input.charCount > RAYUI_INPUT_MAX_CHARS) ctx->input.charCount = RAYUI_INPUT_MAX_CHARS;
+    ctx->inputValid = true;
+    _rayui_ResetFrameArena();
+    if (ctx->recording) _rayui_RecordFrame(&ctx->input);
+}
 
-    if (s->hover.active) {
-        s->hover.hovered = CheckCollisionPointRec(mousePoint, s->bar) || 
-                        CheckCollisionPointRec(mousePoint, knob);
+const RAYUI_WITH_PREFIX(Input)* RAYUI_WITH_PREFIX(GetFrameInput)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->inputValid ? &ctx->input : NULL;
+}
 
-        if (s->hover.hovered && s->hover.hoverStartTime == 0) s->hover.hoverStartTime = GetTime();
-        if (!s->hover.hovered) s->hover.hoverStartTime = 0;
+// ---------------- INPUT RECORDING ----------------
+// Log layout: "RUIR", version byte, frame count (u32 LE), then one record per
+// frame. A record starts with a flag byte saying which fields changed since the
+// previous frame, followed by the time and frame time in microseconds (varints,
+// time delta-coded) and only the changed fields. Integral mouse positions are
+// zigzag varint deltas, anything else is stored as raw float bits so replays
+// reproduce the recorded values exactly.
+
+#define _RAYUI_REC_VERSION 1
+#define _RAYUI_REC_HEADER 9
+
+enum {
+    _RAYUI_REC_MOUSE     = 1 << 0,
+    _RAYUI_REC_MOUSE_RAW = 1 << 1,
+    _RAYUI_REC_BUTTONS   = 1 << 2,
+    _RAYUI_REC_WHEEL     = 1 << 3,
+    _RAYUI_REC_KEYS      = 1 << 4,
+    _RAYUI_REC_CHARS     = 1 << 5,
+    _RAYUI_REC_KEYS_DOWN = 1 << 6
+};
+
+
+static void _rayui_RecPut(const void* bytes, int count) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->recFailed) return;
+    if (ctx->recSize + count > ctx->recCapacity) {
+        int capacity = ctx->recCapacity ? ctx->recCapacity : 4096;
+        while (capacity < ctx->recSize + count) capacity *= 2;
+        unsigned char* data = (unsigned char*)RAYUI_REALLOC(ctx->recData, capacity);
+        if (!data) { ctx->recFailed = true; return; }
+        ctx->recData = data;
+        ctx->recCapacity = capacity;
     }
+    memcpy(ctx->recData + ctx->recSize, bytes, count);
+    ctx->recSize += count;
+}
 
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePoint, knob))
-        s->dragging = true;
+static void _rayui_RecPutVarint(unsigned long long v) {
+    unsigned char buf[10];
+    int n = 0;
+    do {
+        unsigned char b = v & 0x7F;
+        v >>= 7;
+        buf[n++] = b | (v ? 0x80 : 0);
+    } while (v);
+    _rayui_RecPut(buf, n);
+}
 
-    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
-        s->dragging = false;
+static inline unsigned long long _rayui_ZigZag(long long v) {
+    return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63);
+}
 
-    if (s->dragging) {
-        float ratio = (mousePoint.x - s->bar.x) / s->bar.width;
-        if (ratio < 0) ratio = 0;
-        if (ratio > 1) ratio = 1;
-        s->value = ratio;
-    }
+static inline long long _rayui_UnZigZag(unsigned long long v) {
+    return (long long)(v >> 1) ^ -(long long)(v & 1);
 }
 
-int RAYUI_WITH_PREFIX(SliderValue)(RAYUI_WITH_PREFIX(Slider)* s) {
-    return (int)(s->minVal + s->value * (s->maxVal - s->minVal));
+static void _rayui_RecPutFloat(float f) {
+    unsigned int bits;
+    memcpy(&bits, &f, sizeof(bits));
+    unsigned char b[4] = {bits & 0xFF, (bits >> 8) & 0xFF, (bits >> 16) & 0xFF, bits >> 24};
+    _rayui_RecPut(b, 4);
 }
 
-void RAYUI_WITH_PREFIX(DrawSlider)(RAYUI_WITH_PREFIX(Slider)* s, Color color, Color knobColor) {
-    DrawRectangleRec(s->bar, color);
-    float knobX = s->bar.x + s->value * s->bar.width;
-    DrawRectangle(knobX - 8, s->bar.y - 5, 16, 15, knobColor);
+static inline bool _rayui_IsIntegral(float f) {
+    return f == floorf(f) && fabsf(f) < 1e9f;
 }
 
-// ---------------- OPTION SLIDER ----------------
+static void _rayui_RecordFrame(const RAYUI_WITH_PREFIX(Input)* in) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    const RAYUI_WITH_PREFIX(Input)* prev = &ctx->recPrev;
+    unsigned char flags = 0;
 
-RAYUI_WITH_PREFIX(OptionSlider) RAYUI_WITH_PREFIX(CreateOptionSlider)(int x, int y, int width, const char** options, int optionCount, int initialIndex) {
-    RAYUI_WITH_PREFIX(OptionSlider) s;
-    s.bar = (Rectangle){x, y, width, 5};
-    s.options = options;
-    s.optionCount = optionCount;
-    s.selectedIndex = initialIndex;
-    s.dragging = false;
-    s.hover.hoverInfo = NULL;
-    s.hover.hoverStartTime = 0;
-    s.hover.hovered = false;
-    s.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    s.hover.active = false;
-    return s;
+    if (in->mouse.x != prev->mouse.x || in->mouse.y != prev->mouse.y) {
+        flags |= _RAYUI_REC_MOUSE;
+        if (!_rayui_IsIntegral(in->mouse.x) || !_rayui_IsIntegral(in->mouse.y) ||
+            !_rayui_IsIntegral(prev->mouse.x) || !_rayui_IsIntegral(prev->mouse.y))
+            flags |= _RAYUI_REC_MOUSE_RAW;
+    }
+    if (in->buttonsDown != prev->buttonsDown || in->buttonsPressed != prev->buttonsPressed ||
+        in->buttonsReleased != prev->buttonsReleased)
+        flags |= _RAYUI_REC_BUTTONS;
+    if (in->wheel != 0) flags |= _RAYUI_REC_WHEEL;
+    if (in->keyCount > 0) flags |= _RAYUI_REC_KEYS;
+    if (in->charCount > 0) flags |= _RAYUI_REC_CHARS;
+    if (memcmp(in->keysDown, prev->keysDown, sizeof(in->keysDown)) != 0) flags |= _RAYUI_REC_KEYS_DOWN;
+
+    _rayui_RecPut(&flags, 1);
+
+    long long time = llround(in->time * 1e6);
+    _rayui_RecPutVarint(_rayui_ZigZag(time - ctx->recPrevTime));
+    _rayui_RecPutVarint((unsigned long long)llround(fmax(in->frameTime, 0) * 1e6));
+    ctx->recPrevTime = time;
+
+    if (flags & _RAYUI_REC_MOUSE) {
+        if (flags & _RAYUI_REC_MOUSE_RAW) {
+            _rayui_RecPutFloat(in->mouse.x);
+            _rayui_RecPutFloat(in->mouse.y);
+        } else {
+            _rayui_RecPutVarint(_rayui_ZigZag((long long)in->mouse.x - (long long)prev->mouse.x));
+            _rayui_RecPutVarint(_rayui_ZigZag((long long)in->mouse.y - (long long)prev->mouse.y));
+        }
+    }
+    if (flags & _RAYUI_REC_BUTTONS) {
+        unsigned char b[3] = {in->buttonsDown, in->buttonsPressed, in->buttonsReleased};
+        _rayui_RecPut(b, 3);
+    }
+    if (flags & _RAYUI_REC_WHEEL) _rayui_RecPutFloat(in->wheel);
+    if (flags & _RAYUI_REC_KEYS) {
+        _rayui_RecPutVarint(in->keyCount);
+        for (int i = 0; i < in->keyCount; i++) _rayui_RecPutVarint(in->keys[i]);
+    }
+    if (flags & _RAYUI_REC_CHARS) {
+        _rayui_RecPutVarint(in->charCount);
+        for (int i = 0; i < in->charCount; i++) _rayui_RecPutVarint(in->chars[i]);
+    }
+    if (flags & _RAYUI_REC_KEYS_DOWN) {
+        // Held keys as a list of set bits, usually zero to two entries
+        int count = 0;
+        for (int k = 0; k < RAYUI_INPUT_KEY_BITS; k++) count += (in->keysDown[k >> 3] >> (k & 7)) & 1;
+        _rayui_RecPutVarint(count);
+        for (int k = 0; k < RAYUI_INPUT_KEY_BITS; k++)
+            if ((in->keysDown[k >> 3] >> (k & 7)) & 1) _rayui_RecPutVarint(k);
+    }
+
+    ctx->recPrev = *in;
+    ctx->recFrames++;
 }
 
-void RAYUI_WITH_PREFIX(UpdateOptionSlider)(RAYUI_WITH_PREFIX(OptionSlider)* s, Vector2 mousePoint) {
-    float knobX = s->bar.x + ((float)s->selectedIndex / (s->optionCount - 1)) * s->bar.width;
-    Rectangle knob = {knobX - 8, s->bar.y - 5, 16, 15};
+void RAYUI_WITH_PREFIX(StartInputRecording)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->recSize = 0;
+    ctx->recFrames = 0;
+    ctx->recFailed = false;
+    ctx->recPrevTime = 0;
+    memset(&ctx->recPrev, 0, sizeof(ctx->recPrev));
+    ctx->recording = true;
+}
 
-    if (s->hover.active) {
-        s->hover.hovered = CheckCollisionPointRec(mousePoint, s->bar) || 
-                        CheckCollisionPointRec(mousePoint, knob);
+void RAYUI_WITH_PREFIX(StopInputRecording)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->recording = false;
+}
 
-        if (s->hover.hovered && s->hover.hoverStartTime == 0) s->hover.hoverStartTime = GetTime();
-        if (!s->hover.hovered) s->hover.hoverStartTime = 0;
+bool RAYUI_WITH_PREFIX(IsInputRecording)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->recording;
+}
+
+int RAYUI_WITH_PREFIX(GetInputRecordingFrames)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->recFrames;
+}
+
+bool RAYUI_WITH_PREFIX(SaveInputRecording)(const char* fileName) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->recFailed || !fileName) return false;
+
+    FILE* f = fopen(fileName, "wb");
+    if (!f) return false;
+
+    unsigned int frames = (unsigned int)ctx->recFrames;
+    unsigned char header[_RAYUI_REC_HEADER] = {
+        'R', 'U', 'I', 'R', _RAYUI_REC_VERSION,
+        frames & 0xFF, (frames >> 8) & 0xFF, (frames >> 16) & 0xFF, frames >> 24
+    };
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+    if (ok && ctx->recSize > 0) ok = fwrite(ctx->recData, 1, ctx->recSize, f) == (size_t)ctx->recSize;
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+void RAYUI_WITH_PREFIX(FreeInputRecording)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->recording = false;
+    RAYUI_FREE(ctx->recData);
+    ctx->recData = NULL;
+    ctx->recSize = ctx->recCapacity = 0;
+    ctx->recFrames = 0;
+}
+
+// ---------------- INPUT REPLAY ----------------
+
+static bool _rayui_ReplayVarint(RAYUI_WITH_PREFIX(InputReplay)* r, unsigned long long* out) {
+    unsigned long long v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (r->offset >= r->size) return false;
+        unsigned char b = r->data[r->offset++];
+        v |= (unsigned long long)(b & 0x7F) << shift;
+        if (!(b & 0x80)) { *out = v; return true; }
     }
+    return false;
+}
 
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePoint, knob))
-        s->dragging = true;
+static bool _rayui_ReplayFloat(RAYUI_WITH_PREFIX(InputReplay)* r, float* out) {
+    if (r->offset + 4 > r->size) return false;
+    const unsigned char* b = r->data + r->offset;
+    unsigned int bits = b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+    memcpy(out, &bits, sizeof(*out));
+    r->offset += 4;
+    return true;
+}
 
-    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
-        s->dragging = false;
+static bool _rayui_ReplayList(RAYUI_WITH_PREFIX(InputReplay)* r, int* items, int* count, int max) {
+    unsigned long long n, v;
+    if (!_rayui_ReplayVarint(r, &n)) return false;
+    *count = 0;
+    for (unsigned long long i = 0; i < n; i++) {
+        if (!_rayui_ReplayVarint(r, &v)) return false;
+        if (*count < max) items[(*count)++] = (int)v;
+    }
+    return true;
+}
 
-    if (s->dragging) {
-        float ratio = (mousePoint.x - s->bar.x) / s->bar.width;
-        if (ratio < 0) ratio = 0;
-        if (ratio > 1) ratio = 1;
-        s->selectedIndex = (int)(ratio * (s->optionCount - 1) + 0.5f);
+RAYUI_WITH_PREFIX(InputReplay) RAYUI_WITH_PREFIX(LoadInputReplay)(const char* fileName) {
+    RAYUI_WITH_PREFIX(InputReplay) r;
+    memset(&r, 0, sizeof(r));
+
+    FILE* f = fileName ? fopen(fileName, "rb") : NULL;
+    if (!f) return r;
+
+    unsigned char header[_RAYUI_REC_HEADER];
+    long size = -1;
+    if (fread(header, 1, sizeof(header), f) == sizeof(header) &&
+        memcmp(header, "RUIR", 4) == 0 && header[4] == _RAYUI_REC_VERSION &&
+        fseek(f, 0, SEEK_END) == 0) {
+        size = ftell(f) - _RAYUI_REC_HEADER;
+    }
+    if (size >= 0 && size <= 0x7FFFFFFF && fseek(f, _RAYUI_REC_HEADER, SEEK_SET) == 0) {
+        r.data = (unsigned char*)RAYUI_MALLOC(size > 0 ? size : 1);
+        if (r.data && fread(r.data, 1, size, f) == (size_t)size) {
+            r.size = (int)size;
+            r.frameCount = header[5] | (header[6] << 8) | (header[7] << 16) | ((int)header[8] << 24);
+        } else {
+            RAYUI_FREE(r.data);
+            r.data = NULL;
+        }
     }
+    fclose(f);
+    return r;
 }
 
-const char* RAYUI_WITH_PREFIX(OptionSliderValue)(RAYUI_WITH_PREFIX(OptionSlider)* s) {
-    if (s->selectedIndex < 0 || s->selectedIndex >= s->optionCount) return s->options[0];
-    return s->options[s->selectedIndex];
+bool RAYUI_WITH_PREFIX(ReplayInputFrame)(RAYUI_WITH_PREFIX(InputReplay)* r) {
+    if (!r->data || r->offset >= r->size) return false;
+
+    RAYUI_WITH_PREFIX(Input)* in = &r->input;
+    unsigned char flags = r->data[r->offset++];
+    unsigned long long v, w;
+
+    // Per-frame fields reset, sticky fields carry over from the previous frame
+    in->wheel = 0;
+    in->keyCount = 0;
+    in->charCount = 0;
+
+    if (!_rayui_ReplayVarint(r, &v) || !_rayui_ReplayVarint(r, &w)) goto corrupt;
+    r->time += _rayui_UnZigZag(v);
+    in->time = r->time / 1e6;
+    in->frameTime = (float)(w / 1e6);
+
+    if (flags & _RAYUI_REC_MOUSE) {
+        if (flags & _RAYUI_REC_MOUSE_RAW) {
+            if (!_rayui_ReplayFloat(r, &in->mouse.x) || !_rayui_ReplayFloat(r, &in->mouse.y)) goto corrupt;
+        } else {
+            if (!_rayui_ReplayVarint(r, &v) || !_rayui_ReplayVarint(r, &w)) goto corrupt;
+            in->mouse.x = (float)((long long)in->mouse.x + _rayui_UnZigZag(v));
+            in->mouse.y = (float)((long long)in->mouse.y + _rayui_UnZigZag(w));
+        }
+    }
+    if (flags & _RAYUI_REC_BUTTONS) {
+        if (r->offset + 3 > r->size) goto corrupt;
+        in->buttonsDown = r->data[r->offset++];
+        in->buttonsPressed = r->data[r->offset++];
+        in->buttonsReleased = r->data[r->offset++];
+    }
+    if ((flags & _RAYUI_REC_WHEEL) && !_rayui_ReplayFloat(r, &in->wheel)) goto corrupt;
+    if ((flags & _RAYUI_REC_KEYS) && !_rayui_ReplayList(r, in->keys, &in->keyCount, RAYUI_INPUT_MAX_KEYS)) goto corrupt;
+    if ((flags & _RAYUI_REC_CHARS) && !_rayui_ReplayList(r, in->chars, &in->charCount, RAYUI_INPUT_MAX_CHARS)) goto corrupt;
+    if (flags & _RAYUI_REC_KEYS_DOWN) {
+        if (!_rayui_ReplayVarint(r, &v)) goto corrupt;
+        memset(in->keysDown, 0, sizeof(in->keysDown));
+        for (unsigned long long i = 0; i < v; i++) {
+            if (!_rayui_ReplayVarint(r, &w)) goto corrupt;
+            if (w < RAYUI_INPUT_KEY_BITS) in->keysDown[w >> 3] |= (unsigned char)(1 << (w & 7));
+        }
+    }
+
+    r->frame++;
+    RAYUI_WITH_PREFIX(SetFrameInput)(in);
+    return true;
+
+corrupt:
+    r->offset = r->size;
+    return false;
 }
 
-void RAYUI_WITH_PREFIX(DrawOptionSlider)(RAYUI_WITH_PREFIX(OptionSlider)* s, Color color, Color knobColor) {
-    DrawRectangleRec(s->bar, color);
-    float knobX = s->bar.x + ((float)s->selectedIndex / (s->optionCount - 1)) * s->bar.width;
-    DrawRectangle(knobX - 8, s->bar.y - 5, 16, 15, knobColor);
+void RAYUI_WITH_PREFIX(RewindInputReplay)(RAYUI_WITH_PREFIX(InputReplay)* r) {
+    r->offset = 0;
+    r->frame = 0;
+    r->time = 0;
+    memset(&r->input, 0, sizeof(r->input));
 }
 
-// ---------------- KEYBIND INPUT ----------------
+void RAYUI_WITH_PREFIX(FreeInputReplay)(RAYUI_WITH_PREFIX(InputReplay)* r) {
+    RAYUI_FREE(r->data);
+    memset(r, 0, sizeof(*r));
+}
 
-RAYUI_WITH_PREFIX(KeybindInput) RAYUI_WITH_PREFIX(CreateKeybindInput)(float x, float y, float width, float height, int initialKey, Sound hoverSound, Sound clickSound) {
-    RAYUI_WITH_PREFIX(KeybindInput) k;
-    k.rect = (Rectangle){x, y, width, height};
-    k.key = initialKey;
-    k.listening = false;
-    k.hovered = false;
-    k.hoverSound = hoverSound;
-    k.clickSound = clickSound;
-    k.hover.hoverInfo = NULL;
-    k.hover.hoverStartTime = 0;
-    k.hover.hovered = false;
-    k.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    k.hover.active = false;
-    return k;
+// ---------------- HOVER REGISTRY ----------------
+// Enabled hoverables live in a dense array that DrawHoverables walks. Widgets
+// only keep a handle (slot index + generation), so copies of a widget struct
+// share one entry and the registry never points into widget memory.
+// Update functions push their hover state through the handle in O(1).
+
+#define _RAYUI_HOVER_SLOT_BITS 20
+#define _RAYUI_HOVER_SLOT_MASK ((1u << _RAYUI_HOVER_SLOT_BITS) - 1)
+
+typedef struct _rayui_HoverEntry {
+    const char* info;
+    double startTime; // tooltip timer, separate from the widget's own hover timing
+    Vector2 lastMousePos;
+    float delay;
+    bool hovered;
+    bool drawAtTop;
+    int slot;
+} _rayui_HoverEntry;
+
+typedef struct _rayui_HoverSlot {
+    int dense; // index into the dense array, -1 while disabled
+    unsigned int generation;
+    bool used;
+} _rayui_HoverSlot;
+
+
+static _rayui_HoverSlot* _rayui_HoverSlotFromHandle(unsigned int handle) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (handle == 0) return NULL;
+    int slot = (int)(handle & _RAYUI_HOVER_SLOT_MASK) - 1;
+    if (slot < 0 || slot >= ctx->hoverSlotCount) return NULL;
+    _rayui_HoverSlot* s = &ctx->hoverSlots[slot];
+    if (!s->used || s->generation != (handle >> _RAYUI_HOVER_SLOT_BITS)) return NULL;
+    return s;
 }
 
-bool RAYUI_WITH_PREFIX(UpdateKeybindInput)(RAYUI_WITH_PREFIX(KeybindInput)* k, Vector2 mousePoint) {
-    k->hovered = CheckCollisionPointRec(mousePoint, k->rect);
-    k->hover.hovered = k->hovered;
+static unsigned int _rayui_HoverAllocHandle(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    int slot;
+    if (ctx->hoverFreeCount > 0) {
+        slot = ctx->hoverFreeSlots[--ctx->hoverFreeCount];
+    } else {
+        if ((unsigned int)ctx->hoverSlotCount >= _RAYUI_HOVER_SLOT_MASK) return 0;
+        if (ctx->hoverSlotCount == ctx->hoverSlotCapacity) {
+            int capacity = ctx->hoverSlotCapacity ? ctx->hoverSlotCapacity * 2 : 64;
+            _rayui_HoverSlot* slots = (_rayui_HoverSlot*)RAYUI_REALLOC(ctx->hoverSlots, capacity * sizeof(_rayui_HoverSlot));
+            if (!slots) return 0;
+            int* freeSlots = (int*)RAYUI_REALLOC(ctx->hoverFreeSlots, capacity * sizeof(int));
+            if (!freeSlots) { ctx->hoverSlots = slots; return 0; }
+            ctx->hoverSlots = slots;
+            ctx->hoverFreeSlots = freeSlots;
+            ctx->hoverSlotCapacity = capacity;
+        }
+        slot = ctx->hoverSlotCount++;
+        ctx->hoverSlots[slot].generation = 0;
+    }
+    _rayui_HoverSlot* s = &ctx->hoverSlots[slot];
+    s->generation = (s->generation + 1) & (0xFFFFFFFFu >> _RAYUI_HOVER_SLOT_BITS);
+    s->dense = -1;
+    s->used = true;
+    return (s->generation << _RAYUI_HOVER_SLOT_BITS) | (unsigned int)(slot + 1);
+}
 
-    if (k->hover.hovered && k->hover.hoverStartTime == 0 && k->hover.active) {
-        k->hover.hoverStartTime = GetTime();
-        if (k->hoverSound.frameCount > 0) PlaySound(k->hoverSound);
+static void _rayui_HoverLink(_rayui_HoverSlot* s, RAYUI_WITH_PREFIX(Hoverable)* h) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (s->dense < 0) {
+        if (ctx->hoverCount == ctx->hoverCapacity) {
+            int capacity = ctx->hoverCapacity ? ctx->hoverCapacity * 2 : 64;
+            _rayui_HoverEntry* entries = (_rayui_HoverEntry*)RAYUI_REALLOC(ctx->hoverEntries, capacity * sizeof(_rayui_HoverEntry));
+            if (!entries) return;
+            ctx->hoverEntries = entries;
+            ctx->hoverCapacity = capacity;
+        }
+        s->dense = ctx->hoverCount++;
+        ctx->hoverEntries[s->dense].slot = (int)(s - ctx->hoverSlots);
+        ctx->hoverEntries[s->dense].startTime = 0;
+        ctx->hoverEntries[s->dense].lastMousePos = (Vector2){-1, -1};
+        ctx->hoverEntries[s->dense].hovered = false;
     }
+    _rayui_HoverEntry* e = &ctx->hoverEntries[s->dense];
+    e->info = h->hoverInfo;
+    e->delay = h->delay;
+    if (e->hovered != h->hovered) ctx->hoverHoveredCount += h->hovered ? 1 : -1;
+    e->hovered = h->hovered;
+    e->drawAtTop = h->drawAtTop;
+}
 
-    if (!k->hover.hovered)
-        k->hover.hoverStartTime = 0;
+static void _rayui_HoverUnlink(_rayui_HoverSlot* s) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (s->dense < 0) return;
+    if (ctx->hoverEntries[s->dense].hovered) ctx->hoverHoveredCount--;
+    int last = ctx->hoverCount - 1;
+    if (s->dense != last) {
+        ctx->hoverEntries[s->dense] = ctx->hoverEntries[last];
+        ctx->hoverSlots[ctx->hoverEntries[s->dense].slot].dense = s->dense;
+    }
+    ctx->hoverCount--;
+    s->dense = -1;
+}
 
-    if (k->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (k->clickSound.frameCount > 0 && k->hover.active) PlaySound(k->clickSound);
-        k->listening = true;
-        return false;
+static void _rayui_SetHovered(unsigned int handle, bool hovered) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_HoverSlot* s = _rayui_HoverSlotFromHandle(handle);
+    if (!s || s->dense < 0) return;
+    _rayui_HoverEntry* e = &ctx->hoverEntries[s->dense];
+    if (e->hovered == hovered) return;
+    e->hovered = hovered;
+    if (hovered) {
+        ctx->hoverHoveredCount++;
+    } else {
+        ctx->hoverHoveredCount--;
+        e->startTime = 0;
     }
+}
 
-    if (k->listening) {
-        int pressed = GetKeyPressed();
-        if (pressed != 0) {
-            k->key = pressed;
-            k->listening = false;
-            return true;
+static inline void _rayui_SyncHover(RAYUI_WITH_PREFIX(Hoverable)* h) {
+    if (h->handle == 0) return;
+    // Always queued on update workers, copies of a widget share one entry
+    if (_rayui_CurrentWorker) _rayui_QueueEffect((Sound){0}, h->handle, h->hovered);
+    else _rayui_SetHovered(h->handle, h->hovered);
+}
+
+void RAYUI_WITH_PREFIX(SetHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h, const char* info, bool drawAtTop) {
+    h->hoverInfo = info;
+    h->drawAtTop = drawAtTop;
+    h->lastMousePos = (Vector2){-1, -1};
+    h->active = true;
+
+    // Registering twice just refreshes the existing entry
+    _rayui_HoverSlot* s = _rayui_HoverSlotFromHandle(h->handle);
+    if (!s) {
+        h->handle = _rayui_HoverAllocHandle();
+        s = _rayui_HoverSlotFromHandle(h->handle);
+        if (!s) return;
+    }
+    _rayui_HoverLink(s, h);
+}
+
+void RAYUI_WITH_PREFIX(DisableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h) {
+    h->active = false;
+    _rayui_HoverSlot* s = _rayui_HoverSlotFromHandle(h->handle);
+    if (s) _rayui_HoverUnlink(s);
+}
+
+void RAYUI_WITH_PREFIX(EnableHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h) {
+    h->active = true;
+    _rayui_HoverSlot* s = _rayui_HoverSlotFromHandle(h->handle);
+    if (!s) {
+        h->handle = _rayui_HoverAllocHandle();
+        s = _rayui_HoverSlotFromHandle(h->handle);
+        if (!s) return;
+    }
+    _rayui_HoverLink(s, h);
+}
+
+void RAYUI_WITH_PREFIX(RemoveHoverInfo)(RAYUI_WITH_PREFIX(Hoverable)* h) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    h->active = false;
+    _rayui_HoverSlot* s = _rayui_HoverSlotFromHandle(h->handle);
+    h->handle = 0;
+    if (!s) return;
+    _rayui_HoverUnlink(s);
+    s->used = false;
+    ctx->hoverFreeSlots[ctx->hoverFreeCount++] = (int)(s - ctx->hoverSlots);
+}
+
+int RAYUI_WITH_PREFIX(GetHoverInfoCount)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->hoverCount;
+}
+
+void RAYUI_WITH_PREFIX(FreeHoverInfo)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    // Invalidates every handle, widgets re-register with SetHoverInfo/EnableHoverInfo
+    RAYUI_FREE(ctx->hoverEntries);
+    RAYUI_FREE(ctx->hoverSlots);
+    RAYUI_FREE(ctx->hoverFreeSlots);
+    ctx->hoverEntries = NULL;
+    ctx->hoverSlots = NULL;
+    ctx->hoverFreeSlots = NULL;
+    ctx->hoverCount = ctx->hoverCapacity = 0;
+    ctx->hoverSlotCount = ctx->hoverSlotCapacity = 0;
+    ctx->hoverFreeCount = 0;
+    ctx->hoverHoveredCount = 0;
+}
+
+static void _rayui_DrawHoverables(Font font, int fontSize) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->hoverHoveredCount == 0) return;
+
+    Vector2 mousePoint = _rayui_MousePosition();
+    bool buttonDown = _rayui_MouseDown(MOUSE_LEFT_BUTTON) || _rayui_MouseDown(MOUSE_RIGHT_BUTTON);
+    double now = _rayui_Time();
+
+    for (int i = 0; i < ctx->hoverCount; i++) {
+        _rayui_HoverEntry* h = &ctx->hoverEntries[i];
+        if (!h->info) continue;
+
+        if (h->startTime > 0 &&
+            (h->lastMousePos.x != mousePoint.x || h->lastMousePos.y != mousePoint.y || buttonDown)) {
+            h->startTime = 0;
         }
-        if (IsKeyPressed(KEY_ESCAPE) || IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
-            k->listening = false;
+
+        if (h->hovered && h->startTime == 0) {
+            h->startTime = now;
+        }
+
+        h->lastMousePos = mousePoint;
+
+        double t = now - h->startTime;
+        if (h->hovered && t >= h->delay) {
+            Vector2 infoSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, h->info, fontSize, 1);
+            float boxX = h->drawAtTop ? 10 : mousePoint.x + 16;
+            float boxY = h->drawAtTop ? 10 : mousePoint.y + 16;
+
+            _rayui_DrawRectangleRec((Rectangle){(int)boxX, (int)boxY, (int)infoSize.x + 10, (int)infoSize.y + 6}, BLACK);
+            _rayui_DrawTextEx(font, h->info, (Vector2){boxX + 5, boxY + 3}, fontSize, 1, RAYWHITE);
+
+            break;
         }
     }
+}
+
+void RAYUI_WITH_PREFIX(DrawHoverables)(Font font, int fontSize) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOOLTIPS);
+    _rayui_DrawHoverables(font, fontSize);
+    _RAYUI_STATS_END(WIDGET_TYPE_TOOLTIPS, true);
+}
+
+// ---------------- FRAME STATS OVERLAY ----------------
+
+static const char* _rayui_WidgetTypeNames[WIDGET_TYPE_COUNT] = {
+    "Button", "Toggle", "Checkbox", "Slider", "OptionSlider", "Keybind", "TextInput",
+    "ProgressBar", "Dropdown", "ColorPicker", "NumericInput", "TextArea", "HoverText", "Tooltips"
+};
+
+RAYUI_WITH_PREFIX(FrameStats) RAYUI_WITH_PREFIX(GetFrameStats)(void) {
+#ifdef RAYUI_STATS
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(FrameStats) stats = ctx->statsLast;
+    stats.hoverCount = ctx->hoverCount;
+    return stats;
+#else
+    RAYUI_WITH_PREFIX(FrameStats) stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+#endif
+}
 
+const char* RAYUI_WITH_PREFIX(GetWidgetTypeName)(RAYUI_WITH_PREFIX(WidgetType) type) {
+    return (type >= 0 && type < WIDGET_TYPE_COUNT) ? _rayui_WidgetTypeNames[type] : "Unknown";
+}
+
+void RAYUI_WITH_PREFIX(SetStatsOverlay)(bool enabled) {
+#ifdef RAYUI_STATS
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->statsOverlay = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+bool RAYUI_WITH_PREFIX(IsStatsOverlayEnabled)(void) {
+#ifdef RAYUI_STATS
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->statsOverlay;
+#else
     return false;
+#endif
 }
 
-void RAYUI_WITH_PREFIX(DrawKeybindInput)(RAYUI_WITH_PREFIX(KeybindInput)* k, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor) {
-    Color bg = bgColor;
-    Color textColorI = (k->hovered || k->listening) ? textHoverColor : textColor;
-    DrawRectangleRec(k->rect, bg);
+void RAYUI_WITH_PREFIX(DrawStatsOverlay)(Font font, int fontSize) {
+#ifdef RAYUI_STATS
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->statsOverlay) return;
+
+    // Lines change every frame, so they are measured directly instead of
+    // through the text cache, and none of this is counted
+    ctx->statsPaused = true;
+
+    RAYUI_WITH_PREFIX(FrameStats) s = RAYUI_WITH_PREFIX(GetFrameStats)();
+    RAYUI_WITH_PREFIX(FrameArenaStats) arena = RAYUI_WITH_PREFIX(GetFrameArenaStats)();
+    const char* lines[WIDGET_TYPE_COUNT + 3];
+    int count = 0;
+
+    lines[count++] = _rayui_FrameFormat("RayUI  update %.3fms  draw %.3fms",
+                                        s.updateTime * 1000.0, s.drawTime * 1000.0);
+    lines[count++] = _rayui_FrameFormat("calls %u  measures %u  sounds %u  tooltips %d",
+                                        s.drawCalls, s.textMeasures, s.soundPlays, s.hoverCount);
+    lines[count++] = _rayui_FrameFormat("arena %d/%d B  peak %d B",
+                                        arena.used, arena.capacity, arena.highWater);
+    for (int i = 0; i < WIDGET_TYPE_COUNT; i++) {
+        const RAYUI_WITH_PREFIX(WidgetStats)* w = &s.widgets[i];
+        if (w->updates == 0 && w->draws == 0) continue;
+        lines[count++] = _rayui_FrameFormat("%-12s u %-5u d %-5u c %-6u %.3fms",
+                                            _rayui_WidgetTypeNames[i], w->updates, w->draws, w->drawCalls,
+                                            (w->updateTime + w->drawTime) * 1000.0);
+    }
 
-    static char buffer[32];
-    const char* text;
-    if (k->listening) {
-        snprintf(buffer, sizeof(buffer), "| %s |", GetKeyName(k->key));
-        text = buffer;
+    float width = 0;
+    for (int i = 0; i < count; i++) {
+        if (!lines[i]) lines[i] = "";
+        Vector2 size = MeasureTextEx(font, lines[i], fontSize, 1);
+        if (size.x > width) width = size.x;
+    }
+
+    float lineHeight = fontSize + 2;
+    _rayui_DrawRectangleRec((Rectangle){4, 4, width + 12, count * lineHeight + 8}, (Color){0, 0, 0, 190});
+    for (int i = 0; i < count; i++) {
+        _rayui_DrawTextEx(font, lines[i], (Vector2){10, 8 + i * lineHeight}, fontSize, 1, i < 3 ? YELLOW : RAYWHITE);
+    }
+
+    ctx->statsPaused = false;
+#else
+    (void)font;
+    (void)fontSize;
+#endif
+}
+
+// ---------------- HIT INDEX ----------------
+// Optional uniform grid of widget bounds. Widgets register lazily the first
+// time they are updated with the index enabled and re-bin themselves when their
+// bounds move. The cell under the cursor is re-queried only when the mouse
+// changes cells, so a still mouse costs one compare per widget instead of a
+// collision test. Cells are hashed into a fixed bucket table, a collision only
+// costs an extra range check. Bounds covering too many cells skip the grid and
+// are always tested.
+
+#define _RAYUI_HIT_MAX_CELLS 64
+
+typedef struct _rayui_HitEntry {
+    Rectangle bounds;
+    int x0, y0, x1, y1; // cell range, inclusive
+    unsigned int stamp; // equals the context's hitStamp while the cursor cell is inside the range
+    unsigned int generation;
+    bool used;
+    bool large;
+} _rayui_HitEntry;
+
+typedef struct _rayui_HitBucket {
+    int* ids;
+    int count;
+    int capacity;
+} _rayui_HitBucket;
+
+
+static inline int _rayui_HitCell(float v) {
+    return (int)floorf(v / RAYUI_HIT_CELL_SIZE);
+}
+
+static inline _rayui_HitBucket* _rayui_HitBucketAt(int cx, int cy) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    unsigned int h = (unsigned int)cx * 73856093u ^ (unsigned int)cy * 19349663u;
+    return &ctx->hitBuckets[h % RAYUI_HIT_BUCKETS];
+}
+
+static _rayui_HitEntry* _rayui_HitEntryFromHandle(unsigned int handle) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (handle == 0) return NULL;
+    int id = (int)(handle & _RAYUI_HOVER_SLOT_MASK) - 1;
+    if (id < 0 || id >= ctx->hitEntryCount) return NULL;
+    _rayui_HitEntry* e = &ctx->hitEntries[id];
+    if (!e->used || e->generation != (handle >> _RAYUI_HOVER_SLOT_BITS)) return NULL;
+    return e;
+}
+
+static inline bool _rayui_HitContainsCursor(const _rayui_HitEntry* e) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->hitCellX >= e->x0 && ctx->hitCellX <= e->x1 &&
+           ctx->hitCellY >= e->y0 && ctx->hitCellY <= e->y1;
+}
+
+static bool _rayui_HitBucketAdd(_rayui_HitBucket* b, int id) {
+    for (int i = 0; i < b->count; i++) if (b->ids[i] == id) return true;
+    if (b->count == b->capacity) {
+        int capacity = b->capacity ? b->capacity * 2 : 8;
+        int* ids = (int*)RAYUI_REALLOC(b->ids, capacity * sizeof(int));
+        if (!ids) return false;
+        b->ids = ids;
+        b->capacity = capacity;
+    }
+    b->ids[b->count++] = id;
+    return true;
+}
+
+static void _rayui_HitBucketRemove(_rayui_HitBucket* b, int id) {
+    for (int i = 0; i < b->count; i++) {
+        if (b->ids[i] == id) {
+            b->ids[i] = b->ids[--b->count];
+            return;
+        }
+    }
+}
+
+static void _rayui_HitUnbin(_rayui_HitEntry* e, int id) {
+    if (e->large) return;
+    for (int cy = e->y0; cy <= e->y1; cy++)
+        for (int cx = e->x0; cx <= e->x1; cx++)
+            _rayui_HitBucketRemove(_rayui_HitBucketAt(cx, cy), id);
+}
+
+static void _rayui_HitBin(_rayui_HitEntry* e, int id) {
+    e->large = (e->x1 - e->x0 + 1) * (e->y1 - e->y0 + 1) > _RAYUI_HIT_MAX_CELLS;
+    if (e->large) return;
+    for (int cy = e->y0; cy <= e->y1; cy++) {
+        for (int cx = e->x0; cx <= e->x1; cx++) {
+            if (!_rayui_HitBucketAdd(_rayui_HitBucketAt(cx, cy), id)) {
+                // Out of memory, fall back to always testing this widget
+                _rayui_HitUnbin(e, id);
+                e->large = true;
+                return;
+            }
+        }
+    }
+}
+
+static void _rayui_HitQuery(Vector2 mouse) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    int cx = _rayui_HitCell(mouse.x);
+    int cy = _rayui_HitCell(mouse.y);
+    if (cx == ctx->hitCellX && cy == ctx->hitCellY) return;
+
+    ctx->hitCellX = cx;
+    ctx->hitCellY = cy;
+    ctx->hitStamp++;
+    if (ctx->hitStamp == 0) {
+        for (int i = 0; i < ctx->hitEntryCount; i++) ctx->hitEntries[i].stamp = 0;
+        ctx->hitStamp = 1;
+    }
+
+    ctx->hitCandidates = 0;
+    _rayui_HitBucket* b = _rayui_HitBucketAt(cx, cy);
+    for (int i = 0; i < b->count; i++) {
+        _rayui_HitEntry* e = &ctx->hitEntries[b->ids[i]];
+        if (_rayui_HitContainsCursor(e)) {
+            e->stamp = ctx->hitStamp;
+            ctx->hitCandidates++;
+        }
+    }
+}
+
+static unsigned int _rayui_HitRegister(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->hitBuckets) {
+        ctx->hitBuckets = (_rayui_HitBucket*)RAYUI_CALLOC(RAYUI_HIT_BUCKETS, sizeof(_rayui_HitBucket));
+        if (!ctx->hitBuckets) return 0;
+    }
+    int id;
+    if (ctx->hitFreeCount > 0) {
+        id = ctx->hitFree[--ctx->hitFreeCount];
     } else {
-        text = GetKeyName(k->key);
+        if ((unsigned int)ctx->hitEntryCount >= _RAYUI_HOVER_SLOT_MASK) return 0;
+        if (ctx->hitEntryCount == ctx->hitEntryCapacity) {
+            int capacity = ctx->hitEntryCapacity ? ctx->hitEntryCapacity * 2 : 64;
+            _rayui_HitEntry* entries = (_rayui_HitEntry*)RAYUI_REALLOC(ctx->hitEntries, capacity * sizeof(_rayui_HitEntry));
+            if (!entries) return 0;
+            ctx->hitEntries = entries;
+            int* freeIds = (int*)RAYUI_REALLOC(ctx->hitFree, capacity * sizeof(int));
+            if (!freeIds) return 0;
+            ctx->hitFree = freeIds;
+            ctx->hitEntryCapacity = capacity;
+        }
+        id = ctx->hitEntryCount++;
+        ctx->hitEntries[id].generation = 0;
     }
+    _rayui_HitEntry* e = &ctx->hitEntries[id];
+    e->generation = (e->generation + 1) & (0xFFFFFFFFu >> _RAYUI_HOVER_SLOT_BITS);
+    e->used = true;
+    e->large = true; // not binned until the first bounds update
+    e->bounds = (Rectangle){0, 0, -1, -1};
+    e->stamp = 0;
+    ctx->hitLive++;
+    return (e->generation << _RAYUI_HOVER_SLOT_BITS) | (unsigned int)(id + 1);
+}
 
-    Vector2 textSize = MeasureTextEx(font, text, fontSize, 1);
-    Vector2 pos = { k->rect.x + (k->rect.width - textSize.x)/2,
-                    k->rect.y + (k->rect.height - textSize.y)/2 };
-    DrawTextEx(font, text, pos, fontSize, 1, textColorI);
+// Returns false when the widget can't be under the mouse and its collision
+// tests can be skipped. Always true while the index is disabled and on update
+// workers, which leave the index alone.
+static bool _rayui_HitTest(RAYUI_WITH_PREFIX(Hoverable)* h, Rectangle bounds, Vector2 mouse) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (!ctx->hitEnabled || _rayui_CurrentWorker) return true;
+
+    _rayui_HitEntry* e = _rayui_HitEntryFromHandle(h->hitHandle);
+    if (!e) {
+        h->hitHandle = _rayui_HitRegister();
+        e = _rayui_HitEntryFromHandle(h->hitHandle);
+        if (!e) return true;
+    }
+    int id = (int)(e - ctx->hitEntries);
+
+    _rayui_HitQuery(mouse);
+
+    if (e->bounds.x != bounds.x || e->bounds.y != bounds.y ||
+        e->bounds.width != bounds.width || e->bounds.height != bounds.height) {
+        int x0 = _rayui_HitCell(bounds.x), y0 = _rayui_HitCell(bounds.y);
+        int x1 = _rayui_HitCell(bounds.x + bounds.width), y1 = _rayui_HitCell(bounds.y + bounds.height);
+        bool wasBinned = e->bounds.width >= 0 && !e->large;
+        if (!wasBinned || x0 != e->x0 || y0 != e->y0 || x1 != e->x1 || y1 != e->y1) {
+            bool was = wasBinned && e->stamp == ctx->hitStamp;
+            if (wasBinned) _rayui_HitUnbin(e, id);
+            e->x0 = x0; e->y0 = y0; e->x1 = x1; e->y1 = y1;
+            _rayui_HitBin(e, id);
+            bool inside = !e->large && _rayui_HitContainsCursor(e);
+            if (inside != was) ctx->hitCandidates += inside ? 1 : -1;
+            e->stamp = inside ? ctx->hitStamp : 0;
+        }
+        e->bounds = bounds;
+    }
+
+    if (e->large || e->stamp == ctx->hitStamp) {
+        ctx->hitTests++;
+        return true;
+    }
+    ctx->hitSkipped++;
+    return false;
 }
 
-KeyboardKey RAYUI_WITH_PREFIX(GetKeybindValue)(RAYUI_WITH_PREFIX(KeybindInput)* k) {
-    return k->key;
+static inline Rectangle _rayui_RectUnion(Rectangle a, Rectangle b) {
+    float x0 = fminf(a.x, b.x), y0 = fminf(a.y, b.y);
+    float x1 = fmaxf(a.x + a.width, b.x + b.width), y1 = fmaxf(a.y + a.height, b.y + b.height);
+    return (Rectangle){x0, y0, x1 - x0, y1 - y0};
 }
 
-// ---------------- TEXT INPUT ----------------
+void RAYUI_WITH_PREFIX(SetHitIndex)(bool enabled) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    ctx->hitEnabled = enabled;
+}
 
-RAYUI_WITH_PREFIX(TextInput) RAYUI_WITH_PREFIX(CreateTextInput)(int x, int y, int width, int height, const char* initial, RAYUI_WITH_PREFIX(InputType) type) {
-    RAYUI_WITH_PREFIX(TextInput) t;
-    t.rect = (Rectangle){x, y, width, height};
-    t.focused = false;
-    t.cleared = false;
-    t.hovered = false;
-    t.hoverSound = _rayui_DefaultSound;
-    t.clickSound = _rayui_DefaultSound;
-    t.inputType = type;
-    t.hover.hoverInfo = NULL;
-    t.hover.hoverStartTime = 0;
-    t.hover.hovered = false;
-    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    t.hover.active = false;
-    t.backspaceTimer = 0;
-    t.backspacePressed = false;
-    t.backspaceHoldTime = 0;
-    strncpy(t.text, initial, sizeof(t.text));
-    t.text[sizeof(t.text)-1] = '\0';
-    return t;
+bool RAYUI_WITH_PREFIX(IsHitIndexEnabled)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    return ctx->hitEnabled;
 }
 
-RAYUI_WITH_PREFIX(TextInput) RAYUI_WITH_PREFIX(CreateTextInputWithSound)(int x, int y, int width, int height, const char* initial, RAYUI_WITH_PREFIX(InputType) type, Sound hoverSound, Sound clickSound) {
-    RAYUI_WITH_PREFIX(TextInput) t;
-    t.rect = (Rectangle){x, y, width, height};
-    t.focused = false;
-    t.cleared = false;
-    t.hovered = false;
-    t.hoverSound = hoverSound;
-    t.clickSound = clickSound;
-    t.inputType = type;
-    t.hover.hoverInfo = NULL;
-    t.hover.hoverStartTime = 0;
-    t.hover.hovered = false;
-    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    t.hover.active = false;
-    t.backspaceTimer = 0;
-    t.backspacePressed = false;
-    t.backspaceHoldTime = 0;
-    strncpy(t.text, initial, sizeof(t.text));
-    t.text[sizeof(t.text)-1] = '\0';
-    return t;
+void RAYUI_WITH_PREFIX(RemoveHitRect)(RAYUI_WITH_PREFIX(Hoverable)* h) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    _rayui_HitEntry* e = _rayui_HitEntryFromHandle(h->hitHandle);
+    h->hitHandle = 0;
+    if (!e) return;
+    int id = (int)(e - ctx->hitEntries);
+    if (e->bounds.width >= 0) _rayui_HitUnbin(e, id);
+    if (!e->large && e->stamp == ctx->hitStamp) ctx->hitCandidates--;
+    e->used = false;
+    ctx->hitFree[ctx->hitFreeCount++] = id;
+    ctx->hitLive--;
 }
 
-void RAYUI_WITH_PREFIX(UpdateTextInput)(RAYUI_WITH_PREFIX(TextInput)* t) {
-    RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)(t, GetMousePosition());
+RAYUI_WITH_PREFIX(HitIndexStats) RAYUI_WITH_PREFIX(GetHitIndexStats)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(HitIndexStats) stats;
+    stats.count = ctx->hitLive;
+    stats.candidates = ctx->hitCandidates;
+    stats.tests = ctx->hitTests;
+    stats.skipped = ctx->hitSkipped;
+    return stats;
+}
+
+void RAYUI_WITH_PREFIX(FreeHitIndex)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    // Invalidates every handle, widgets re-register on their next update
+    if (ctx->hitBuckets) {
+        for (int i = 0; i < RAYUI_HIT_BUCKETS; i++) RAYUI_FREE(ctx->hitBuckets[i].ids);
+    }
+    RAYUI_FREE(ctx->hitBuckets);
+    RAYUI_FREE(ctx->hitEntries);
+    RAYUI_FREE(ctx->hitFree);
+    ctx->hitBuckets = NULL;
+    ctx->hitEntries = NULL;
+    ctx->hitFree = NULL;
+    ctx->hitEntryCount = ctx->hitEntryCapacity = 0;
+    ctx->hitFreeCount = 0;
+    ctx->hitLive = 0;
+    ctx->hitCandidates = 0;
+    ctx->hitTests = ctx->hitSkipped = 0;
+    ctx->hitCellX = ctx->hitCellY = 0x7FFFFFFF;
 }
 
-void RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)(RAYUI_WITH_PREFIX(TextInput)* t, Vector2 mousePoint) {
-    t->hovered = CheckCollisionPointRec(mousePoint, t->rect);
-    t->hover.hovered = t->hovered;
+// ---------------- HOVER TEXT ----------------
+RAYUI_WITH_PREFIX(HoverText) RAYUI_WITH_PREFIX(CreateHoverText)(const char* text, Vector2 position, float delay) {
+    RAYUI_WITH_PREFIX(HoverText) ht;
+    ht.text = text;
+    ht.position = position;
+    ht.hover.hoverInfo = text;
+    ht.hover.hoverStartTime = 0;
+    ht.hover.hovered = false;
+    ht.hover.drawAtTop = true;
+    ht.hover.delay = delay;
+    ht.hover.active = false;
+    ht.hover.handle = 0;
+    ht.hover.hitHandle = 0;
+    ht.hover.lastMousePos = (Vector2){-1, -1};
+    return ht;
+}
+
+static void _rayui_DrawHoverText(Font font, int fontSize, RAYUI_WITH_PREFIX(HoverText)* hoverText) {
+    if (!hoverText || !hoverText->text) return;
+
+    _rayui_DrawTextEx(font, hoverText->text, hoverText->position, fontSize, 1, RAYWHITE);
+}
+
+void RAYUI_WITH_PREFIX(DrawHoverText)(Font font, int fontSize, RAYUI_WITH_PREFIX(HoverText)* hoverText) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_HOVER_TEXT);
+    _rayui_DrawHoverText(font, fontSize, hoverText);
+    _RAYUI_STATS_END(WIDGET_TYPE_HOVER_TEXT, true);
+}
+
+static void _rayui_UpdateHoverText(RAYUI_WITH_PREFIX(HoverText)* hoverText, Vector2 mousePoint) {
+    if (!hoverText) return;
+
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(GetFontDefault(), hoverText->text, 20, 1);
+    Rectangle rect = {hoverText->position.x, hoverText->position.y, textSize.x, textSize.y};
+
+    if (!hoverText->hover.active) return;
+    hoverText->hover.hovered = _rayui_HitTest(&hoverText->hover, rect, mousePoint) && CheckCollisionPointRec(mousePoint, rect);
+    _rayui_SyncHover(&hoverText->hover);
+}
+
+void RAYUI_WITH_PREFIX(UpdateHoverText)(RAYUI_WITH_PREFIX(HoverText)* hoverText, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_HOVER_TEXT);
+    _rayui_UpdateHoverText(hoverText, mousePoint);
+    _RAYUI_STATS_END(WIDGET_TYPE_HOVER_TEXT, false);
+}
+
+// ---------------- BUTTON ----------------
+
+RAYUI_WITH_PREFIX(Button) RAYUI_WITH_PREFIX(CreateButton)(float x, float y, float width, float height, const char* text) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(Button) b;
+    b.rect = (Rectangle){x, y, width, height};
+    b.text = text;
+    b.hovered = false;
+    b.hover.hoverInfo = NULL;
+    b.hover.hoverStartTime = 0;
+    b.hover.hovered = false;
+    b.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    b.hover.active = false;
+    b.hover.handle = 0;
+    b.hover.hitHandle = 0;
+    b.hoverSound = ctx->defaultSound;
+    b.clickSound = ctx->defaultSound;
+    return b;
+}
+
+RAYUI_WITH_PREFIX(Button) RAYUI_WITH_PREFIX(CreateButtonWithSound)(float x, float y, float width, float height, const char* text, Sound hoverSound, Sound clickSound) {
+    RAYUI_WITH_PREFIX(Button) b;
+    b.rect = (Rectangle){x, y, width, height};
+    b.text = text;
+    b.hovered = false;
+    b.hover.hoverInfo = NULL;
+    b.hover.hoverStartTime = 0;
+    b.hover.hovered = false;
+    b.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    b.hover.active = false;
+    b.hover.handle = 0;
+    b.hover.hitHandle = 0;
+    b.hoverSound = hoverSound;
+    b.clickSound = clickSound;
+    return b;
+}
+
+static bool _rayui_UpdateButton(RAYUI_WITH_PREFIX(Button)* b) {
+    Vector2 mousePoint = _rayui_MousePosition();
+    b->hovered = _rayui_HitTest(&b->hover, b->rect, mousePoint) && CheckCollisionPointRec(mousePoint, b->rect);
+    b->hover.hovered = b->hovered;
+    _rayui_SyncHover(&b->hover);
+
+    if (b->hover.hovered && b->hover.hoverStartTime == 0) {
+        b->hover.hoverStartTime = _rayui_Time();
+        if (b->hoverSound.frameCount > 0 && b->hover.active) _rayui_PlaySound(b->hoverSound);
+    }
+
+    if (!b->hover.hovered) {
+        b->hover.hoverStartTime = 0;
+    }
+
+    if (b->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (b->clickSound.frameCount > 0 && b->hover.active) _rayui_PlaySound(b->clickSound);
+        return true;
+    }
+
+    return false;
+}
+
+bool RAYUI_WITH_PREFIX(UpdateButton)(RAYUI_WITH_PREFIX(Button)* b) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    bool result = _rayui_UpdateButton(b);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, false);
+    return result;
+}
+
+static bool _rayui_UpdateButtonWithMousePoint(RAYUI_WITH_PREFIX(Button)* b, Vector2 mousePoint) {
+    b->hovered = _rayui_HitTest(&b->hover, b->rect, mousePoint) && CheckCollisionPointRec(mousePoint, b->rect);
+    b->hover.hovered = b->hovered;
+    _rayui_SyncHover(&b->hover);
+
+    if (b->hover.hovered && b->hover.hoverStartTime == 0) {
+        b->hover.hoverStartTime = _rayui_Time();
+        if (b->hoverSound.frameCount > 0 && b->hover.active) _rayui_PlaySound(b->hoverSound);
+    }
+
+    if (!b->hover.hovered) {
+        b->hover.hoverStartTime = 0;
+    }
+
+    if (b->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (b->clickSound.frameCount > 0 && b->hover.active) _rayui_PlaySound(b->clickSound);
+        return true;
+    }
+
+    return false;
+}
+
+bool RAYUI_WITH_PREFIX(UpdateButtonWithMousePoint)(RAYUI_WITH_PREFIX(Button)* b, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    bool result = _rayui_UpdateButtonWithMousePoint(b, mousePoint);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, false);
+    return result;
+}
+
+bool RAYUI_WITH_PREFIX(ButtonDown)(RAYUI_WITH_PREFIX(Button)* b) {
+    Vector2 mousePoint = _rayui_MousePosition();
+    b->hovered = _rayui_HitTest(&b->hover, b->rect, mousePoint) && CheckCollisionPointRec(mousePoint, b->rect);
+    return b->hovered && _rayui_MouseDown(MOUSE_LEFT_BUTTON);
+}
+
+void RAYUI_WITH_PREFIX(DrawButton)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize, Color color, Color hoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    Color col = b->hovered ? hoverColor : color;
+
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, b->text, fontSize, 2);
+    Vector2 pos = {
+        b->rect.x + b->rect.width/2 - textSize.x/2,
+        b->rect.y + b->rect.height/2 - textSize.y/2
+    };
+    _rayui_DrawTextEx(font, b->text, pos, fontSize, 2, col);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawButtonEx)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize,
+                                     Color color, Color hoverColor, int outline_width,
+                                     Color outlineColor, Color backgroundColor) 
+{
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    Color textCol = b->hovered ? hoverColor : color;
+
+    _rayui_DrawRectangleRounded(b->rect, 0.1f, 0, backgroundColor);
+
+    if (outline_width > 0) {
+        Rectangle borderRect = {b->rect.x - outline_width/2.0f, b->rect.y - outline_width/2.0f,
+                                b->rect.width + outline_width, b->rect.height + outline_width};
+        _rayui_DrawRectangleRoundedLines(borderRect, 0.1f, 0, outlineColor);
+    }
+
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, b->text, fontSize, 2);
+
+    Vector2 textPos = {
+        b->rect.x + b->rect.width/2 - textSize.x/2,
+        b->rect.y + b->rect.height/2 - textSize.y/2
+    };
+
+    if (RAYUI_WITH_PREFIX(ButtonDown)(b)) {
+        textPos.x += 2;
+        textPos.y += 2;
+    }
+
+    _rayui_DrawTextEx(font, b->text, textPos, fontSize, 2, textCol);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawButtonPro)(RAYUI_WITH_PREFIX(Button)* b, Font font, int fontSize,
+                                     Color color, Color hoverColor, int outline_width,
+                                     Color outlineColor, Color backgroundColor,
+                                     int textPressOffsetRight, int textPressOffsetDown,
+                                     Color shadowColor, bool shadowEnabled) 
+{
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    Color textCol = b->hovered ? hoverColor : color;
+
+    _rayui_DrawRectangleRounded(b->rect, 0.1f, 0, backgroundColor);
+
+    if (outline_width > 0) {
+        Rectangle borderRect = {b->rect.x - outline_width/2.0f, b->rect.y - outline_width/2.0f,
+                                b->rect.width + outline_width, b->rect.height + outline_width};
+        _rayui_DrawRectangleRoundedLines(borderRect, 0.1f, 0, outlineColor);
+    }
+
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, b->text, fontSize, 2);
+
+    Vector2 textPos = {
+        b->rect.x + b->rect.width/2 - textSize.x/2,
+        b->rect.y + b->rect.height/2 - textSize.y/2
+    };
+
+    if (RAYUI_WITH_PREFIX(ButtonDown)(b)) {
+        textPos.x += textPressOffsetRight;
+        textPos.y += textPressOffsetDown;
+    }
+
+    if (shadowEnabled) {
+        Vector2 shadowPos = { textPos.x + textPressOffsetRight, textPos.y + textPressOffsetDown };
+        _rayui_DrawTextEx(font, b->text, shadowPos, fontSize, 2, shadowColor);
+    }
+
+    _rayui_DrawTextEx(font, b->text, textPos, fontSize, 2, textCol);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, true);
+}
+
+
+// ---------------- TOGGLE ----------------
+
+RAYUI_WITH_PREFIX(ToggleLabel) RAYUI_WITH_PREFIX(CreateToggle)(float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(ToggleLabel) t;
+    t.rect = (Rectangle){x, y, width, height};
+    t.value = initial;
+    t.hovered = false;
+    t.hover.hoverInfo = NULL;
+    t.onLabel = onLabel;
+    t.offLabel = offLabel;
+    t.hover.hoverStartTime = 0;
+    t.hover.hovered = false;
+    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    t.hover.active = false;
+    t.hover.handle = 0;
+    t.hover.hitHandle = 0;
+    t.hoverSound = ctx->defaultSound;
+    t.clickSound = ctx->defaultSound;
+    return t;
+}
+
+RAYUI_WITH_PREFIX(ToggleLabel) RAYUI_WITH_PREFIX(CreateToggleWithSound)(float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel, Sound hoverSound, Sound clickSound) {
+    RAYUI_WITH_PREFIX(ToggleLabel) t;
+    t.rect = (Rectangle){x, y, width, height};
+    t.value = initial;
+    t.hovered = false;
+    t.hover.hoverInfo = NULL;
+    t.onLabel = onLabel;
+    t.offLabel = offLabel;
+    t.hover.hoverStartTime = 0;
+    t.hover.hovered = false;
+    t.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    t.hover.active = false;
+    t.hover.handle = 0;
+    t.hover.hitHandle = 0;
+    t.hoverSound = hoverSound;
+    t.clickSound = clickSound;
+    return t;
+}
+
+void RAYUI_WITH_PREFIX(UpdateToggleLabel)(RAYUI_WITH_PREFIX(ToggleLabel)* t, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOGGLE);
+    t->hovered = _rayui_HitTest(&t->hover, t->rect, mousePoint) && CheckCollisionPointRec(mousePoint, t->rect);
+    t->hover.hovered = t->hovered;
+    _rayui_SyncHover(&t->hover);
+
+    if (t->hover.hovered && t->hover.hoverStartTime == 0) {
+        t->hover.hoverStartTime = _rayui_Time();
+        if (t->hoverSound.frameCount > 0 && t->hover.active) _rayui_PlaySound(t->hoverSound);
+    }
+
+    if (!t->hover.hovered) {
+        t->hover.hoverStartTime = 0;
+    }
+
+    if (t->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (t->clickSound.frameCount > 0 && t->hover.active) _rayui_PlaySound(t->clickSound);
+        t->value = !t->value;
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_TOGGLE, false);
+}
+
+void RAYUI_WITH_PREFIX(DrawToggleLabel)(RAYUI_WITH_PREFIX(ToggleLabel)* t, Font font, int fontSize, Color color, Color hoverColor, Color backgroundColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOGGLE);
+    Color col = t->hovered ? hoverColor : color;
+    _rayui_DrawRectangleRec(t->rect, backgroundColor);
+    _rayui_DrawTextEx(font, t->value ? t->onLabel : t->offLabel, (Vector2){t->rect.x + 5, t->rect.y + 5}, fontSize, 2, col);
+    _RAYUI_STATS_END(WIDGET_TYPE_TOGGLE, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawToggleLabelEx)(
+    RAYUI_WITH_PREFIX(ToggleLabel)* t, Font font, int fontSize,
+    Color color, Color hoverColor, Color backgroundColor,
+    int outline_width, Color outlineColor
+) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOGGLE);
+    Color col = t->hovered ? hoverColor : color;
+
+    _rayui_DrawRectangleRec(t->rect, backgroundColor);
+
+    if (outline_width > 0) {
+        
+        _rayui_DrawRectangleLinesEx(t->rect, (float)outline_width, outlineColor);
+    }
+
+    const char* text = t->value ? t->onLabel : t->offLabel;
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, text, fontSize, 2);
+
+    Vector2 textPos = {
+        t->rect.x + t->rect.width / 2 - textSize.x / 2,
+        t->rect.y + t->rect.height / 2 - textSize.y / 2
+    };
+
+    _rayui_DrawTextEx(font, text, textPos, fontSize, 2, col);
+    _RAYUI_STATS_END(WIDGET_TYPE_TOGGLE, true);
+}
+
+bool RAYUI_WITH_PREFIX(GetToggleValue)(RAYUI_WITH_PREFIX(ToggleLabel)* t) {
+    return t->value;
+}
+
+void RAYUI_WITH_PREFIX(SetToggleValue)(RAYUI_WITH_PREFIX(ToggleLabel)* t, bool value) {
+    t->value = value;
+}
+
+
+// ---------------- CHECKBOX ----------------
+
+RAYUI_WITH_PREFIX(Checkbox) RAYUI_WITH_PREFIX(CreateCheckbox)(float x, float y, float size, bool initial) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(Checkbox) c;
+    c.value = initial;
+    c.hovered = false;
+    c.hover.hoverInfo = NULL;
+    c.hover.hoverStartTime = 0;
+    c.hover.hovered = false;
+    c.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    c.hover.active = false;
+    c.hover.handle = 0;
+    c.hover.hitHandle = 0;
+    c.hoverSound = ctx->defaultSound;
+    c.clickSound = ctx->defaultSound;
+
+    c.checkboxOnImage = RAYUI_WITH_PREFIX(GetCheckboxOnTexture)();
+    c.checkboxOffImage = RAYUI_WITH_PREFIX(GetCheckboxOffTexture)();
+
+    c.rect = (Rectangle){ x, y, size, size };
+
+    return c;
+}
+
+void RAYUI_WITH_PREFIX(UpdateCheckbox)(RAYUI_WITH_PREFIX(Checkbox)* c, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    c->hovered = _rayui_HitTest(&c->hover, c->rect, mousePoint) && CheckCollisionPointRec(mousePoint, c->rect);
+    c->hover.hovered = c->hovered;
+    _rayui_SyncHover(&c->hover);
+
+    if (c->hover.hovered && c->hover.hoverStartTime == 0) {
+        c->hover.hoverStartTime = _rayui_Time();
+        if (c->hoverSound.frameCount > 0 && c->hover.active) _rayui_PlaySound(c->hoverSound);
+    }
+
+    if (!c->hover.hovered) {
+        c->hover.hoverStartTime = 0;
+    }
+
+    if (c->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (c->clickSound.frameCount > 0 && c->hover.active) _rayui_PlaySound(c->clickSound);
+        c->value = !c->value;
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, false);
+}
+
+void RAYUI_WITH_PREFIX(DrawCheckboxColors)(RAYUI_WITH_PREFIX(Checkbox)* c, Color onColor, Color offColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    _rayui_DrawRectangleRec(c->rect, c->value ? onColor : offColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawCheckboxColorsEx)(RAYUI_WITH_PREFIX(Checkbox)* c, Color onColor, Color offColor, int outline_width, Color outlineColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    _rayui_DrawRectangleRec(c->rect, c->value ? onColor : offColor);
+
+    if (outline_width > 0) {
+        _rayui_DrawRectangleLinesEx(c->rect, (float)outline_width, outlineColor);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawCheckbox)(RAYUI_WITH_PREFIX(Checkbox)* c) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    Texture tex = c->value ? c->checkboxOnImage : c->checkboxOffImage;
+
+    Rectangle src = { 0, 0, (float)tex.width, (float)tex.height };
+
+    Rectangle dest = c->rect;
+
+    _rayui_DrawTexturePro(tex, src, dest, RAYWHITE);
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, true);
+}
+
+bool RAYUI_WITH_PREFIX(GetCheckboxValue)(RAYUI_WITH_PREFIX(Checkbox)* c) {
+    return c->value;
+}
+
+void RAYUI_WITH_PREFIX(SetCheckboxValue)(RAYUI_WITH_PREFIX(Checkbox)* c, bool value) {
+    c->value = value;
+}
+
+void RAYUI_WITH_PREFIX(SetCheckboxTextures)(RAYUI_WITH_PREFIX(Checkbox)* c, Texture onTexture, Texture offTexture) {
+    c->checkboxOnImage = onTexture;
+    c->checkboxOffImage = offTexture;
+}
+
+void RAYUI_WITH_PREFIX(FreeCheckboxTextures)(RAYUI_WITH_PREFIX(Checkbox)* c) {
+    UnloadTexture(c->checkboxOnImage);
+    UnloadTexture(c->checkboxOffImage);
+}
+
+Texture RAYUI_WITH_PREFIX(GetCheckboxOnTexture)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->checkboxOnTexture.id) return ctx->checkboxOnTexture;
+
+    int size = CHECKBOX_DEFAULT_TEXTURE_SIZE;
+    Image img = GenImageColor(size, size, RAYWHITE);
+    ImageDrawRectangleLines(&img, (Rectangle){0, 0, size, size}, 1, BLACK);
+    ImageDrawLine(&img, 8, 16, 14, 24, DARKGREEN);
+    ImageDrawLine(&img, 14, 24, 24, 8, DARKGREEN);
+
+    TraceLog(LOG_INFO, "CHECKBOX: Generating default checkbox ON texture");
+
+    ctx->checkboxOnTexture = LoadTextureFromImage(img);
+    UnloadImage(img);
+    return ctx->checkboxOnTexture;
+}
+
+Texture RAYUI_WITH_PREFIX(GetCheckboxOffTexture)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (ctx->checkboxOffTexture.id) return ctx->checkboxOffTexture;
+
+    int size = CHECKBOX_DEFAULT_TEXTURE_SIZE;
+    Image img = GenImageColor(size, size, RAYWHITE);
+    ImageDrawRectangleLines(&img, (Rectangle){0, 0, size, size}, 1, BLACK);
+    ImageDrawLine(&img, 8, 8, 24, 24, MAROON);
+    ImageDrawLine(&img, 24, 8, 8, 24, MAROON);
+
+    TraceLog(LOG_INFO, "CHECKBOX: Generating default checkbox OFF texture");
+
+    ctx->checkboxOffTexture = LoadTextureFromImage(img);
+    UnloadImage(img);
+    return ctx->checkboxOffTexture;
+}
+
+// ---------------- HIT KERNELS ----------------
+// One point against many rects or triangles, one bitset word (32 shapes) per
+// call. The vector paths test 8 (AVX2) or 4 (SSE2, NEON) shapes per compare
+// with the same float math as CheckCollisionPointRec/PointTriangle, so every
+// path returns the same bits. Shapes are transposed to one coordinate per
+// register on load.
+
+#define _RAYUI_BIT_WORDS(n) (((n) + 31) / 32)
+
+bool RAYUI_WITH_PREFIX(IsBitSet)(const unsigned int* bits, int index) {
+    return (bits[index >> 5] >> (index & 31)) & 1u;
+}
+
+static inline void _rayui_SetBit(unsigned int* bits, int index, bool value) {
+    if (value) bits[index >> 5] |= 1u << (index & 31);
+    else bits[index >> 5] &= ~(1u << (index & 31));
+}
+
+static unsigned int _rayui_PointInRectsScalar(const Rectangle* rects, int count, Vector2 p) {
+    unsigned int bits = 0;
+    for (int i = 0; i < count; i++) {
+        const Rectangle* r = &rects[i];
+        bits |= (unsigned int)(p.x >= r->x && p.x < r->x + r->width && p.y >= r->y && p.y < r->y + r->height) << i;
+    }
+    return bits;
+}
+
+static unsigned int _rayui_PointInTrianglesScalar(const Triangle* tris, int count, Vector2 p) {
+    unsigned int bits = 0;
+    for (int i = 0; i < count; i++) {
+        Vector2 p1 = tris[i].a, p2 = tris[i].b, p3 = tris[i].c;
+        float den = (p2.y - p3.y)*(p1.x - p3.x) + (p3.x - p2.x)*(p1.y - p3.y);
+        float alpha = ((p2.y - p3.y)*(p.x - p3.x) + (p3.x - p2.x)*(p.y - p3.y)) / den;
+        float beta = ((p3.y - p1.y)*(p.x - p3.x) + (p1.x - p3.x)*(p.y - p3.y)) / den;
+        float gamma = 1.0f - alpha - beta;
+        bits |= (unsigned int)(alpha > 0 && beta > 0 && gamma > 0) << i;
+    }
+    return bits;
+}
+
+#if defined(RAYUI_SIMD_AVX2)
+
+// Bit i of the result is set when rects[i] contains p, for up to 32 rects
+static unsigned int _rayui_PointInRectsWord(const Rectangle* rects, int count, Vector2 p) {
+    const __m256 px = _mm256_set1_ps(p.x), py = _mm256_set1_ps(p.y);
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Lanes 0-3 take rects i..i+3 and lanes 4-7 rects i+4..i+7, so the
+        // in-lane transpose leaves every coordinate in rect order
+        const float* r = (const float*)(rects + i);
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r + 0)), _mm_loadu_ps(r + 16), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r + 4)), _mm_loadu_ps(r + 20), 1);
+        __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r + 8)), _mm_loadu_ps(r + 24), 1);
+        __m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r + 12)), _mm_loadu_ps(r + 28), 1);
+        __m256 ab0 = _mm256_unpacklo_ps(a, b), ab1 = _mm256_unpackhi_ps(a, b);
+        __m256 cd0 = _mm256_unpacklo_ps(c, d), cd1 = _mm256_unpackhi_ps(c, d);
+        __m256 x = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 y = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 w = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 h = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 in = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(px, x, _CMP_GE_OQ), _mm256_cmp_ps(px, _mm256_add_ps(x, w), _CMP_LT_OQ)),
+                                  _mm256_and_ps(_mm256_cmp_ps(py, y, _CMP_GE_OQ), _mm256_cmp_ps(py, _mm256_add_ps(y, h), _CMP_LT_OQ)));
+        bits |= (unsigned int)_mm256_movemask_ps(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInRectsScalar(rects + i, count - i, p) << i;
+    return bits;
+}
+
+static unsigned int _rayui_PointInTrianglesWord(const Triangle* tris, int count, Vector2 p) {
+    const __m256 px = _mm256_set1_ps(p.x), py = _mm256_set1_ps(p.y);
+    const __m256 zero = _mm256_setzero_ps();
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Six loads hold the 12 points of four triangles, a (0, 3, 6, 9), b (1, 4, 7, 10)
+        // and c (2, 5, 8, 11), two per load. Lanes 4-7 repeat this for triangles i+4..i+7
+        const float* t = (const float*)(tris + i);
+        __m256 l[6];
+        for (int k = 0; k < 6; k++) l[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(t + 4*k)), _mm_loadu_ps(t + 24 + 4*k), 1);
+        __m256 a01 = _mm256_shuffle_ps(l[0], l[1], _MM_SHUFFLE(3, 2, 1, 0)), a23 = _mm256_shuffle_ps(l[3], l[4], _MM_SHUFFLE(3, 2, 1, 0));
+        __m256 b01 = _mm256_shuffle_ps(l[0], l[2], _MM_SHUFFLE(1, 0, 3, 2)), b23 = _mm256_shuffle_ps(l[3], l[5], _MM_SHUFFLE(1, 0, 3, 2));
+        __m256 c01 = _mm256_shuffle_ps(l[1], l[2], _MM_SHUFFLE(3, 2, 1, 0)), c23 = _mm256_shuffle_ps(l[4], l[5], _MM_SHUFFLE(3, 2, 1, 0));
+        __m256 x1 = _mm256_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0)), y1 = _mm256_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 x2 = _mm256_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0)), y2 = _mm256_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 x3 = _mm256_shuffle_ps(c01, c23, _MM_SHUFFLE(2, 0, 2, 0)), y3 = _mm256_shuffle_ps(c01, c23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 dx = _mm256_sub_ps(px, x3), dy = _mm256_sub_ps(py, y3);
+        __m256 e0 = _mm256_sub_ps(y2, y3), e1 = _mm256_sub_ps(x3, x2);
+        __m256 den = _mm256_add_ps(_mm256_mul_ps(e0, _mm256_sub_ps(x1, x3)), _mm256_mul_ps(e1, _mm256_sub_ps(y1, y3)));
+        __m256 alpha = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(e0, dx), _mm256_mul_ps(e1, dy)), den);
+        __m256 beta = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(y3, y1), dx), _mm256_mul_ps(_mm256_sub_ps(x1, x3), dy)), den);
+        __m256 gamma = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), alpha), beta);
+        __m256 in = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(alpha, zero, _CMP_GT_OQ), _mm256_cmp_ps(beta, zero, _CMP_GT_OQ)),
+                                  _mm256_cmp_ps(gamma, zero, _CMP_GT_OQ));
+        bits |= (unsigned int)_mm256_movemask_ps(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInTrianglesScalar(tris + i, count - i, p) << i;
+    return bits;
+}
+
+#elif defined(RAYUI_SIMD_SSE2)
+
+static unsigned int _rayui_PointInRectsWord(const Rectangle* rects, int count, Vector2 p) {
+    const __m128 px = _mm_set1_ps(p.x), py = _mm_set1_ps(p.y);
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float* r = (const float*)(rects + i);
+        __m128 x = _mm_loadu_ps(r + 0), y = _mm_loadu_ps(r + 4);
+        __m128 w = _mm_loadu_ps(r + 8), h = _mm_loadu_ps(r + 12);
+        _MM_TRANSPOSE4_PS(x, y, w, h);
+        __m128 in = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(px, x), _mm_cmplt_ps(px, _mm_add_ps(x, w))),
+                               _mm_and_ps(_mm_cmpge_ps(py, y), _mm_cmplt_ps(py, _mm_add_ps(y, h))));
+        bits |= (unsigned int)_mm_movemask_ps(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInRectsScalar(rects + i, count - i, p) << i;
+    return bits;
+}
+
+static unsigned int _rayui_PointInTrianglesWord(const Triangle* tris, int count, Vector2 p) {
+    const __m128 px = _mm_set1_ps(p.x), py = _mm_set1_ps(p.y);
+    const __m128 zero = _mm_setzero_ps();
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // Six loads hold the 12 points, a (0, 3, 6, 9), b (1, 4, 7, 10) and c (2, 5, 8, 11)
+        const float* t = (const float*)(tris + i);
+        __m128 l0 = _mm_loadu_ps(t + 0), l1 = _mm_loadu_ps(t + 4), l2 = _mm_loadu_ps(t + 8);
+        __m128 l3 = _mm_loadu_ps(t + 12), l4 = _mm_loadu_ps(t + 16), l5 = _mm_loadu_ps(t + 20);
+        __m128 a01 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(3, 2, 1, 0)), a23 = _mm_shuffle_ps(l3, l4, _MM_SHUFFLE(3, 2, 1, 0));
+        __m128 b01 = _mm_shuffle_ps(l0, l2, _MM_SHUFFLE(1, 0, 3, 2)), b23 = _mm_shuffle_ps(l3, l5, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 c01 = _mm_shuffle_ps(l1, l2, _MM_SHUFFLE(3, 2, 1, 0)), c23 = _mm_shuffle_ps(l4, l5, _MM_SHUFFLE(3, 2, 1, 0));
+        __m128 x1 = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0)), y1 = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 x2 = _mm_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0)), y2 = _mm_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 x3 = _mm_shuffle_ps(c01, c23, _MM_SHUFFLE(2, 0, 2, 0)), y3 = _mm_shuffle_ps(c01, c23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 dx = _mm_sub_ps(px, x3), dy = _mm_sub_ps(py, y3);
+        __m128 e0 = _mm_sub_ps(y2, y3), e1 = _mm_sub_ps(x3, x2);
+        __m128 den = _mm_add_ps(_mm_mul_ps(e0, _mm_sub_ps(x1, x3)), _mm_mul_ps(e1, _mm_sub_ps(y1, y3)));
+        __m128 alpha = _mm_div_ps(_mm_add_ps(_mm_mul_ps(e0, dx), _mm_mul_ps(e1, dy)), den);
+        __m128 beta = _mm_div_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(y3, y1), dx), _mm_mul_ps(_mm_sub_ps(x1, x3), dy)), den);
+        __m128 gamma = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), alpha), beta);
+        __m128 in = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(alpha, zero), _mm_cmpgt_ps(beta, zero)), _mm_cmpgt_ps(gamma, zero));
+        bits |= (unsigned int)_mm_movemask_ps(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInTrianglesScalar(tris + i, count - i, p) << i;
+    return bits;
+}
+
+#elif defined(RAYUI_SIMD_NEON)
+
+static inline unsigned int _rayui_MoveMaskNEON(uint32x4_t m) {
+    static const uint32_t weights[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+}
+
+static unsigned int _rayui_PointInRectsWord(const Rectangle* rects, int count, Vector2 p) {
+    const float32x4_t px = vdupq_n_f32(p.x), py = vdupq_n_f32(p.y);
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x4_t r = vld4q_f32((const float*)(rects + i)); // x, y, width, height
+        uint32x4_t in = vandq_u32(vandq_u32(vcgeq_f32(px, r.val[0]), vcltq_f32(px, vaddq_f32(r.val[0], r.val[2]))),
+                                  vandq_u32(vcgeq_f32(py, r.val[1]), vcltq_f32(py, vaddq_f32(r.val[1], r.val[3]))));
+        bits |= _rayui_MoveMaskNEON(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInRectsScalar(rects + i, count - i, p) << i;
+    return bits;
+}
+
+static unsigned int _rayui_PointInTrianglesWord(const Triangle* tris, int count, Vector2 p) {
+    const float32x4_t px = vdupq_n_f32(p.x), py = vdupq_n_f32(p.y);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    unsigned int bits = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // Points are 64-bit pairs, so a stride 3 load splits two triangles into a, b and c
+        uint64x2x3_t t01 = vld3q_u64((const uint64_t*)(tris + i));
+        uint64x2x3_t t23 = vld3q_u64((const uint64_t*)(tris + i + 2));
+        float32x4_t a01 = vreinterpretq_f32_u64(t01.val[0]), a23 = vreinterpretq_f32_u64(t23.val[0]);
+        float32x4_t b01 = vreinterpretq_f32_u64(t01.val[1]), b23 = vreinterpretq_f32_u64(t23.val[1]);
+        float32x4_t c01 = vreinterpretq_f32_u64(t01.val[2]), c23 = vreinterpretq_f32_u64(t23.val[2]);
+        float32x4_t x1 = vuzp1q_f32(a01, a23), y1 = vuzp2q_f32(a01, a23);
+        float32x4_t x2 = vuzp1q_f32(b01, b23), y2 = vuzp2q_f32(b01, b23);
+        float32x4_t x3 = vuzp1q_f32(c01, c23), y3 = vuzp2q_f32(c01, c23);
+        float32x4_t dx = vsubq_f32(px, x3), dy = vsubq_f32(py, y3);
+        float32x4_t e0 = vsubq_f32(y2, y3), e1 = vsubq_f32(x3, x2);
+        float32x4_t den = vaddq_f32(vmulq_f32(e0, vsubq_f32(x1, x3)), vmulq_f32(e1, vsubq_f32(y1, y3)));
+        float32x4_t alpha = vdivq_f32(vaddq_f32(vmulq_f32(e0, dx), vmulq_f32(e1, dy)), den);
+        float32x4_t beta = vdivq_f32(vaddq_f32(vmulq_f32(vsubq_f32(y3, y1), dx), vmulq_f32(vsubq_f32(x1, x3), dy)), den);
+        float32x4_t gamma = vsubq_f32(vsubq_f32(vdupq_n_f32(1.0f), alpha), beta);
+        uint32x4_t in = vandq_u32(vandq_u32(vcgtq_f32(alpha, zero), vcgtq_f32(beta, zero)), vcgtq_f32(gamma, zero));
+        bits |= _rayui_MoveMaskNEON(in) << i;
+    }
+    if (i < count) bits |= _rayui_PointInTrianglesScalar(tris + i, count - i, p) << i;
+    return bits;
+}
+
+#else
+
+static unsigned int _rayui_PointInRectsWord(const Rectangle* rects, int count, Vector2 p) {
+    return _rayui_PointInRectsScalar(rects, count, p);
+}
+
+static unsigned int _rayui_PointInTrianglesWord(const Triangle* tris, int count, Vector2 p) {
+    return _rayui_PointInTrianglesScalar(tris, count, p);
+}
+
+#endif
+
+int RAYUI_WITH_PREFIX(PointInRects)(Vector2 point, const Rectangle* rects, int count, unsigned int* mask) {
+    int hits = 0;
+    for (int w = 0, first = 0; first < count; w++, first += 32) {
+        mask[w] = _rayui_PointInRectsWord(rects + first, count - first < 32 ? count - first : 32, point);
+        for (unsigned int m = mask[w]; m; m &= m - 1) hits++;
+    }
+    return hits;
+}
+
+int RAYUI_WITH_PREFIX(PointInTriangles)(Vector2 point, const Triangle* triangles, int count, unsigned int* mask) {
+    int hits = 0;
+    for (int w = 0, first = 0; first < count; w++, first += 32) {
+        mask[w] = _rayui_PointInTrianglesWord(triangles + first, count - first < 32 ? count - first : 32, point);
+        for (unsigned int m = mask[w]; m; m &= m - 1) hits++;
+    }
+    return hits;
+}
+
+// ---------------- WIDGET ARRAYS ----------------
+// Batch updates work a bitset word (32 elements) at a time: the rect pass
+// produces the hovered word, and clicks, toggles and sounds follow from word
+// operations on it. Labels and textures are only read by the draw calls.
+
+static bool _rayui_GrowArray(void** data, int itemSize, int capacity) {
+    void* grown = RAYUI_REALLOC(*data, (size_t)capacity * itemSize);
+    if (!grown) return false;
+    *data = grown;
+    return true;
+}
+
+// New words are cleared, capacities are always multiples of 32
+static bool _rayui_GrowBits(unsigned int** bits, int capacity, int newCapacity) {
+    if (!_rayui_GrowArray((void**)bits, sizeof(unsigned int), _RAYUI_BIT_WORDS(newCapacity))) return false;
+    memset(*bits + _RAYUI_BIT_WORDS(capacity), 0, (_RAYUI_BIT_WORDS(newCapacity) - _RAYUI_BIT_WORDS(capacity)) * sizeof(unsigned int));
+    return true;
+}
+
+static inline int _rayui_ArrayCapacity(int capacity) {
+    return capacity ? capacity * 2 : 64;
+}
+
+// Hover and click pass shared by all three arrays. Returns the pressed mask of
+// every word in pressed[], i.e. the hovered elements when the button went down.
+static void _rayui_UpdateArrayHover(const Rectangle* rects, int count, unsigned int* hovered, unsigned int* pressed, Sound hoverSound, Sound clickSound) {
+    Vector2 mouse = _rayui_MousePosition();
+    bool down = _rayui_MousePressed(MOUSE_LEFT_BUTTON);
+    for (int w = 0, first = 0; first < count; w++, first += 32) {
+        int n = count - first < 32 ? count - first : 32;
+        unsigned int now = _rayui_PointInRectsWord(rects + first, n, mouse);
+        unsigned int entered = now & ~hovered[w];
+        hovered[w] = now;
+        pressed[w] = down ? now : 0;
+        if (hoverSound.frameCount > 0)
+            for (; entered; entered &= entered - 1) _rayui_PlaySound(hoverSound);
+        if (clickSound.frameCount > 0)
+            for (unsigned int p = pressed[w]; p; p &= p - 1) _rayui_PlaySound(clickSound);
+    }
+}
+
+RAYUI_WITH_PREFIX(ButtonArray) RAYUI_WITH_PREFIX(CreateButtonArray)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(ButtonArray) a;
+    memset(&a, 0, sizeof(a));
+    a.hoverSound = ctx->defaultSound;
+    a.clickSound = ctx->defaultSound;
+    return a;
+}
+
+int RAYUI_WITH_PREFIX(AddButton)(RAYUI_WITH_PREFIX(ButtonArray)* a, float x, float y, float width, float height, const char* text) {
+    if (a->count == a->capacity) {
+        int capacity = _rayui_ArrayCapacity(a->capacity);
+        if (!_rayui_GrowArray((void**)&a->rects, sizeof(Rectangle), capacity) ||
+            !_rayui_GrowArray((void**)&a->texts, sizeof(const char*), capacity) ||
+            !_rayui_GrowBits(&a->hovered, a->capacity, capacity) ||
+            !_rayui_GrowBits(&a->clicked, a->capacity, capacity)) return -1;
+        a->capacity = capacity;
+    }
+    int i = a->count++;
+    a->rects[i] = (Rectangle){x, y, width, height};
+    a->texts[i] = text;
+    _rayui_SetBit(a->hovered, i, false);
+    _rayui_SetBit(a->clicked, i, false);
+    return i;
+}
+
+const unsigned int* RAYUI_WITH_PREFIX(UpdateButtons)(RAYUI_WITH_PREFIX(ButtonArray)* a) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    _rayui_UpdateArrayHover(a->rects, a->count, a->hovered, a->clicked, a->hoverSound, a->clickSound);
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, false);
+    return a->clicked;
+}
+
+void RAYUI_WITH_PREFIX(DrawButtons)(RAYUI_WITH_PREFIX(ButtonArray)* a, Font font, int fontSize, Color color, Color hoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_BUTTON);
+    for (int i = 0; i < a->count; i++) {
+        Rectangle r = a->rects[i];
+        Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, a->texts[i], fontSize, 2);
+        Vector2 pos = { r.x + r.width/2 - textSize.x/2, r.y + r.height/2 - textSize.y/2 };
+        _rayui_DrawTextEx(font, a->texts[i], pos, fontSize, 2, RAYUI_WITH_PREFIX(IsBitSet)(a->hovered, i) ? hoverColor : color);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_BUTTON, true);
+}
+
+void RAYUI_WITH_PREFIX(FreeButtonArray)(RAYUI_WITH_PREFIX(ButtonArray)* a) {
+    RAYUI_FREE(a->rects);
+    RAYUI_FREE(a->texts);
+    RAYUI_FREE(a->hovered);
+    RAYUI_FREE(a->clicked);
+    a->rects = NULL;
+    a->texts = NULL;
+    a->hovered = a->clicked = NULL;
+    a->count = a->capacity = 0;
+}
+
+RAYUI_WITH_PREFIX(CheckboxArray) RAYUI_WITH_PREFIX(CreateCheckboxArray)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(CheckboxArray) a;
+    memset(&a, 0, sizeof(a));
+    a.onTexture = RAYUI_WITH_PREFIX(GetCheckboxOnTexture)();
+    a.offTexture = RAYUI_WITH_PREFIX(GetCheckboxOffTexture)();
+    a.hoverSound = ctx->defaultSound;
+    a.clickSound = ctx->defaultSound;
+    return a;
+}
+
+int RAYUI_WITH_PREFIX(AddCheckbox)(RAYUI_WITH_PREFIX(CheckboxArray)* a, float x, float y, float size, bool initial) {
+    if (a->count == a->capacity) {
+        int capacity = _rayui_ArrayCapacity(a->capacity);
+        if (!_rayui_GrowArray((void**)&a->rects, sizeof(Rectangle), capacity) ||
+            !_rayui_GrowBits(&a->values, a->capacity, capacity) ||
+            !_rayui_GrowBits(&a->hovered, a->capacity, capacity) ||
+            !_rayui_GrowBits(&a->changed, a->capacity, capacity)) return -1;
+        a->capacity = capacity;
+    }
+    int i = a->count++;
+    a->rects[i] = (Rectangle){x, y, size, size};
+    _rayui_SetBit(a->values, i, initial);
+    _rayui_SetBit(a->hovered, i, false);
+    _rayui_SetBit(a->changed, i, false);
+    return i;
+}
+
+const unsigned int* RAYUI_WITH_PREFIX(UpdateCheckboxes)(RAYUI_WITH_PREFIX(CheckboxArray)* a) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    _rayui_UpdateArrayHover(a->rects, a->count, a->hovered, a->changed, a->hoverSound, a->clickSound);
+    for (int w = 0; w < _RAYUI_BIT_WORDS(a->count); w++) a->values[w] ^= a->changed[w];
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, false);
+    return a->changed;
+}
+
+void RAYUI_WITH_PREFIX(DrawCheckboxes)(RAYUI_WITH_PREFIX(CheckboxArray)* a) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    for (int i = 0; i < a->count; i++) {
+        Texture tex = RAYUI_WITH_PREFIX(IsBitSet)(a->values, i) ? a->onTexture : a->offTexture;
+        _rayui_DrawTexturePro(tex, (Rectangle){ 0, 0, (float)tex.width, (float)tex.height }, a->rects[i], RAYWHITE);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawCheckboxesColors)(RAYUI_WITH_PREFIX(CheckboxArray)* a, Color onColor, Color offColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_CHECKBOX);
+    for (int i = 0; i < a->count; i++)
+        _rayui_DrawRectangleRec(a->rects[i], RAYUI_WITH_PREFIX(IsBitSet)(a->values, i) ? onColor : offColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_CHECKBOX, true);
+}
+
+bool RAYUI_WITH_PREFIX(GetCheckboxArrayValue)(RAYUI_WITH_PREFIX(CheckboxArray)* a, int index) {
+    return RAYUI_WITH_PREFIX(IsBitSet)(a->values, index);
+}
+
+void RAYUI_WITH_PREFIX(SetCheckboxArrayValue)(RAYUI_WITH_PREFIX(CheckboxArray)* a, int index, bool value) {
+    _rayui_SetBit(a->values, index, value);
+}
+
+void RAYUI_WITH_PREFIX(FreeCheckboxArray)(RAYUI_WITH_PREFIX(CheckboxArray)* a) {
+    RAYUI_FREE(a->rects);
+    RAYUI_FREE(a->values);
+    RAYUI_FREE(a->hovered);
+    RAYUI_FREE(a->changed);
+    a->rects = NULL;
+    a->values = a->hovered = a->changed = NULL;
+    a->count = a->capacity = 0;
+}
+
+RAYUI_WITH_PREFIX(ToggleArray) RAYUI_WITH_PREFIX(CreateToggleArray)(void) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(ToggleArray) a;
+    memset(&a, 0, sizeof(a));
+    a.hoverSound = ctx->defaultSound;
+    a.clickSound = ctx->defaultSound;
+    return a;
+}
+
+int RAYUI_WITH_PREFIX(AddToggle)(RAYUI_WITH_PREFIX(ToggleArray)* a, float x, float y, float width, float height, bool initial, const char* onLabel, const char* offLabel) {
+    if (a->count == a->capacity) {
+        int capacity = _rayui_ArrayCapacity(a->capacity);
+        if (!_rayui_GrowArray((void**)&a->rects, sizeof(Rectangle), capacity) ||
+            !_rayui_GrowArray((void**)&a->onLabels, sizeof(const char*), capacity) ||
+            !_rayui_GrowArray((void**)&a->offLabels, sizeof(const char*), capacity) ||
+            !_rayui_GrowBits(&a->values, a->capacity, capacity) ||
+            !_rayui_GrowBits(&a->hovered, a->capacity, capacity) ||
+            !_rayui_GrowBits(&a->changed, a->capacity, capacity)) return -1;
+        a->capacity = capacity;
+    }
+    int i = a->count++;
+    a->rects[i] = (Rectangle){x, y, width, height};
+    a->onLabels[i] = onLabel;
+    a->offLabels[i] = offLabel;
+    _rayui_SetBit(a->values, i, initial);
+    _rayui_SetBit(a->hovered, i, false);
+    _rayui_SetBit(a->changed, i, false);
+    return i;
+}
+
+const unsigned int* RAYUI_WITH_PREFIX(UpdateToggles)(RAYUI_WITH_PREFIX(ToggleArray)* a) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOGGLE);
+    _rayui_UpdateArrayHover(a->rects, a->count, a->hovered, a->changed, a->hoverSound, a->clickSound);
+    for (int w = 0; w < _RAYUI_BIT_WORDS(a->count); w++) a->values[w] ^= a->changed[w];
+    _RAYUI_STATS_END(WIDGET_TYPE_TOGGLE, false);
+    return a->changed;
+}
+
+void RAYUI_WITH_PREFIX(DrawToggles)(RAYUI_WITH_PREFIX(ToggleArray)* a, Font font, int fontSize, Color color, Color hoverColor, Color backgroundColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TOGGLE);
+    for (int i = 0; i < a->count; i++) {
+        Rectangle r = a->rects[i];
+        const char* label = RAYUI_WITH_PREFIX(IsBitSet)(a->values, i) ? a->onLabels[i] : a->offLabels[i];
+        _rayui_DrawRectangleRec(r, backgroundColor);
+        _rayui_DrawTextEx(font, label, (Vector2){r.x + 5, r.y + 5}, fontSize, 2, RAYUI_WITH_PREFIX(IsBitSet)(a->hovered, i) ? hoverColor : color);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_TOGGLE, true);
+}
+
+bool RAYUI_WITH_PREFIX(GetToggleArrayValue)(RAYUI_WITH_PREFIX(ToggleArray)* a, int index) {
+    return RAYUI_WITH_PREFIX(IsBitSet)(a->values, index);
+}
+
+void RAYUI_WITH_PREFIX(SetToggleArrayValue)(RAYUI_WITH_PREFIX(ToggleArray)* a, int index, bool value) {
+    _rayui_SetBit(a->values, index, value);
+}
+
+void RAYUI_WITH_PREFIX(FreeToggleArray)(RAYUI_WITH_PREFIX(ToggleArray)* a) {
+    RAYUI_FREE(a->rects);
+    RAYUI_FREE(a->onLabels);
+    RAYUI_FREE(a->offLabels);
+    RAYUI_FREE(a->values);
+    RAYUI_FREE(a->hovered);
+    RAYUI_FREE(a->changed);
+    a->rects = NULL;
+    a->onLabels = a->offLabels = NULL;
+    a->values = a->hovered = a->changed = NULL;
+    a->count = a->capacity = 0;
+}
+
+// ---------------- SLIDER ----------------
+
+RAYUI_WITH_PREFIX(Slider) RAYUI_WITH_PREFIX(CreateSlider)(int x, int y, int width, int minVal, int maxVal, float initial) {
+    RAYUI_WITH_PREFIX(Slider) s;
+    s.bar = (Rectangle){x, y, width, 5};
+    s.value = initial;
+    s.minVal = minVal;
+    s.maxVal = maxVal;
+    s.dragging = false;
+    s.hover.hoverInfo = NULL;
+    s.hover.hoverStartTime = 0;
+    s.hover.hovered = false;
+    s.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    s.hover.active = false;
+    s.hover.handle = 0;
+    s.hover.hitHandle = 0;
+    return s;
+}
+
+void RAYUI_WITH_PREFIX(UpdateSlider)(RAYUI_WITH_PREFIX(Slider)* s, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_SLIDER);
+    float knobX = s->bar.x + s->value * s->bar.width;
+    Rectangle knob = {knobX - 8, s->bar.y - 5, 16, 15};
+    bool candidate = _rayui_HitTest(&s->hover, _rayui_RectUnion(s->bar, knob), mousePoint);
+
+    if (s->hover.active) {
+        s->hover.hovered = candidate && (CheckCollisionPointRec(mousePoint, s->bar) || 
+                        CheckCollisionPointRec(mousePoint, knob));
+        _rayui_SyncHover(&s->hover);
+
+        if (s->hover.hovered && s->hover.hoverStartTime == 0) s->hover.hoverStartTime = _rayui_Time();
+        if (!s->hover.hovered) s->hover.hoverStartTime = 0;
+    }
+
+    if (candidate && _rayui_MousePressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePoint, knob))
+        s->dragging = true;
+
+    if (_rayui_MouseReleased(MOUSE_LEFT_BUTTON))
+        s->dragging = false;
+
+    if (s->dragging) {
+        float ratio = (mousePoint.x - s->bar.x) / s->bar.width;
+        if (ratio < 0) ratio = 0;
+        if (ratio > 1) ratio = 1;
+        s->value = ratio;
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_SLIDER, false);
+}
+
+int RAYUI_WITH_PREFIX(SliderValue)(RAYUI_WITH_PREFIX(Slider)* s) {
+    return (int)(s->minVal + s->value * (s->maxVal - s->minVal));
+}
+
+void RAYUI_WITH_PREFIX(DrawSlider)(RAYUI_WITH_PREFIX(Slider)* s, Color color, Color knobColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_SLIDER);
+    _rayui_DrawRectangleRec(s->bar, color);
+    float knobX = s->bar.x + s->value * s->bar.width;
+    _rayui_DrawRectangleRec((Rectangle){(int)(knobX - 8), (int)(s->bar.y - 5), 16, 15}, knobColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_SLIDER, true);
+}
+
+// ---------------- OPTION SLIDER ----------------
+
+RAYUI_WITH_PREFIX(OptionSlider) RAYUI_WITH_PREFIX(CreateOptionSlider)(int x, int y, int width, const char** options, int optionCount, int initialIndex) {
+    RAYUI_WITH_PREFIX(OptionSlider) s;
+    s.bar = (Rectangle){x, y, width, 5};
+    s.options = options;
+    s.optionCount = optionCount;
+    s.selectedIndex = initialIndex;
+    s.dragging = false;
+    s.hover.hoverInfo = NULL;
+    s.hover.hoverStartTime = 0;
+    s.hover.hovered = false;
+    s.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    s.hover.active = false;
+    s.hover.handle = 0;
+    s.hover.hitHandle = 0;
+    return s;
+}
+
+void RAYUI_WITH_PREFIX(UpdateOptionSlider)(RAYUI_WITH_PREFIX(OptionSlider)* s, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_OPTION_SLIDER);
+    float knobX = s->bar.x + ((float)s->selectedIndex / (s->optionCount - 1)) * s->bar.width;
+    Rectangle knob = {knobX - 8, s->bar.y - 5, 16, 15};
+    bool candidate = _rayui_HitTest(&s->hover, _rayui_RectUnion(s->bar, knob), mousePoint);
+
+    if (s->hover.active) {
+        s->hover.hovered = candidate && (CheckCollisionPointRec(mousePoint, s->bar) || 
+                        CheckCollisionPointRec(mousePoint, knob));
+        _rayui_SyncHover(&s->hover);
+
+        if (s->hover.hovered && s->hover.hoverStartTime == 0) s->hover.hoverStartTime = _rayui_Time();
+        if (!s->hover.hovered) s->hover.hoverStartTime = 0;
+    }
+
+    if (candidate && _rayui_MousePressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePoint, knob))
+        s->dragging = true;
+
+    if (_rayui_MouseReleased(MOUSE_LEFT_BUTTON))
+        s->dragging = false;
+
+    if (s->dragging) {
+        float ratio = (mousePoint.x - s->bar.x) / s->bar.width;
+        if (ratio < 0) ratio = 0;
+        if (ratio > 1) ratio = 1;
+        s->selectedIndex = (int)(ratio * (s->optionCount - 1) + 0.5f);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_OPTION_SLIDER, false);
+}
+
+const char* RAYUI_WITH_PREFIX(OptionSliderValue)(RAYUI_WITH_PREFIX(OptionSlider)* s) {
+    if (s->selectedIndex < 0 || s->selectedIndex >= s->optionCount) return s->options[0];
+    return s->options[s->selectedIndex];
+}
+
+void RAYUI_WITH_PREFIX(DrawOptionSlider)(RAYUI_WITH_PREFIX(OptionSlider)* s, Color color, Color knobColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_OPTION_SLIDER);
+    _rayui_DrawRectangleRec(s->bar, color);
+    float knobX = s->bar.x + ((float)s->selectedIndex / (s->optionCount - 1)) * s->bar.width;
+    _rayui_DrawRectangleRec((Rectangle){(int)(knobX - 8), (int)(s->bar.y - 5), 16, 15}, knobColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_OPTION_SLIDER, true);
+}
+
+// ---------------- KEYBIND INPUT ----------------
+
+RAYUI_WITH_PREFIX(KeybindInput) RAYUI_WITH_PREFIX(CreateKeybindInput)(float x, float y, float width, float height, int initialKey, Sound hoverSound, Sound clickSound) {
+    RAYUI_WITH_PREFIX(KeybindInput) k;
+    k.rect = (Rectangle){x, y, width, height};
+    k.key = initialKey;
+    k.listening = false;
+    k.hovered = false;
+    k.hoverSound = hoverSound;
+    k.clickSound = clickSound;
+    k.hover.hoverInfo = NULL;
+    k.hover.hoverStartTime = 0;
+    k.hover.hovered = false;
+    k.hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    k.hover.active = false;
+    k.hover.handle = 0;
+    k.hover.hitHandle = 0;
+    return k;
+}
+
+static bool _rayui_UpdateKeybindInput(RAYUI_WITH_PREFIX(KeybindInput)* k, Vector2 mousePoint) {
+    k->hovered = _rayui_HitTest(&k->hover, k->rect, mousePoint) && CheckCollisionPointRec(mousePoint, k->rect);
+    k->hover.hovered = k->hovered;
+    _rayui_SyncHover(&k->hover);
+
+    if (k->hover.hovered && k->hover.hoverStartTime == 0 && k->hover.active) {
+        k->hover.hoverStartTime = _rayui_Time();
+        if (k->hoverSound.frameCount > 0) _rayui_PlaySound(k->hoverSound);
+    }
+
+    if (!k->hover.hovered)
+        k->hover.hoverStartTime = 0;
+
+    if (k->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (k->clickSound.frameCount > 0 && k->hover.active) _rayui_PlaySound(k->clickSound);
+        k->listening = true;
+        return false;
+    }
+
+    if (k->listening) {
+        int cursor = 0;
+        int pressed = _rayui_NextKeyPressed(&cursor);
+        if (pressed != 0) {
+            k->key = pressed;
+            k->listening = false;
+            return true;
+        }
+        if (_rayui_KeyPressed(KEY_ESCAPE) || _rayui_MousePressed(MOUSE_RIGHT_BUTTON)) {
+            k->listening = false;
+        }
+    }
+
+    return false;
+}
+
+bool RAYUI_WITH_PREFIX(UpdateKeybindInput)(RAYUI_WITH_PREFIX(KeybindInput)* k, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_KEYBIND);
+    bool result = _rayui_UpdateKeybindInput(k, mousePoint);
+    _RAYUI_STATS_END(WIDGET_TYPE_KEYBIND, false);
+    return result;
+}
+
+void RAYUI_WITH_PREFIX(DrawKeybindInput)(RAYUI_WITH_PREFIX(KeybindInput)* k, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_KEYBIND);
+    Color bg = bgColor;
+    Color textColorI = (k->hovered || k->listening) ? textHoverColor : textColor;
+    _rayui_DrawRectangleRec(k->rect, bg);
+
+    const char* text = k->listening ? _rayui_FrameFormat("| %s |", GetKeyName(k->key)) : GetKeyName(k->key);
+    if (!text) text = "";
+
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, text, fontSize, 1);
+    Vector2 pos = { k->rect.x + (k->rect.width - textSize.x)/2,
+                    k->rect.y + (k->rect.height - textSize.y)/2 };
+    _rayui_DrawTextEx(font, text, pos, fontSize, 1, textColorI);
+    _RAYUI_STATS_END(WIDGET_TYPE_KEYBIND, true);
+}
+
+KeyboardKey RAYUI_WITH_PREFIX(GetKeybindValue)(RAYUI_WITH_PREFIX(KeybindInput)* k) {
+    return k->key;
+}
+
+// ---------------- TEXT INPUT ----------------
+// Text lives in a gap buffer: buffer[0, gapStart) and buffer[gapEnd, capacity)
+// with the gap moved to wherever the next edit happens, so typing and deleting
+// at the caret is O(1) amortized. The gap always keeps at least one byte so the
+// text before it can be NUL terminated in place, and buffer[capacity] is a
+// permanent terminator for the text after it.
+
+#define _RAYUI_TEXT_INPUT_MIN_CAPACITY 64
+
+static int _rayui_EncodeUTF8(int codepoint, char* out) {
+    if (codepoint < 0x80) { out[0] = (char)codepoint; return 1; }
+    if (codepoint < 0x800) {
+        out[0] = (char)(0xC0 | (codepoint >> 6));
+        out[1] = (char)(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint < 0x10000) {
+        out[0] = (char)(0xE0 | (codepoint >> 12));
+        out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (codepoint >> 18));
+    out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+// Decodes the `bytes` long sequence at p; malformed sequences read as '?'
+static int _rayui_DecodeUTF8(const unsigned char* p, int bytes) {
+    int expected = p[0] < 0x80 ? 1 : p[0] >= 0xF0 ? 4 : p[0] >= 0xE0 ? 3 : p[0] >= 0xC0 ? 2 : 0;
+    if (expected != bytes) return '?';
+    int codepoint = bytes == 1 ? p[0] : p[0] & (0x7F >> bytes);
+    for (int i = 1; i < bytes; i++) codepoint = (codepoint << 6) | (p[i] & 0x3F);
+    return codepoint;
+}
+
+static inline unsigned char _rayui_TextInputByte(RAYUI_WITH_PREFIX(TextInput)* t, int i) {
+    return (unsigned char)t->buffer[i < t->gapStart ? i : i + t->gapEnd - t->gapStart];
+}
+
+// Codepoint boundaries: a codepoint is a lead byte plus the continuation
+// bytes (10xxxxxx) after it. The gap and caret only ever sit on boundaries
+static int _rayui_TextInputNext(RAYUI_WITH_PREFIX(TextInput)* t, int i) {
+    if (i >= t->length) return t->length;
+    i++;
+    while (i < t->length && (_rayui_TextInputByte(t, i) & 0xC0) == 0x80) i++;
+    return i;
+}
+
+static int _rayui_TextInputPrev(RAYUI_WITH_PREFIX(TextInput)* t, int i) {
+    if (i <= 0) return 0;
+    i--;
+    while (i > 0 && (_rayui_TextInputByte(t, i) & 0xC0) == 0x80) i--;
+    return i;
+}
+
+static int _rayui_TextInputBoundary(RAYUI_WITH_PREFIX(TextInput)* t, int i) {
+    if (i <= 0) return 0;
+    if (i >= t->length) return t->length;
+    while (i > 0 && (_rayui_TextInputByte(t, i) & 0xC0) == 0x80) i--;
+    return i;
+}
+
+// Also re-grows the buffer of a freed input. False when out of memory, the
+// text is then left as it was
+static bool _rayui_TextInputReserve(RAYUI_WITH_PREFIX(TextInput)* t, int bytes) {
+    if (t->buffer && t->gapEnd - t->gapStart > bytes) return true;
+    int capacity = t->capacity * 2;
+    if (capacity < t->length + bytes + _RAYUI_TEXT_INPUT_MIN_CAPACITY) capacity = t->length + bytes + _RAYUI_TEXT_INPUT_MIN_CAPACITY;
+    char* buffer = (char*)RAYUI_REALLOC(t->buffer, capacity + 1);
+    if (!buffer) return false;
+    t->buffer = buffer;
+    int after = t->capacity - t->gapEnd;
+    memmove(t->buffer + capacity - after, t->buffer + t->gapEnd, after);
+    t->gapEnd = capacity - after;
+    t->capacity = capacity;
+    t->buffer[capacity] = '\0';
+    return true;
+}
+
+static void _rayui_TextInputMoveGap(RAYUI_WITH_PREFIX(TextInput)* t, int pos) {
+    if (pos < t->gapStart) {
+        int n = t->gapStart - pos;
+        memmove(t->buffer + t->gapEnd - n, t->buffer + pos, n);
+        t->gapStart -= n;
+        t->gapEnd -= n;
+    } else if (pos > t->gapStart) {
+        int n = pos - t->gapStart;
+        memmove(t->buffer + t->gapStart, t->buffer + t->gapEnd, n);
+        t->gapStart += n;
+        t->gapEnd += n;
+    }
+}
+
+static void _rayui_TextInputErase(RAYUI_WITH_PREFIX(TextInput)* t, int from, int to) {
+    if (to <= from) return;
+    _rayui_TextInputMoveGap(t, from);
+    if (t->widthsValid > from) t->widthsValid = from;
+    t->gapEnd += to - from;
+    t->length -= to - from;
+    t->caret = t->anchor = from;
+}
+
+static bool _rayui_TextInputDeleteSelection(RAYUI_WITH_PREFIX(TextInput)* t) {
+    if (t->anchor == t->caret) return false;
+    int from = t->anchor < t->caret ? t->anchor : t->caret;
+    int to = t->anchor < t->caret ? t->caret : t->anchor;
+    _rayui_TextInputErase(t, from, to);
+    return true;
+}
+
+// Replaces the selection (if any) with text and puts the caret after it
+static void _rayui_TextInputInsert(RAYUI_WITH_PREFIX(TextInput)* t, const char* text, int bytes) {
+    if (!_rayui_TextInputReserve(t, bytes)) return;
+    _rayui_TextInputDeleteSelection(t);
+    _rayui_TextInputMoveGap(t, t->caret);
+    if (t->widthsValid > t->caret) t->widthsValid = t->caret;
+    memcpy(t->buffer + t->gapStart, text, bytes);
+    t->gapStart += bytes;
+    t->length += bytes;
+    t->caret = t->anchor = t->caret + bytes;
+}
+
+static void _rayui_InitTextInput(RAYUI_WITH_PREFIX(TextInput)* t, int x, int y, int width, int height, const char* initial, RAYUI_WITH_PREFIX(InputType) type) {
+    t->rect = (Rectangle){x, y, width, height};
+    t->focused = false;
+    t->cleared = false;
+    t->hovered = false;
+    t->blinkStart = 0;
+    t->inputType = type;
+    t->hover.hoverInfo = NULL;
+    t->hover.hoverStartTime = 0;
+    t->hover.hovered = false;
+    t->hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    t->hover.active = false;
+    t->hover.handle = 0;
+    t->hover.hitHandle = 0;
+    t->backspaceTimer = 0;
+    t->backspacePressed = false;
+    t->backspaceHoldTime = 0;
+    t->scrollX = 0;
+    t->widths = NULL;
+    t->glyphs = NULL;
+    t->widthsCapacity = 0;
+    t->widthsValid = 0;
+    t->widthsFont = 0;
+    t->widthsSize = 0;
+
+    int length = initial ? (int)strlen(initial) : 0;
+    t->capacity = length + _RAYUI_TEXT_INPUT_MIN_CAPACITY;
+    t->buffer = (char*)RAYUI_MALLOC(t->capacity + 1);
+    if (t->buffer) t->buffer[t->capacity] = '\0';
+    else t->capacity = 0; // the insert below retries the allocation
+    t->gapStart = 0;
+    t->gapEnd = t->capacity;
+    t->length = 0;
+    t->caret = t->anchor = 0;
+    _rayui_TextInputInsert(t, initial ? initial : "", length);
+}
+
+RAYUI_WITH_PREFIX(TextInput) RAYUI_WITH_PREFIX(CreateTextInput)(int x, int y, int width, int height, const char* initial, RAYUI_WITH_PREFIX(InputType) type) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(TextInput) t;
+    _rayui_InitTextInput(&t, x, y, width, height, initial, type);
+    t.hoverSound = ctx->defaultSound;
+    t.clickSound = ctx->defaultSound;
+    return t;
+}
+
+RAYUI_WITH_PREFIX(TextInput) RAYUI_WITH_PREFIX(CreateTextInputWithSound)(int x, int y, int width, int height, const char* initial, RAYUI_WITH_PREFIX(InputType) type, Sound hoverSound, Sound clickSound) {
+    RAYUI_WITH_PREFIX(TextInput) t;
+    _rayui_InitTextInput(&t, x, y, width, height, initial, type);
+    t.hoverSound = hoverSound;
+    t.clickSound = clickSound;
+    return t;
+}
+
+void RAYUI_WITH_PREFIX(FreeTextInput)(RAYUI_WITH_PREFIX(TextInput)* t) {
+    RAYUI_FREE(t->buffer);
+    RAYUI_FREE(t->widths);
+    RAYUI_FREE(t->glyphs);
+    t->buffer = NULL;
+    t->widths = NULL;
+    t->glyphs = NULL;
+    t->capacity = t->gapStart = t->gapEnd = t->length = 0;
+    t->caret = t->anchor = 0;
+    t->widthsCapacity = t->widthsValid = 0;
+}
+
+// Prefix widths of the text, including the 1px draw spacing after each
+// codepoint; continuation bytes share the offset of their lead byte. Each
+// codepoint is decoded and looked up in the font once, and the glyph index is
+// kept for drawing. Edits only invalidate the entries after the edit point,
+// so typing measures one glyph rather than the whole text. NULL when out of
+// memory
+static const float* _rayui_TextInputWidths(RAYUI_WITH_PREFIX(TextInput)* t, Font font, int fontSize) {
+    if (t->widthsFont != font.texture.id || t->widthsSize != fontSize) {
+        t->widthsFont = font.texture.id;
+        t->widthsSize = (float)fontSize;
+        t->widthsValid = 0;
+    }
+    if (t->length + 1 > t->widthsCapacity) {
+        int capacity = t->widthsCapacity ? t->widthsCapacity * 2 : 64;
+        while (capacity < t->length + 1) capacity *= 2;
+        float* widths = (float*)RAYUI_REALLOC(t->widths, capacity * sizeof(float));
+        if (!widths) return NULL;
+        t->widths = widths;
+        int* glyphs = (int*)RAYUI_REALLOC(t->glyphs, capacity * sizeof(int));
+        if (!glyphs) return NULL; // widths grew, but only widthsCapacity entries count
+        t->glyphs = glyphs;
+        t->widthsCapacity = capacity;
+    }
+
+    float scale = font.baseSize > 0 ? fontSize / (float)font.baseSize : 1;
+    t->widths[0] = 0;
+    for (int i = t->widthsValid; i < t->length; ) {
+        int next = _rayui_TextInputNext(t, i);
+        int codepoint = '*';
+        if (t->inputType != INPUT_TYPE_PASSWORD)
+            codepoint = _rayui_DecodeUTF8((const unsigned char*)t->buffer + (i < t->gapStart ? i : i + t->gapEnd - t->gapStart), next - i);
+
+        float advance;
+        int index = -1;
+        if (font.glyphs) {
+            index = GetGlyphIndex(font, codepoint);
+            advance = (font.glyphs[index].advanceX ? font.glyphs[index].advanceX : font.recs[index].width + font.glyphs[index].offsetX) * scale;
+        } else {
+            char utf8[5];
+            utf8[_rayui_EncodeUTF8(codepoint, utf8)] = '\0';
+            advance = RAYUI_WITH_PREFIX(MeasureTextCached)(font, utf8, fontSize, 1).x;
+        }
+
+        for (int j = i; j < next; j++) {
+            t->widths[j + 1] = t->widths[i];
+            t->glyphs[j] = -1;
+        }
+        t->glyphs[i] = index;
+        t->widths[next] = t->widths[i] + advance + 1;
+        i = next;
+    }
+    t->widthsValid = t->length;
+    return t->widths;
+}
+
+// Byte offset nearest to x, measured from the start of the text. Uses the
+// widths of the last draw; before the first draw everything maps to the end
+static int _rayui_TextInputOffsetAt(RAYUI_WITH_PREFIX(TextInput)* t, float x) {
+    if (!t->widths || t->widthsValid < t->length) return t->length;
+    int lo = 0, hi = t->length;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if ((t->widths[mid] + t->widths[mid + 1]) / 2 < x) lo = mid + 1;
+        else hi = mid;
+    }
+    return _rayui_TextInputBoundary(t, lo);
+}
+
+void RAYUI_WITH_PREFIX(UpdateTextInput)(RAYUI_WITH_PREFIX(TextInput)* t) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_INPUT);
+    RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)(t, _rayui_MousePosition());
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_INPUT, false);
+}
+
+// Backspace and Delete remove the selection, or one codepoint before/after the caret
+static void _rayui_TextInputDelete(RAYUI_WITH_PREFIX(TextInput)* t, bool forward) {
+    if (_rayui_TextInputDeleteSelection(t)) return;
+    if (forward) _rayui_TextInputErase(t, t->caret, _rayui_TextInputNext(t, t->caret));
+    else _rayui_TextInputErase(t, _rayui_TextInputPrev(t, t->caret), t->caret);
+}
+
+void RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)(RAYUI_WITH_PREFIX(TextInput)* t, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_INPUT);
+    t->hovered = _rayui_HitTest(&t->hover, t->rect, mousePoint) && CheckCollisionPointRec(mousePoint, t->rect);
+    t->hover.hovered = t->hovered;
+    _rayui_SyncHover(&t->hover);
+
+    if (t->hover.hovered && t->hover.hoverStartTime == 0 && t->hover.active) {
+        t->hover.hoverStartTime = _rayui_Time();
+        if (t->hoverSound.frameCount > 0) _rayui_PlaySound(t->hoverSound);
+    }
+
+    if (!t->hover.hovered)
+        t->hover.hoverStartTime = 0;
+
+    if (_rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        t->focused = t->hovered;
+        if (t->focused) {
+            t->cleared = false;
+            t->caret = t->anchor = _rayui_TextInputOffsetAt(t, mousePoint.x - (t->rect.x + 8) + t->scrollX);
+            t->blinkStart = _rayui_Time();
+            if (t->clickSound.frameCount > 0 && t->hover.active) _rayui_PlaySound(t->clickSound);
+        }
+    }
+
+    if (t->focused) {
+        int caretBefore = t->caret, lengthBefore = t->length;
+        int key, cursor = 0;
+        while ((key = _rayui_NextCharPressed(&cursor)) > 0) {
+            if (!t->cleared) { _rayui_TextInputErase(t, 0, t->length); t->cleared = true; }
+
+            if ((t->inputType == INPUT_TYPE_INT && (key < '0' || key > '9')) ||
+                (t->inputType == INPUT_TYPE_FLOAT && (key < '0' || key > '9') && key != '.')) continue;
+
+            char utf8[4];
+            _rayui_TextInputInsert(t, utf8, _rayui_EncodeUTF8(key, utf8));
+        }
+
+        // Caret movement and selection; moving the caret keeps the current text
+        bool shift = _rayui_KeyDown(KEY_LEFT_SHIFT) || _rayui_KeyDown(KEY_RIGHT_SHIFT);
+        bool ctrl = _rayui_KeyDown(KEY_LEFT_CONTROL) || _rayui_KeyDown(KEY_RIGHT_CONTROL);
+        int caret = t->caret;
+        bool moved = true;
+        if (_rayui_KeyPressed(KEY_LEFT)) {
+            if (t->anchor != t->caret && !shift) caret = t->anchor < t->caret ? t->anchor : t->caret;
+            else caret = _rayui_TextInputPrev(t, caret);
+        } else if (_rayui_KeyPressed(KEY_RIGHT)) {
+            if (t->anchor != t->caret && !shift) caret = t->anchor > t->caret ? t->anchor : t->caret;
+            else caret = _rayui_TextInputNext(t, caret);
+        } else if (_rayui_KeyPressed(KEY_HOME)) {
+            caret = 0;
+        } else if (_rayui_KeyPressed(KEY_END)) {
+            caret = t->length;
+        } else if (ctrl && _rayui_KeyPressed(KEY_A)) {
+            t->anchor = 0;
+            caret = t->length;
+            shift = true;
+        } else {
+            moved = false;
+        }
+        if (moved) {
+            t->cleared = true;
+            t->caret = caret;
+            if (!shift) t->anchor = caret;
+        }
+
+        if (_rayui_KeyPressed(KEY_DELETE)) {
+            t->cleared = true;
+            _rayui_TextInputDelete(t, true);
+        }
+
+        const float initialHoldThreshold = 0.3f;
+        const float backspaceCooldown = 0.02f;
+        float currentTime = _rayui_Time();
+
+        if (_rayui_KeyDown(KEY_BACKSPACE)) {
+            if (!t->backspacePressed) {
+                _rayui_TextInputDelete(t, false);
+                t->backspacePressed = true;
+                t->backspaceHoldTime = currentTime;
+                t->backspaceTimer = currentTime;
+            } else {
+                float heldTime = currentTime - t->backspaceHoldTime;
+                if (heldTime > initialHoldThreshold) {
+                    if (currentTime - t->backspaceTimer >= backspaceCooldown) {
+                        _rayui_TextInputDelete(t, false);
+                        t->backspaceTimer = currentTime;
+                    }
+                }
+            }
+        } else {
+            t->backspacePressed = false;
+            t->backspaceHoldTime = 0;
+            t->backspaceTimer = 0;
+        }
+
+        if (t->caret != caretBefore || t->length != lengthBefore) t->blinkStart = _rayui_Time();
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_INPUT, false);
+}
+
+void RAYUI_WITH_PREFIX(DrawTextInput)(RAYUI_WITH_PREFIX(TextInput)* t, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_INPUT);
+    Color textColorI = (t->hovered || t->focused) ? textHoverColor : textColor;
+    _rayui_DrawRectangleRec(t->rect, bgColor);
+
+    Rectangle inner = { t->rect.x + 8, t->rect.y, t->rect.width - 16, t->rect.height };
+    const float* widths = _rayui_TextInputWidths(t, font, fontSize);
+    if (!widths) { // out of memory, only the box is drawn this frame
+        _RAYUI_STATS_END(WIDGET_TYPE_TEXT_INPUT, true);
+        return;
+    }
+    float caretWidth = RAYUI_WITH_PREFIX(MeasureTextCached)(font, "_", fontSize, 1).x;
+
+    // Keep the caret in view without scrolling past the end of the text
+    float caretX = widths[t->caret];
+    if (caretX + caretWidth - t->scrollX > inner.width) t->scrollX = caretX + caretWidth - inner.width;
+    if (caretX < t->scrollX) t->scrollX = caretX;
+    if (t->scrollX > widths[t->length] + caretWidth - inner.width) t->scrollX = widths[t->length] + caretWidth - inner.width;
+    if (t->scrollX < 0) t->scrollX = 0;
+
+    // Only the bytes inside the box are submitted
+    int first = _rayui_TextInputOffsetAt(t, t->scrollX);
+    if (widths[first] > t->scrollX) first = _rayui_TextInputPrev(t, first);
+    int last = _rayui_TextInputNext(t, _rayui_TextInputOffsetAt(t, t->scrollX + inner.width));
+
+    Vector2 origin = { inner.x - t->scrollX, t->rect.y + (t->rect.height - fontSize)/2 };
+    _rayui_BeginScissor(inner);
+
+    if (font.glyphs) {
+        // Glyphs are drawn straight from the indices cached with the widths
+        bool sdf = _rayui_BeginSDF(font);
+        for (int i = first; i < last; i = _rayui_TextInputNext(t, i)) {
+            _rayui_DrawGlyph(font, t->glyphs[i], (Vector2){ origin.x + widths[i], origin.y }, fontSize, textColorI);
+        }
+        _rayui_EndSDF(sdf);
+    } else if (t->inputType == INPUT_TYPE_PASSWORD) {
+        // Masked text is drawn in fixed runs of a constant string, one star per codepoint
+        static const char stars[] = "****************************************************************";
+        const int run = (int)sizeof(stars) - 1;
+        for (int i = first; i < last; ) {
+            int n = 0, next = i;
+            while (next < last && n < run) { next = _rayui_TextInputNext(t, next); n++; }
+            _rayui_DrawTextEx(font, stars + run - n, (Vector2){ origin.x + widths[i], origin.y }, fontSize, 1, textColorI);
+            i = next;
+        }
+    } else {
+        // The range is drawn in place, as up to two pieces around the gap
+        for (int from = first; from < last; ) {
+            int to = (from < t->gapStart && last > t->gapStart) ? t->gapStart : last;
+            char* start = t->buffer + (from < t->gapStart ? from : from + t->gapEnd - t->gapStart);
+            char* end = start + (to - from);
+            char saved = *end;
+            *end = '\0';
+            _rayui_DrawTextEx(font, start, (Vector2){ origin.x + widths[from], origin.y }, fontSize, 1, textColorI);
+            *end = saved;
+            from = to;
+        }
+    }
+
+    if (t->focused && t->anchor != t->caret) {
+        float a = widths[t->anchor], c = widths[t->caret];
+        Rectangle selection = { origin.x + (a < c ? a : c), origin.y, fabsf(c - a), (float)fontSize };
+        _rayui_DrawRectangleRec(selection, (Color){ textColorI.r, textColorI.g, textColorI.b, textColorI.a / 3 });
+    }
+
+    if (t->focused && fmod(_rayui_Time() - t->blinkStart, 1.0) < 0.5) {
+        _rayui_DrawTextEx(font, "_", (Vector2){ origin.x + caretX, origin.y }, fontSize, 1, textColorI);
+    }
+
+    _rayui_EndScissor();
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_INPUT, true);
+}
+
+// Closes the gap at the end of the text so it reads as one C string
+const char* RAYUI_WITH_PREFIX(TextInputValue)(RAYUI_WITH_PREFIX(TextInput)* t) {
+    if (!t->buffer) return ""; // freed
+    _rayui_TextInputMoveGap(t, t->length);
+    t->buffer[t->length] = '\0';
+    return t->buffer;
+}
+
+int RAYUI_WITH_PREFIX(GetTextInputLength)(RAYUI_WITH_PREFIX(TextInput)* t) {
+    return t->length;
+}
+
+void RAYUI_WITH_PREFIX(SetTextInputValue)(RAYUI_WITH_PREFIX(TextInput)* t, const char* value) {
+    t->gapStart = 0;
+    t->gapEnd = t->capacity;
+    t->length = 0;
+    t->caret = t->anchor = 0;
+    t->widthsValid = 0;
+    t->scrollX = 0;
+    _rayui_TextInputInsert(t, value, (int)strlen(value));
+}
+
+void RAYUI_WITH_PREFIX(SetTextInputCaret)(RAYUI_WITH_PREFIX(TextInput)* t, int caret) {
+    t->caret = t->anchor = _rayui_TextInputBoundary(t, caret);
+}
+
+void RAYUI_WITH_PREFIX(SetTextInputSelection)(RAYUI_WITH_PREFIX(TextInput)* t, int start, int end) {
+    t->anchor = _rayui_TextInputBoundary(t, start);
+    t->caret = _rayui_TextInputBoundary(t, end);
+}
+
+void RAYUI_WITH_PREFIX(InsertTextInput)(RAYUI_WITH_PREFIX(TextInput)* t, const char* text) {
+    _rayui_TextInputInsert(t, text, (int)strlen(text));
+    t->cleared = true;
+}
+
+// ---------------- PIECE TABLE ----------------
+// TextArea text is a piece table: loaded text lives in a read-only original
+// buffer, everything inserted later is appended to an add buffer, and the
+// document is a sequence of pieces pointing into either one. Pieces sit in a
+// treap ordered by position, every node caching the byte and line break
+// totals of its subtree, so finding an offset or a line and cutting or
+// joining pieces is O(log n). Each buffer also keeps the sorted offsets of
+// its '\n' bytes, which tells how many breaks a piece holds, and where its
+// k-th one is, by binary search instead of scanning the text.
+
+typedef struct _rayui_TextBuffer {
+    char* data;
+    int size;
+    int capacity;
+    int* breaks; // offsets of '\n' bytes, ascending
+    int breakCount;
+    int breakCapacity;
+} _rayui_TextBuffer;
+
+typedef struct _rayui_PieceNode {
+    int left, right;       // -1 when absent; left doubles as the free list link
+    unsigned int priority;
+    int buffer;            // 0 original, 1 add
+    int start, length;     // byte range in the buffer
+    int breaks;            // '\n' bytes in the piece
+    int size, lines;       // bytes and breaks in the subtree
+} _rayui_PieceNode;
+
+struct _rayui_PieceTable {
+    _rayui_TextBuffer buffers[2];
+    _rayui_PieceNode* nodes;
+    int nodeCount;
+    int nodeCapacity;
+    int freeNode;
+    int root;
+    unsigned int seed;
+};
+
+// Records the line breaks in data[from, size). False when out of memory,
+// with only the breaks found so far recorded
+static bool _rayui_TextBufferScan(_rayui_TextBuffer* b, int from) {
+    if (from >= b->size) return true; // nothing new, and data may still be NULL
+    const char* end = b->data + b->size;
+    for (const char* p = b->data + from; p < end && (p = (const char*)memchr(p, '\n', end - p)) != NULL; p++) {
+        if (b->breakCount == b->breakCapacity) {
+            int capacity = b->breakCapacity ? b->breakCapacity * 2 : 256;
+            int* breaks = (int*)RAYUI_REALLOC(b->breaks, capacity * sizeof(int));
+            if (!breaks) return false;
+            b->breaks = breaks;
+            b->breakCapacity = capacity;
+        }
+        b->breaks[b->breakCount++] = (int)(p - b->data);
+    }
+    return true;
+}
+
+// False when out of memory, the buffer is then left as it was
+static bool _rayui_TextBufferAppend(_rayui_TextBuffer* b, const char* text, int bytes) {
+    if (bytes <= 0) return true;
+    if (b->size + bytes > b->capacity) {
+        int capacity = b->capacity ? b->capacity : 4096;
+        while (capacity < b->size + bytes) capacity *= 2;
+        char* data = (char*)RAYUI_REALLOC(b->data, capacity);
+        if (!data) return false;
+        b->data = data;
+        b->capacity = capacity;
+    }
+    int breakCount = b->breakCount;
+    memcpy(b->data + b->size, text, bytes);
+    b->size += bytes;
+    if (!_rayui_TextBufferScan(b, b->size - bytes)) {
+        b->size -= bytes;
+        b->breakCount = breakCount;
+        return false;
+    }
+    return true;
+}
+
+// Index of the first break at or after offset
+static int _rayui_TextBufferBreakAt(const _rayui_TextBuffer* b, int offset) {
+    int lo = 0, hi = b->breakCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (b->breaks[mid] < offset) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int _rayui_TextBufferCountBreaks(const _rayui_TextBuffer* b, int start, int length) {
+    return _rayui_TextBufferBreakAt(b, start + length) - _rayui_TextBufferBreakAt(b, start);
+}
+
+static inline int _rayui_PieceSize(const struct _rayui_PieceTable* pt, int n) { return n < 0 ? 0 : pt->nodes[n].size; }
+static inline int _rayui_PieceLines(const struct _rayui_PieceTable* pt, int n) { return n < 0 ? 0 : pt->nodes[n].lines; }
+
+static void _rayui_PieceUpdate(struct _rayui_PieceTable* pt, int n) {
+    _rayui_PieceNode* node = &pt->nodes[n];
+    node->size = _rayui_PieceSize(pt, node->left) + node->length + _rayui_PieceSize(pt, node->right);
+    node->lines = _rayui_PieceLines(pt, node->left) + node->breaks + _rayui_PieceLines(pt, node->right);
+}
+
+// Makes room for `count` more nodes up front, so an edit can't run out of
+// memory halfway through reshaping the tree
+static bool _rayui_PieceReserve(struct _rayui_PieceTable* pt, int count) {
+    if (pt->nodeCount + count <= pt->nodeCapacity) return true;
+    int capacity = pt->nodeCapacity ? pt->nodeCapacity * 2 : 64;
+    while (capacity < pt->nodeCount + count) capacity *= 2;
+    _rayui_PieceNode* nodes = (_rayui_PieceNode*)RAYUI_REALLOC(pt->nodes, capacity * sizeof(_rayui_PieceNode));
+    if (!nodes) return false;
+    pt->nodes = nodes;
+    pt->nodeCapacity = capacity;
+    return true;
+}
+
+// Callers reserve the node first
+static int _rayui_PieceAlloc(struct _rayui_PieceTable* pt, int buffer, int start, int length, unsigned int priority) {
+    int n;
+    if (pt->freeNode >= 0) {
+        n = pt->freeNode;
+        pt->freeNode = pt->nodes[n].left;
+    } else {
+        n = pt->nodeCount++;
+    }
+    _rayui_PieceNode* node = &pt->nodes[n];
+    node->left = node->right = -1;
+    node->priority = priority;
+    node->buffer = buffer;
+    node->start = start;
+    node->length = length;
+    node->breaks = _rayui_TextBufferCountBreaks(&pt->buffers[buffer], start, length);
+    _rayui_PieceUpdate(pt, n);
+    return n;
+}
+
+static unsigned int _rayui_PieceRandom(struct _rayui_PieceTable* pt) {
+    pt->seed ^= pt->seed << 13;
+    pt->seed ^= pt->seed >> 17;
+    pt->seed ^= pt->seed << 5;
+    return pt->seed;
+}
+
+static void _rayui_PieceRelease(struct _rayui_PieceTable* pt, int n) {
+    if (n < 0) return;
+    _rayui_PieceRelease(pt, pt->nodes[n].left);
+    _rayui_PieceRelease(pt, pt->nodes[n].right);
+    pt->nodes[n].left = pt->freeNode;
+    pt->freeNode = n;
+}
+
+// Splits subtree n into the first `offset` bytes and the rest, cutting the
+// piece that straddles offset in two
+static void _rayui_PieceSplit(struct _rayui_PieceTable* pt, int n, int offset, int* l, int* r) {
+    if (n < 0) { *l = *r = -1; return; }
+    int leftSize = _rayui_PieceSize(pt, pt->nodes[n].left);
+    int length = pt->nodes[n].length;
+    if (offset <= leftSize) {
+        int child;
+        _rayui_PieceSplit(pt, pt->nodes[n].left, offset, l, &child);
+        pt->nodes[n].left = child;
+        _rayui_PieceUpdate(pt, n);
+        *r = n;
+    } else if (offset >= leftSize + length) {
+        int child;
+        _rayui_PieceSplit(pt, pt->nodes[n].right, offset - leftSize - length, &child, r);
+        pt->nodes[n].right = child;
+        _rayui_PieceUpdate(pt, n);
+        *l = n;
+    } else {
+        // The tail keeps the node's priority so it can take over its right subtree
+        int cut = offset - leftSize;
+        int tail = _rayui_PieceAlloc(pt, pt->nodes[n].buffer, pt->nodes[n].start + cut, length - cut, pt->nodes[n].priority);
+        _rayui_PieceNode* node = &pt->nodes[n];
+        pt->nodes[tail].right = node->right;
+        node->right = -1;
+        node->length = cut;
+        node->breaks = _rayui_TextBufferCountBreaks(&pt->buffers[node->buffer], node->start, cut);
+        _rayui_PieceUpdate(pt, tail);
+        _rayui_PieceUpdate(pt, n);
+        *l = n;
+        *r = tail;
+    }
+}
+
+static int _rayui_PieceMerge(struct _rayui_PieceTable* pt, int a, int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    if (pt->nodes[a].priority >= pt->nodes[b].priority) {
+        pt->nodes[a].right = _rayui_PieceMerge(pt, pt->nodes[a].right, b);
+        _rayui_PieceUpdate(pt, a);
+        return a;
+    }
+    pt->nodes[b].left = _rayui_PieceMerge(pt, a, pt->nodes[b].left);
+    _rayui_PieceUpdate(pt, b);
+    return b;
+}
+
+// Replaces the document with a new original buffer, whose data is `data`
+// when given (taking ownership) or a copy of `text` otherwise. The buffer is
+// built before the old one is dropped; false when out of memory, the
+// document is then left as it was
+static bool _rayui_PieceTableReset(struct _rayui_PieceTable* pt, char* data, const char* text, int bytes) {
+    _rayui_TextBuffer original = {0};
+    if (data) {
+        original.data = data;
+        original.size = original.capacity = bytes;
+    }
+    bool ok = (pt->nodeCapacity > 0 || _rayui_PieceReserve(pt, 1)) &&
+              (data ? _rayui_TextBufferScan(&original, 0) : _rayui_TextBufferAppend(&original, text, bytes));
+    if (!ok) {
+        RAYUI_FREE(original.data);
+        RAYUI_FREE(original.breaks);
+        return false;
+    }
+
+    RAYUI_FREE(pt->buffers[0].data);
+    RAYUI_FREE(pt->buffers[0].breaks);
+    pt->buffers[0] = original;
+    pt->buffers[1].size = pt->buffers[1].breakCount = 0;
+    pt->nodeCount = 0;
+    pt->freeNode = -1;
+    pt->root = -1;
+    if (bytes > 0) pt->root = _rayui_PieceAlloc(pt, 0, 0, bytes, _rayui_PieceRandom(pt));
+    return true;
+}
+
+static void _rayui_PieceTableFree(struct _rayui_PieceTable* pt) {
+    if (!pt) return;
+    for (int i = 0; i < 2; i++) {
+        RAYUI_FREE(pt->buffers[i].data);
+        RAYUI_FREE(pt->buffers[i].breaks);
+    }
+    RAYUI_FREE(pt->nodes);
+    RAYUI_FREE(pt);
+}
+
+// NULL when out of memory
+static struct _rayui_PieceTable* _rayui_PieceTableCreate(const char* text, int bytes) {
+    struct _rayui_PieceTable* pt = (struct _rayui_PieceTable*)RAYUI_CALLOC(1, sizeof(*pt));
+    if (!pt) return NULL;
+    pt->seed = 2463534242u;
+    pt->freeNode = pt->root = -1;
+    if (!_rayui_PieceTableReset(pt, NULL, text, bytes)) {
+        _rayui_PieceTableFree(pt);
+        return NULL;
+    }
+    return pt;
+}
+
+static inline int _rayui_PieceTableLength(const struct _rayui_PieceTable* pt) {
+    return _rayui_PieceSize(pt, pt->root);
+}
+
+static inline int _rayui_PieceTableLineCount(const struct _rayui_PieceTable* pt) {
+    return _rayui_PieceLines(pt, pt->root) + 1;
+}
+
+// Grows the last piece of subtree n by `bytes` holding `breaks` line breaks
+static void _rayui_PieceExtendLast(struct _rayui_PieceTable* pt, int n, int bytes, int breaks) {
+    for (; n >= 0; n = pt->nodes[n].right) {
+        pt->nodes[n].size += bytes;
+        pt->nodes[n].lines += breaks;
+        if (pt->nodes[n].right < 0) {
+            pt->nodes[n].length += bytes;
+            pt->nodes[n].breaks += breaks;
+        }
+    }
+}
+
+// Inserting takes at most two nodes: the tail of a split piece and the new
+// one. False when out of memory, the document is then left as it was
+static bool _rayui_PieceTableInsert(struct _rayui_PieceTable* pt, int offset, const char* text, int bytes) {
+    if (bytes <= 0) return true;
+    _rayui_TextBuffer* add = &pt->buffers[1];
+    int start = add->size;
+    int breaksBefore = add->breakCount;
+    if (!_rayui_PieceReserve(pt, 2) || !_rayui_TextBufferAppend(add, text, bytes)) return false;
+
+    int l, r;
+    _rayui_PieceSplit(pt, pt->root, offset, &l, &r);
+
+    // Typing appends to the add buffer right after the previous insert, so
+    // the piece before the caret usually just grows
+    int last = l;
+    while (last >= 0 && pt->nodes[last].right >= 0) last = pt->nodes[last].right;
+    if (last >= 0 && pt->nodes[last].buffer == 1 && pt->nodes[last].start + pt->nodes[last].length == start) {
+        _rayui_PieceExtendLast(pt, l, bytes, add->breakCount - breaksBefore);
+    } else {
+        l = _rayui_PieceMerge(pt, l, _rayui_PieceAlloc(pt, 1, start, bytes, _rayui_PieceRandom(pt)));
+    }
+    pt->root = _rayui_PieceMerge(pt, l, r);
+    return true;
+}
+
+// Each of the two splits may cut a piece in two
+static bool _rayui_PieceTableDelete(struct _rayui_PieceTable* pt, int offset, int bytes) {
+    if (bytes <= 0) return true;
+    if (!_rayui_PieceReserve(pt, 2)) return false;
+    int l, m, r;
+    _rayui_PieceSplit(pt, pt->root, offset, &l, &m);
+    _rayui_PieceSplit(pt, m, bytes, &m, &r);
+    _rayui_PieceRelease(pt, m);
+    pt->root = _rayui_PieceMerge(pt, l, r);
+    return true;
+}
+
+// Byte offset where line `line` (0 based) starts
+static int _rayui_PieceTableLineStart(const struct _rayui_PieceTable* pt, int line) {
+    if (line <= 0) return 0;
+    if (line > _rayui_PieceLines(pt, pt->root)) return _rayui_PieceTableLength(pt);
+    int n = pt->root, base = 0;
+    while (n >= 0) {
+        const _rayui_PieceNode* node = &pt->nodes[n];
+        int leftLines = _rayui_PieceLines(pt, node->left);
+        if (line <= leftLines) { n = node->left; continue; }
+        line -= leftLines;
+        base += _rayui_PieceSize(pt, node->left);
+        if (line <= node->breaks) {
+            const _rayui_TextBuffer* b = &pt->buffers[node->buffer];
+            int at = b->breaks[_rayui_TextBufferBreakAt(b, node->start) + line - 1];
+            return base + (at - node->start) + 1;
+        }
+        line -= node->breaks;
+        base += node->length;
+        n = node->right;
+    }
+    return _rayui_PieceTableLength(pt);
+}
+
+// Line (0 based) holding byte offset
+static int _rayui_PieceTableLineOf(const struct _rayui_PieceTable* pt, int offset) {
+    int n = pt->root, line = 0;
+    while (n >= 0) {
+        const _rayui_PieceNode* node = &pt->nodes[n];
+        int leftSize = _rayui_PieceSize(pt, node->left);
+        if (offset < leftSize) { n = node->left; continue; }
+        line += _rayui_PieceLines(pt, node->left);
+        offset -= leftSize;
+        if (offset < node->length) return line + _rayui_TextBufferCountBreaks(&pt->buffers[node->buffer], node->start, offset);
+        line += node->breaks;
+        offset -= node->length;
+        n = node->right;
+    }
+    return line;
+}
+
+// Copies bytes [from, to) of subtree n, whose first byte is at `base`
+static void _rayui_PieceCopy(const struct _rayui_PieceTable* pt, int n, int base, int from, int to, char* out) {
+    while (n >= 0 && from < to) {
+        const _rayui_PieceNode* node = &pt->nodes[n];
+        int leftSize = _rayui_PieceSize(pt, node->left);
+        int start = base + leftSize, end = start + node->length;
+        if (from < start) _rayui_PieceCopy(pt, node->left, base, from, to < start ? to : start, out);
+        if (from < end && to > start) {
+            int a = from > start ? from : start, b = to < end ? to : end;
+            memcpy(out + (a - from), pt->buffers[node->buffer].data + node->start + (a - start), b - a);
+        }
+        if (to <= end) return;
+        // Continue right without recursing; the output pointer follows
+        if (from < end) { out += end - from; from = end; }
+        base = end;
+        n = node->right;
+    }
+}
+
+static int _rayui_PieceTableCopy(const struct _rayui_PieceTable* pt, int from, int to, char* out) {
+    int length = _rayui_PieceTableLength(pt);
+    if (from < 0) from = 0;
+    if (to > length) to = length;
+    if (to <= from) return 0;
+    _rayui_PieceCopy(pt, pt->root, 0, from, to, out);
+    return to - from;
+}
+
+static int _rayui_PieceTableByte(const struct _rayui_PieceTable* pt, int offset) {
+    char c;
+    return _rayui_PieceTableCopy(pt, offset, offset + 1, &c) ? (unsigned char)c : -1;
+}
+
+// ---------------- TEXT AREA ----------------
+// Multi-line text over a piece table. Only the lines inside the rect are
+// drawn, and within each line only the bytes inside the horizontal scroll
+// window are read and submitted. Anchors remember the x of the caret and of
+// each drawn line's first visible column, so on a long line caret and scroll
+// math start near where they are needed instead of at the line start.
+
+#define _RAYUI_TEXT_AREA_PADDING 6
+#define _RAYUI_TEXT_AREA_SCROLLBAR 8
+#define _RAYUI_TEXT_AREA_WHEEL_LINES 3
+#define _RAYUI_TEXT_AREA_WINDOW 256 // bytes read at a time when measuring along a line
+
+static void _rayui_InitTextArea(RAYUI_WITH_PREFIX(TextArea)* a, int x, int y, int width, int height, const char* initial) {
+    memset(a, 0, sizeof(*a));
+    a->rect = (Rectangle){x, y, width, height};
+    a->text = _rayui_PieceTableCreate(initial ? initial : "", initial ? (int)strlen(initial) : 0);
+    a->preferredX = -1;
+    a->repeatKey = -1;
+    a->hover.delay = DEFAULT_HOVER_INFO_DELAY;
+}
+
+RAYUI_WITH_PREFIX(TextArea) RAYUI_WITH_PREFIX(CreateTextArea)(int x, int y, int width, int height, const char* initial) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    RAYUI_WITH_PREFIX(TextArea) a;
+    _rayui_InitTextArea(&a, x, y, width, height, initial);
+    a.hoverSound = ctx->defaultSound;
+    a.clickSound = ctx->defaultSound;
+    return a;
+}
+
+RAYUI_WITH_PREFIX(TextArea) RAYUI_WITH_PREFIX(CreateTextAreaWithSound)(int x, int y, int width, int height, const char* initial, Sound hoverSound, Sound clickSound) {
+    RAYUI_WITH_PREFIX(TextArea) a;
+    _rayui_InitTextArea(&a, x, y, width, height, initial);
+    a.hoverSound = hoverSound;
+    a.clickSound = clickSound;
+    return a;
+}
+
+static void _rayui_TextAreaForget(RAYUI_WITH_PREFIX(TextArea)* a) {
+    memset(&a->caretAnchor, 0, sizeof(a->caretAnchor));
+    memset(a->viewAnchors, 0, sizeof(a->viewAnchors));
+}
+
+void RAYUI_WITH_PREFIX(FreeTextArea)(RAYUI_WITH_PREFIX(TextArea)* a) {
+    _rayui_PieceTableFree(a->text);
+    RAYUI_FREE(a->scratch);
+    a->text = NULL;
+    a->scratch = NULL;
+    a->scratchCapacity = 0;
+    a->caret = 0;
+    _rayui_TextAreaForget(a);
+}
+
+// Gives a freed area an empty piece table again; false when out of memory
+static bool _rayui_TextAreaTable(RAYUI_WITH_PREFIX(TextArea)* a) {
+    if (!a->text) a->text = _rayui_PieceTableCreate("", 0);
+    return a->text != NULL;
+}
+
+// NULL when out of memory
+static char* _rayui_TextAreaScratch(RAYUI_WITH_PREFIX(TextArea)* a, int bytes) {
+    if (bytes + 1 > a->scratchCapacity) {
+        int capacity = a->scratchCapacity ? a->scratchCapacity : 1024;
+        while (capacity < bytes + 1) capacity *= 2;
+        char* scratch = (char*)RAYUI_REALLOC(a->scratch, capacity);
+        if (!scratch) return NULL;
+        a->scratch = scratch;
+        a->scratchCapacity = capacity;
+    }
+    return a->scratch;
+}
+
+static inline int _rayui_CodepointBytes(const char* p, const char* end) {
+    const char* q = p + 1;
+    while (q < end && (*q & 0xC0) == 0x80) q++;
+    return (int)(q - p);
+}
+
+// Advance of the codepoint at p including the 1px draw spacing. ASCII comes
+// from a per-area table filled on the first draw with each font/size
+static float _rayui_TextAreaAdvance(RAYUI_WITH_PREFIX(TextArea)* a, const char* p, int bytes) {
+    unsigned char c = (unsigned char)p[0];
+    if (bytes == 1 && c < 128) return a->advances[c];
+    char utf8[5];
+    memcpy(utf8, p, bytes < 4 ? bytes : 4);
+    utf8[bytes < 4 ? bytes : 4] = '\0';
+    return RAYUI_WITH_PREFIX(MeasureTextCached)(a->font, utf8, a->fontSize, 1).x + 1;
+}
+
+static int _rayui_TextAreaLineEnd(RAYUI_WITH_PREFIX(TextArea)* a, int line) {
+    if (line + 1 >= _rayui_PieceTableLineCount(a->text)) return _rayui_PieceTableLength(a->text);
+    return _rayui_PieceTableLineStart(a->text, line + 1) - 1;
+}
+
+static int _rayui_TextAreaPrev(RAYUI_WITH_PREFIX(TextArea)* a, int offset) {
+    if (offset <= 0) return 0;
+    offset--;
+    while (offset > 0 && (_rayui_PieceTableByte(a->text, offset) & 0xC0) == 0x80) offset--;
+    return offset;
+}
+
+static int _rayui_TextAreaNext(RAYUI_WITH_PREFIX(TextArea)* a, int offset) {
+    int length = _rayui_PieceTableLength(a->text);
+    if (offset >= length) return length;
+    offset++;
+    while (offset < length && (_rayui_PieceTableByte(a->text, offset) & 0xC0) == 0x80) offset++;
+    return offset;
+}
+
+// Adds up advances from byte `from` (at *x) towards `to`, stopping before the
+// first codepoint that would end past maxX. The text is read through a small
+// window, so a long line is never copied whole. Returns where it stopped
+static int _rayui_TextAreaWalk(RAYUI_WITH_PREFIX(TextArea)* a, int from, int to, float* x, float maxX) {
+    char window[_RAYUI_TEXT_AREA_WINDOW];
+    while (from < to) {
+        int n = _rayui_PieceTableCopy(a->text, from, to - from < (int)sizeof(window) ? to : from + (int)sizeof(window), window);
+        if (n <= 0) break;
+        const char* p = window, *end = window + n;
+        // A codepoint the window cuts off is read again from the next one
+        const char* stop = from + n < to ? end - 3 : end;
+        while (p < stop) {
+            int bytes = _rayui_CodepointBytes(p, end);
+            float advance = _rayui_TextAreaAdvance(a, p, bytes);
+            if (*x + advance > maxX) return from + (int)(p - window);
+            *x += advance;
+            p += bytes;
+        }
+        from += (int)(p - window);
+    }
+    return from;
+}
+
+// Walks back from byte `from` (at *x) towards `to`, taking advances off until
+// *x is at or before minX. Returns the codepoint start it stopped at
+static int _rayui_TextAreaWalkBack(RAYUI_WITH_PREFIX(TextArea)* a, int from, int to, float* x, float minX) {
+    char window[_RAYUI_TEXT_AREA_WINDOW];
+    while (from > to && *x > minX) {
+        int start = from - to > (int)sizeof(window) ? from - (int)sizeof(window) : to;
+        int n = _rayui_PieceTableCopy(a->text, start, from, window);
+        if (n <= 0) break;
+        const char* p = window + n;
+        while (p > window && *x > minX) {
+            const char* q = p - 1;
+            while (q > window && (*q & 0xC0) == 0x80) q--;
+            if ((*q & 0xC0) == 0x80 && start > to && p < window + n) break; // cut off, read again
+            *x -= _rayui_TextAreaAdvance(a, q, (int)(p - q));
+            p = q;
+        }
+        from = start + (int)(p - window);
+    }
+    return from;
+}
+
+// x of byte offset within its line, relative to the start of the line. It is
+// measured from the line start, the caret anchor or the line's view anchor,
+// whichever is nearest, and `keep` (if any) remembers the result
+static float _rayui_TextAreaOffsetX(RAYUI_WITH_PREFIX(TextArea)* a, int offset, struct _rayui_TextAreaAnchor* keep) {
+    if (!a->measured) return 0;
+    int line = _rayui_PieceTableLineOf(a->text, offset);
+    int lineStart = _rayui_PieceTableLineStart(a->text, line);
+    int column = offset - lineStart;
+    struct _rayui_TextAreaAnchor from = { line, 0, 0 };
+    const struct _rayui_TextAreaAnchor* known[2] = { &a->caretAnchor, &a->viewAnchors[line % RAYUI_TEXT_AREA_ANCHORS] };
+    for (int i = 0; i < 2; i++) {
+        if (known[i]->line == line && abs(known[i]->column - column) < abs(from.column - column)) from = *known[i];
+    }
+    float x = from.x;
+    if (from.column <= column) _rayui_TextAreaWalk(a, lineStart + from.column, offset, &x, MAX_FLOAT);
+    else _rayui_TextAreaWalkBack(a, lineStart + from.column, offset, &x, MIN_FLOAT);
+    if (keep) *keep = (struct _rayui_TextAreaAnchor){ line, column, x };
+    return x;
+}
+
+static inline float _rayui_TextAreaCaretX(RAYUI_WITH_PREFIX(TextArea)* a) {
+    return _rayui_TextAreaOffsetX(a, a->caret, &a->caretAnchor);
+}
+
+// Start of the codepoint under x in [lineStart, lineEnd) of `line`, or
+// lineEnd when x is past the text; *at receives its x. Walks from the known
+// anchor of the line nearest to x and leaves the result in `keep`
+static int _rayui_TextAreaSeek(RAYUI_WITH_PREFIX(TextArea)* a, int line, int lineStart, int lineEnd, float x, float* at, struct _rayui_TextAreaAnchor* keep) {
+    struct _rayui_TextAreaAnchor from = { line, 0, 0 };
+    const struct _rayui_TextAreaAnchor* known[2] = { &a->caretAnchor, &a->viewAnchors[line % RAYUI_TEXT_AREA_ANCHORS] };
+    for (int i = 0; i < 2; i++) {
+        if (known[i]->line == line && lineStart + known[i]->column <= lineEnd && fabsf(known[i]->x - x) < fabsf(from.x - x)) from = *known[i];
+    }
+    float fromX = from.x;
+    int offset = lineStart + from.column;
+    if (fromX <= x) offset = _rayui_TextAreaWalk(a, offset, lineEnd, &fromX, x);
+    else offset = _rayui_TextAreaWalkBack(a, offset, lineStart, &fromX, x);
+    *at = fromX;
+    if (keep) *keep = (struct _rayui_TextAreaAnchor){ line, offset - lineStart, fromX };
+    return offset;
+}
+
+// Byte offset in `line` closest to x (relative to the start of the line). The
+// caret goes there, so its anchor is moved along
+static int _rayui_TextAreaOffsetAt(RAYUI_WITH_PREFIX(TextArea)* a, int line, float x) {
+    int start = _rayui_PieceTableLineStart(a->text, line);
+    int end = _rayui_TextAreaLineEnd(a, line);
+    if (!a->measured) return start;
+    if (end > start && _rayui_PieceTableByte(a->text, end - 1) == '\r') end--;
+    float at;
+    int p = _rayui_TextAreaSeek(a, line, start, end, x, &at, &a->caretAnchor);
+    if (p >= end) return end;
+    float after = at;
+    int next = _rayui_TextAreaWalk(a, p, _rayui_TextAreaNext(a, p), &after, MAX_FLOAT);
+    return at + (after - at) / 2 > x ? p : next;
+}
+
+static int _rayui_TextAreaVisibleLines(RAYUI_WITH_PREFIX(TextArea)* a) {
+    int lines = (int)((a->rect.height - 2*_RAYUI_TEXT_AREA_PADDING) / a->lineHeight);
+    return lines > 1 ? lines : 1;
+}
+
+static void _rayui_ClampTextAreaScroll(RAYUI_WITH_PREFIX(TextArea)* a) {
+    float viewHeight = a->rect.height - 2*_RAYUI_TEXT_AREA_PADDING;
+    float maxY = _rayui_PieceTableLineCount(a->text) * a->lineHeight - viewHeight;
+    float viewWidth = a->rect.width - 2*_RAYUI_TEXT_AREA_PADDING - _RAYUI_TEXT_AREA_SCROLLBAR;
+    float maxX = a->contentWidth - viewWidth;
+    if (a->scrollY > maxY) a->scrollY = maxY;
+    if (a->scrollY < 0) a->scrollY = 0;
+    if (a->scrollX > maxX) a->scrollX = maxX;
+    if (a->scrollX < 0) a->scrollX = 0;
+}
+
+// The scrollbar is only shown when the text is taller than the area
+static bool _rayui_TextAreaScrollbar(RAYUI_WITH_PREFIX(TextArea)* a, Rectangle* track, Rectangle* thumb) {
+    float content = _rayui_PieceTableLineCount(a->text) * a->lineHeight;
+    float view = a->rect.height - 2*_RAYUI_TEXT_AREA_PADDING;
+    if (a->lineHeight <= 0 || content <= view) return false;
+    *track = (Rectangle){ a->rect.x + a->rect.width - _RAYUI_TEXT_AREA_SCROLLBAR, a->rect.y, _RAYUI_TEXT_AREA_SCROLLBAR, a->rect.height };
+    float height = track->height * view / content;
+    if (height < 16) height = 16;
+    float t = a->scrollY / (content - view);
+    *thumb = (Rectangle){ track->x, track->y + (track->height - height) * t, track->width, height };
+    return true;
+}
+
+void RAYUI_WITH_PREFIX(UpdateTextArea)(RAYUI_WITH_PREFIX(TextArea)* a) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_AREA);
+    RAYUI_WITH_PREFIX(UpdateTextAreaWithMousePoint)(a, _rayui_MousePosition());
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_AREA, false);
+}
+
+// Key pressed this frame, or held past the initial delay and due to repeat
+static bool _rayui_TextAreaKey(RAYUI_WITH_PREFIX(TextArea)* a, int key) {
+    const float initialHoldThreshold = 0.3f;
+    const float repeatCooldown = 0.03f;
+    float currentTime = _rayui_Time();
+    if (_rayui_KeyPressed(key)) {
+        a->repeatKey = key;
+        a->repeatStart = a->repeatTime = currentTime;
+        return true;
+    }
+    if (a->repeatKey != key || !_rayui_KeyDown(key)) return false;
+    if (currentTime - a->repeatStart > initialHoldThreshold && currentTime - a->repeatTime >= repeatCooldown) {
+        a->repeatTime = currentTime;
+        return true;
+    }
+    return false;
+}
+
+// Drops the anchors an edit at `offset` made stale: those past it on its line
+// and, when line breaks were added or removed, all on later lines
+static void _rayui_TextAreaEdited(RAYUI_WITH_PREFIX(TextArea)* a, int offset, bool breaks) {
+    int line = _rayui_PieceTableLineOf(a->text, offset);
+    int column = offset - _rayui_PieceTableLineStart(a->text, line);
+    for (int i = -1; i < RAYUI_TEXT_AREA_ANCHORS; i++) {
+        struct _rayui_TextAreaAnchor* anchor = i < 0 ? &a->caretAnchor : &a->viewAnchors[i];
+        if ((anchor->line == line && anchor->column > column) || (breaks && anchor->line > line))
+            memset(anchor, 0, sizeof(*anchor));
+    }
+}
+
+// Every edit goes through these two so the anchors stay valid
+static bool _rayui_TextAreaInsertAt(RAYUI_WITH_PREFIX(TextArea)* a, int offset, const char* text, int bytes) {
+    int lines = _rayui_PieceTableLineCount(a->text);
+    if (!_rayui_PieceTableInsert(a->text, offset, text, bytes)) return false;
+    _rayui_TextAreaEdited(a, offset, _rayui_PieceTableLineCount(a->text) != lines);
+    return true;
+}
+
+static bool _rayui_TextAreaDeleteAt(RAYUI_WITH_PREFIX(TextArea)* a, int offset, int bytes) {
+    int lines = _rayui_PieceTableLineCount(a->text);
+    if (!_rayui_PieceTableDelete(a->text, offset, bytes)) return false;
+    _rayui_TextAreaEdited(a, offset, _rayui_PieceTableLineCount(a->text) != lines);
+    return true;
+}
+
+static void _rayui_TextAreaInsert(RAYUI_WITH_PREFIX(TextArea)* a, const char* text, int bytes) {
+    if (!_rayui_TextAreaInsertAt(a, a->caret, text, bytes)) return;
+    a->caret += bytes;
+    a->preferredX = -1;
+    a->followCaret = true;
+}
+
+void RAYUI_WITH_PREFIX(UpdateTextAreaWithMousePoint)(RAYUI_WITH_PREFIX(TextArea)* a, Vector2 mousePoint) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_AREA);
+    if (!a->text) { // freed
+        _RAYUI_STATS_END(WIDGET_TYPE_TEXT_AREA, false);
+        return;
+    }
+    bool candidate = _rayui_HitTest(&a->hover, a->rect, mousePoint);
+    a->hovered = candidate && CheckCollisionPointRec(mousePoint, a->rect);
+    a->hover.hovered = a->hovered;
+    _rayui_SyncHover(&a->hover);
+
+    if (a->hover.hovered && a->hover.hoverStartTime == 0 && a->hover.active) {
+        a->hover.hoverStartTime = _rayui_Time();
+        if (a->hoverSound.frameCount > 0) _rayui_PlaySound(a->hoverSound);
+    }
+
+    if (!a->hover.hovered)
+        a->hover.hoverStartTime = 0;
+
+    Rectangle track, thumb;
+    bool scrollbar = a->lineHeight > 0 && _rayui_TextAreaScrollbar(a, &track, &thumb);
+    float content = _rayui_PieceTableLineCount(a->text) * a->lineHeight;
+    float view = a->rect.height - 2*_RAYUI_TEXT_AREA_PADDING;
 
-    if (t->hover.hovered && t->hover.hoverStartTime == 0 && t->hover.active) {
-        t->hover.hoverStartTime = GetTime();
-        if (t->hoverSound.frameCount > 0) PlaySound(t->hoverSound);
+    if (a->dragging) {
+        if (scrollbar && _rayui_MouseDown(MOUSE_LEFT_BUTTON)) {
+            float range = track.height - thumb.height;
+            float t = range > 0 ? (mousePoint.y - a->dragOffset - track.y) / range : 0;
+            a->scrollY = t * (content - view);
+            _rayui_ClampTextAreaScroll(a);
+        } else {
+            a->dragging = false;
+        }
+    } else if (_rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        a->focused = a->hovered;
+        if (a->focused) a->blinkStart = _rayui_Time();
+        if (a->focused && a->clickSound.frameCount > 0 && a->hover.active) _rayui_PlaySound(a->clickSound);
+        if (a->hovered && scrollbar && CheckCollisionPointRec(mousePoint, track)) {
+            // Grabbing the track outside the thumb jumps the thumb there
+            float grab = CheckCollisionPointRec(mousePoint, thumb) ? mousePoint.y - thumb.y : thumb.height / 2;
+            float range = track.height - thumb.height;
+            float t = range > 0 ? (mousePoint.y - grab - track.y) / range : 0;
+            a->dragging = true;
+            a->dragOffset = grab;
+            a->scrollY = t * (content - view);
+            _rayui_ClampTextAreaScroll(a);
+        } else if (a->hovered && a->lineHeight > 0) {
+            int line = (int)((mousePoint.y - a->rect.y - _RAYUI_TEXT_AREA_PADDING + a->scrollY) / a->lineHeight);
+            int lines = _rayui_PieceTableLineCount(a->text);
+            line = line < 0 ? 0 : line >= lines ? lines - 1 : line;
+            a->caret = _rayui_TextAreaOffsetAt(a, line, mousePoint.x - a->rect.x - _RAYUI_TEXT_AREA_PADDING + a->scrollX);
+            a->preferredX = -1;
+        }
     }
 
-    if (!t->hover.hovered)
-        t->hover.hoverStartTime = 0;
+    float wheel = _rayui_MouseWheel();
+    if (wheel != 0 && a->hovered && a->lineHeight > 0) {
+        bool shift = _rayui_KeyDown(KEY_LEFT_SHIFT) || _rayui_KeyDown(KEY_RIGHT_SHIFT);
+        if (shift) a->scrollX -= wheel * _RAYUI_TEXT_AREA_WHEEL_LINES * a->lineHeight;
+        else a->scrollY -= wheel * _RAYUI_TEXT_AREA_WHEEL_LINES * a->lineHeight;
+        _rayui_ClampTextAreaScroll(a);
+    }
 
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        t->focused = t->hovered;
-        if (t->focused) {
-            t->cleared = false;
-            if (t->clickSound.frameCount > 0 && t->hover.active) PlaySound(t->clickSound);
+    if (a->focused) {
+        int caretBefore = a->caret;
+        int lengthBefore = _rayui_PieceTableLength(a->text);
+        if (!a->readOnly) {
+            int key, cursor = 0;
+            while ((key = _rayui_NextCharPressed(&cursor)) > 0) {
+                char utf8[4];
+                _rayui_TextAreaInsert(a, utf8, _rayui_EncodeUTF8(key, utf8));
+            }
+            if (_rayui_TextAreaKey(a, KEY_ENTER)) _rayui_TextAreaInsert(a, "\n", 1);
+            if (_rayui_TextAreaKey(a, KEY_BACKSPACE) && a->caret > 0) {
+                int from = _rayui_TextAreaPrev(a, a->caret);
+                _rayui_TextAreaOffsetX(a, from, &a->caretAnchor); // anchored before the cut, the caret anchor survives it
+                if (_rayui_TextAreaDeleteAt(a, from, a->caret - from)) {
+                    a->caret = from;
+                    a->preferredX = -1;
+                    a->followCaret = true;
+                }
+            }
+            if (_rayui_TextAreaKey(a, KEY_DELETE)) {
+                _rayui_TextAreaDeleteAt(a, a->caret, _rayui_TextAreaNext(a, a->caret) - a->caret);
+                a->followCaret = true;
+            }
         }
+
+        // Up/Down and paging keep the x the caret had when vertical movement began
+        bool ctrl = _rayui_KeyDown(KEY_LEFT_CONTROL) || _rayui_KeyDown(KEY_RIGHT_CONTROL);
+        int line = _rayui_PieceTableLineOf(a->text, a->caret);
+        int lines = _rayui_PieceTableLineCount(a->text);
+        int move = 0;
+        if (_rayui_TextAreaKey(a, KEY_UP)) move = -1;
+        else if (_rayui_TextAreaKey(a, KEY_DOWN)) move = 1;
+        else if (_rayui_TextAreaKey(a, KEY_PAGE_UP)) move = -_rayui_TextAreaVisibleLines(a);
+        else if (_rayui_TextAreaKey(a, KEY_PAGE_DOWN)) move = _rayui_TextAreaVisibleLines(a);
+
+        if (move != 0) {
+            if (a->preferredX < 0) a->preferredX = _rayui_TextAreaCaretX(a);
+            int target = line + move;
+            target = target < 0 ? 0 : target >= lines ? lines - 1 : target;
+            a->caret = _rayui_TextAreaOffsetAt(a, target, a->preferredX);
+            a->followCaret = true;
+        } else if (_rayui_TextAreaKey(a, KEY_LEFT)) {
+            a->caret = _rayui_TextAreaPrev(a, a->caret);
+            a->preferredX = -1;
+            a->followCaret = true;
+        } else if (_rayui_TextAreaKey(a, KEY_RIGHT)) {
+            a->caret = _rayui_TextAreaNext(a, a->caret);
+            a->preferredX = -1;
+            a->followCaret = true;
+        } else if (_rayui_KeyPressed(KEY_HOME)) {
+            a->caret = ctrl ? 0 : _rayui_PieceTableLineStart(a->text, line);
+            a->preferredX = -1;
+            a->followCaret = true;
+        } else if (_rayui_KeyPressed(KEY_END)) {
+            a->caret = ctrl ? _rayui_PieceTableLength(a->text) : _rayui_TextAreaLineEnd(a, line);
+            a->preferredX = -1;
+            a->followCaret = true;
+        }
+
+        if (a->caret != caretBefore || _rayui_PieceTableLength(a->text) != lengthBefore) a->blinkStart = _rayui_Time();
     }
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_AREA, false);
+}
 
-    if (t->focused) {
-        int key;
-        while ((key = GetCharPressed()) > 0) {
-            int len = strlen(t->text);
-            if (!t->cleared) { t->text[0] = '\0'; t->cleared = true; len = 0; }
+void RAYUI_WITH_PREFIX(DrawTextArea)(RAYUI_WITH_PREFIX(TextArea)* a, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_TEXT_AREA);
+    Color textColorI = (a->hovered || a->focused) ? textHoverColor : textColor;
+    _rayui_DrawRectangleRec(a->rect, bgColor);
+    if (!a->text) { // freed
+        _RAYUI_STATS_END(WIDGET_TYPE_TEXT_AREA, true);
+        return;
+    }
 
-            if ((t->inputType == INPUT_TYPE_INT && (key < '0' || key > '9')) ||
-                (t->inputType == INPUT_TYPE_FLOAT && (key < '0' || key > '9') && key != '.')) continue;
+    if (!a->measured || a->font.texture.id != font.texture.id || a->fontSize != fontSize) {
+        char glyph[2] = { 0, '\0' };
+        for (int c = 1; c < 128; c++) {
+            glyph[0] = (char)c;
+            a->advances[c] = RAYUI_WITH_PREFIX(MeasureTextCached)(font, glyph, fontSize, 1).x + 1;
+        }
+        a->font = font;
+        a->fontSize = (float)fontSize;
+        a->lineHeight = (float)fontSize + 2;
+        a->contentWidth = 0;
+        a->measured = true;
+        _rayui_TextAreaForget(a);
+    }
 
-            if (len < sizeof(t->text)-1) { t->text[len] = (char)key; t->text[len+1] = '\0'; }
+    Rectangle inner = { a->rect.x + _RAYUI_TEXT_AREA_PADDING, a->rect.y + _RAYUI_TEXT_AREA_PADDING,
+                        a->rect.width - 2*_RAYUI_TEXT_AREA_PADDING - _RAYUI_TEXT_AREA_SCROLLBAR, a->rect.height - 2*_RAYUI_TEXT_AREA_PADDING };
+    int lineCount = _rayui_PieceTableLineCount(a->text);
+    int caretLine = _rayui_PieceTableLineOf(a->text, a->caret);
+    float caretX = _rayui_TextAreaCaretX(a);
+
+    if (a->followCaret) {
+        float caretY = caretLine * a->lineHeight;
+        if (caretY < a->scrollY) a->scrollY = caretY;
+        if (caretY + a->lineHeight > a->scrollY + inner.height) a->scrollY = caretY + a->lineHeight - inner.height;
+        if (caretX + 2 > a->contentWidth) a->contentWidth = caretX + 2;
+        if (caretX < a->scrollX) a->scrollX = caretX;
+        if (caretX + 2 > a->scrollX + inner.width) a->scrollX = caretX + 2 - inner.width;
+        a->followCaret = false;
+    }
+    _rayui_ClampTextAreaScroll(a);
+
+    int first = (int)(a->scrollY / a->lineHeight);
+    int last = (int)((a->scrollY + inner.height) / a->lineHeight);
+    if (last >= lineCount) last = lineCount - 1;
+    _rayui_BeginScissor(inner);
+    int lineStart = _rayui_PieceTableLineStart(a->text, first);
+    for (int i = first; i <= last; i++) {
+        int next = i + 1 < lineCount ? _rayui_PieceTableLineStart(a->text, i + 1) : _rayui_PieceTableLength(a->text);
+        int lineEnd = i + 1 < lineCount ? next - 1 : next;
+        if (lineEnd > lineStart && _rayui_PieceTableByte(a->text, lineEnd - 1) == '\r') lineEnd--;
+
+        // Only the codepoints from the first reaching into view to the first
+        // past the right edge are read, starting from the line's view anchor
+        float x;
+        int start = _rayui_TextAreaSeek(a, i, lineStart, lineEnd, a->scrollX, &x, &a->viewAnchors[i % RAYUI_TEXT_AREA_ANCHORS]);
+        float drawX = x;
+        int end = _rayui_TextAreaWalk(a, start, lineEnd, &x, a->scrollX + inner.width);
+        if (end < lineEnd && x < a->scrollX + inner.width) end = _rayui_TextAreaWalk(a, end, _rayui_TextAreaNext(a, end), &x, MAX_FLOAT);
+        if (x > a->contentWidth) a->contentWidth = x;
+
+        // The visible text is copied into the frame arena; the widget's own
+        // scratch is only a fallback
+        char* text = end > start ? (char*)_rayui_FrameAlloc(end - start + 1) : NULL;
+        if (!text && end > start) text = _rayui_TextAreaScratch(a, end - start);
+        if (text) {
+            _rayui_PieceTableCopy(a->text, start, end, text);
+            text[end - start] = '\0';
+            Vector2 pos = { inner.x - a->scrollX + drawX, inner.y + i * a->lineHeight - a->scrollY + 1 };
+            _rayui_DrawTextEx(font, text, pos, fontSize, 1, textColorI);
         }
+        lineStart = next;
+    }
 
-        const float initialHoldThreshold = 0.3f;
-        const float backspaceCooldown = 0.02f;
-        float currentTime = GetTime();
+    if (a->focused && fmod(_rayui_Time() - a->blinkStart, 1.0) < 0.5) {
+        Rectangle caret = { inner.x - a->scrollX + caretX, inner.y + caretLine * a->lineHeight - a->scrollY, 1, a->lineHeight };
+        _rayui_DrawRectangleRec(caret, textColorI);
+    }
+    _rayui_EndScissor();
 
-        if (IsKeyDown(KEY_BACKSPACE)) {
-            if (!t->backspacePressed) {
-                int len = strlen(t->text);
-                if (len > 0) t->text[len-1] = '\0';
-                t->backspacePressed = true;
-                t->backspaceHoldTime = currentTime;
-                t->backspaceTimer = currentTime;
-            } else {
-                float heldTime = currentTime - t->backspaceHoldTime;
-                if (heldTime > initialHoldThreshold) {
-                    if (currentTime - t->backspaceTimer >= backspaceCooldown) {
-                        int len = strlen(t->text);
-                        if (len > 0) t->text[len-1] = '\0';
-                        t->backspaceTimer = currentTime;
-                    }
-                }
-            }
-        } else {
-            t->backspacePressed = false;
-            t->backspaceHoldTime = 0;
-            t->backspaceTimer = 0;
+    Rectangle track, thumb;
+    if (_rayui_TextAreaScrollbar(a, &track, &thumb)) {
+        _rayui_DrawRectangleRec(track, bgColor);
+        _rayui_DrawRectangleRec(thumb, (Color){ textColor.r, textColor.g, textColor.b, textColor.a / 2 });
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_TEXT_AREA, true);
+}
+
+static void _rayui_ResetTextAreaView(RAYUI_WITH_PREFIX(TextArea)* a) {
+    a->caret = 0;
+    a->scrollX = a->scrollY = 0;
+    a->contentWidth = 0;
+    a->preferredX = -1;
+    _rayui_TextAreaForget(a);
+}
+
+bool RAYUI_WITH_PREFIX(SetTextAreaValue)(RAYUI_WITH_PREFIX(TextArea)* a, const char* value) {
+    if (!_rayui_TextAreaTable(a) || !_rayui_PieceTableReset(a->text, NULL, value, (int)strlen(value))) return false;
+    _rayui_ResetTextAreaView(a);
+    return true;
+}
+
+// The file is read straight into the original buffer, nothing is copied
+bool RAYUI_WITH_PREFIX(LoadTextAreaFile)(RAYUI_WITH_PREFIX(TextArea)* a, const char* fileName) {
+    if (!_rayui_TextAreaTable(a)) return false;
+    FILE* f = fileName ? fopen(fileName, "rb") : NULL;
+    if (!f) return false;
+
+    long size = -1;
+    char* data = NULL;
+    if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (size >= 0 && size < 0x7FFFFFFF && fseek(f, 0, SEEK_SET) == 0) {
+        data = (char*)RAYUI_MALLOC(size > 0 ? size : 1);
+        if (data && fread(data, 1, size, f) != (size_t)size) {
+            RAYUI_FREE(data);
+            data = NULL;
         }
     }
+    fclose(f);
+    if (!data) return false;
+
+    if (!_rayui_PieceTableReset(a->text, data, NULL, (int)size)) return false;
+    _rayui_ResetTextAreaView(a);
+    return true;
 }
 
-void RAYUI_WITH_PREFIX(DrawTextInput)(RAYUI_WITH_PREFIX(TextInput)* t, Font font, int fontSize, Color bgColor, Color textColor, Color textHoverColor) {
-    Color textColorI = (t->hovered || t->focused) ? textHoverColor : textColor;
-    DrawRectangleRec(t->rect, bgColor);
+// A freed area reads as empty
+int RAYUI_WITH_PREFIX(GetTextAreaLength)(RAYUI_WITH_PREFIX(TextArea)* a) {
+    return a->text ? _rayui_PieceTableLength(a->text) : 0;
+}
 
-    static double lastTime = 0;
-    static bool showCursor = false;
-    double currentTime = GetTime();
-    if (currentTime - lastTime >= 0.5) { showCursor = !showCursor; lastTime = currentTime; }
+int RAYUI_WITH_PREFIX(GetTextAreaLineCount)(RAYUI_WITH_PREFIX(TextArea)* a) {
+    return a->text ? _rayui_PieceTableLineCount(a->text) : 1;
+}
 
-    char buffer[256];
-    strncpy(buffer, t->text, sizeof(buffer)-2);
-    buffer[sizeof(buffer)-2] = '\0';
+int RAYUI_WITH_PREFIX(GetTextAreaLineStart)(RAYUI_WITH_PREFIX(TextArea)* a, int line) {
+    return a->text ? _rayui_PieceTableLineStart(a->text, line) : 0;
+}
 
-    if (t->inputType == INPUT_TYPE_PASSWORD) {
-        for (int i = 0; i < (int)strlen(buffer); i++) buffer[i] = '*';
-    }
+int RAYUI_WITH_PREFIX(GetTextAreaLine)(RAYUI_WITH_PREFIX(TextArea)* a, int offset) {
+    return a->text ? _rayui_PieceTableLineOf(a->text, offset) : 0;
+}
 
-    if (t->focused && showCursor) {
-        int len = strlen(buffer);
-        buffer[len] = '_';
-        buffer[len+1] = '\0';
-    }
+// Copies up to `length` bytes from offset into out and NUL terminates it;
+// out must hold length + 1 bytes. Returns the bytes copied
+int RAYUI_WITH_PREFIX(GetTextAreaText)(RAYUI_WITH_PREFIX(TextArea)* a, int offset, int length, char* out) {
+    int copied = a->text ? _rayui_PieceTableCopy(a->text, offset, offset + length, out) : 0;
+    out[copied] = '\0';
+    return copied;
+}
 
-    Vector2 pos = { t->rect.x + 8, t->rect.y + (t->rect.height - fontSize)/2 };
-    DrawTextEx(font, buffer, pos, fontSize, 1, textColorI);
+bool RAYUI_WITH_PREFIX(InsertTextArea)(RAYUI_WITH_PREFIX(TextArea)* a, int offset, const char* text) {
+    if (!_rayui_TextAreaTable(a)) return false;
+    int length = _rayui_PieceTableLength(a->text);
+    offset = offset < 0 ? 0 : offset > length ? length : offset;
+    int bytes = (int)strlen(text);
+    if (!_rayui_TextAreaInsertAt(a, offset, text, bytes)) return false;
+    if (a->caret >= offset) a->caret += bytes;
+    return true;
 }
 
-const char* RAYUI_WITH_PREFIX(TextInputValue)(RAYUI_WITH_PREFIX(TextInput)* t) {
-    return t->text;
+// Appends at the end; a caret at the end stays there, like a log view
+bool RAYUI_WITH_PREFIX(AppendTextArea)(RAYUI_WITH_PREFIX(TextArea)* a, const char* text) {
+    if (!_rayui_TextAreaTable(a)) return false;
+    bool atEnd = a->caret == _rayui_PieceTableLength(a->text);
+    if (!RAYUI_WITH_PREFIX(InsertTextArea)(a, _rayui_PieceTableLength(a->text), text)) return false;
+    if (atEnd) a->followCaret = true;
+    return true;
 }
 
-void RAYUI_WITH_PREFIX(SetTextInputValue)(RAYUI_WITH_PREFIX(TextInput)* t, const char* value) {
-    strncpy(t->text, value, sizeof(t->text));
-    t->text[sizeof(t->text)-1] = '\0';
+bool RAYUI_WITH_PREFIX(DeleteTextArea)(RAYUI_WITH_PREFIX(TextArea)* a, int offset, int length) {
+    if (!a->text) return true;
+    int total = _rayui_PieceTableLength(a->text);
+    if (offset < 0) { length += offset; offset = 0; }
+    if (length > total - offset) length = total - offset;
+    if (length <= 0) return true;
+    if (!_rayui_TextAreaDeleteAt(a, offset, length)) return false;
+    if (a->caret >= offset + length) a->caret -= length;
+    else if (a->caret > offset) a->caret = offset;
+    return true;
+}
+
+void RAYUI_WITH_PREFIX(SetTextAreaCaret)(RAYUI_WITH_PREFIX(TextArea)* a, int caret) {
+    int length = a->text ? _rayui_PieceTableLength(a->text) : 0;
+    caret = caret < 0 ? 0 : caret > length ? length : caret;
+    while (caret > 0 && caret < length && (_rayui_PieceTableByte(a->text, caret) & 0xC0) == 0x80) caret--;
+    a->caret = caret;
+    a->preferredX = -1;
+    a->followCaret = true;
+    a->blinkStart = _rayui_Time();
+}
+
+void RAYUI_WITH_PREFIX(ScrollTextAreaToLine)(RAYUI_WITH_PREFIX(TextArea)* a, int line) {
+    if (!a->text) return;
+    a->scrollY = line * a->lineHeight;
+    _rayui_ClampTextAreaScroll(a);
 }
 
 // --------------- PROGRESS BAR ----------------
@@ -1313,27 +6094,37 @@ RAYUI_WITH_PREFIX(ProgressBar) RAYUI_WITH_PREFIX(CreateProgressBar)(int x, int y
     p.hover.hovered = false;
     p.hover.delay = DEFAULT_HOVER_INFO_DELAY;
     p.hover.active = false;
+    p.hover.handle = 0;
+    p.hover.hitHandle = 0;
     return p;
 }
 
 void RAYUI_WITH_PREFIX(DrawProgressBar)(RAYUI_WITH_PREFIX(ProgressBar)* p, Color backColor, Color fillColor) {
-    DrawRectangleRec(p->bar, backColor);
-    DrawRectangleRec((Rectangle){p->bar.x, p->bar.y, p->bar.width * p->progress, p->bar.height}, fillColor);
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_PROGRESS_BAR);
+    _rayui_DrawRectangleRec(p->bar, backColor);
+    _rayui_DrawRectangleRec((Rectangle){p->bar.x, p->bar.y, p->bar.width * p->progress, p->bar.height}, fillColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_PROGRESS_BAR, true);
 }
 
 void RAYUI_WITH_PREFIX(DrawProgressBarEx)(RAYUI_WITH_PREFIX(ProgressBar)* p, Color backColor, Color fillColor, int outlineWidth, Color outlineColor) {
-    DrawRectangleRec(p->bar, backColor);
-    DrawRectangleRec((Rectangle){p->bar.x, p->bar.y, p->bar.width * p->progress, p->bar.height}, fillColor);
-    DrawRectangleLinesEx(p->bar, outlineWidth, outlineColor);
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_PROGRESS_BAR);
+    _rayui_DrawRectangleRec(p->bar, backColor);
+    _rayui_DrawRectangleRec((Rectangle){p->bar.x, p->bar.y, p->bar.width * p->progress, p->bar.height}, fillColor);
+    _rayui_DrawRectangleLinesEx(p->bar, outlineWidth, outlineColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_PROGRESS_BAR, true);
 }
 
 void RAYUI_WITH_PREFIX(UpdateProgressBar)(RAYUI_WITH_PREFIX(ProgressBar)* p) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_PROGRESS_BAR);
     if (p->hover.active) {
-        p->hover.hovered = CheckCollisionPointRec(GetMousePosition(), p->bar);
+        Vector2 mousePoint = _rayui_MousePosition();
+        p->hover.hovered = _rayui_HitTest(&p->hover, p->bar, mousePoint) && CheckCollisionPointRec(mousePoint, p->bar);
+        _rayui_SyncHover(&p->hover);
 
-        if (p->hover.hovered && p->hover.hoverStartTime == 0) p->hover.hoverStartTime = GetTime();
+        if (p->hover.hovered && p->hover.hoverStartTime == 0) p->hover.hoverStartTime = _rayui_Time();
         if (!p->hover.hovered) p->hover.hoverStartTime = 0;
     }
+    _RAYUI_STATS_END(WIDGET_TYPE_PROGRESS_BAR, false);
 }
 
 void RAYUI_WITH_PREFIX(SetProgressBarValue)(RAYUI_WITH_PREFIX(ProgressBar)* p, float value) {
@@ -1360,199 +6151,901 @@ bool RAYUI_WITH_PREFIX(IsProgressBarEmpty)(RAYUI_WITH_PREFIX(ProgressBar)* p) {
     return p->progress <= 0.0f;
 }
 
+// ---------------- DROPDOWN FILTER ----------------
+// Options are lowercased once into one flat buffer, with two 64-bit masks per
+// option: the characters it contains and the (hashed) adjacent pairs. An
+// option can only match if its masks cover the query's, which rejects most
+// options without touching their text. Results are kept in two tiers, prefix
+// matches then substring matches, each in option order. While the query only
+// grows a result set can only shrink, so each keystroke re-scans the previous
+// results instead of every option.
+
+struct _rayui_DropdownIndex {
+    char* text;                  // lowercased options, NUL separated
+    int* offsets;                // start of each option in text
+    unsigned long long* chars;   // characters present in each option
+    unsigned long long* pairs;   // adjacent character pairs present
+    int* results;                // matching option indices, prefix tier first
+    int* scratch;
+    int resultCount;
+    int prefixCount;             // results[0..prefixCount) are prefix matches
+    int optionCount;
+    char query[RAYUI_DROPDOWN_QUERY_SIZE]; // lowercased query the results belong to
+    int queryLength;
+};
+
+static inline char _rayui_Lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+// Letters and digits get their own bit, anything else shares the rest
+static inline unsigned long long _rayui_CharBit(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return 1ULL << (c - 'a');
+    if (c >= '0' && c <= '9') return 1ULL << (26 + c - '0');
+    return 1ULL << (36 + c % 28);
+}
+
+static inline unsigned long long _rayui_PairBit(unsigned char a, unsigned char b) {
+    unsigned int h = ((unsigned int)a * 31u + b) * 2654435761u;
+    return 1ULL << (h >> 26);
+}
+
+static void _rayui_FreeDropdownIndex(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    if (!d->index) return;
+    RAYUI_FREE(d->index->text);
+    RAYUI_FREE(d->index->offsets);
+    RAYUI_FREE(d->index->chars);
+    RAYUI_FREE(d->index->pairs);
+    RAYUI_FREE(d->index->results);
+    RAYUI_FREE(d->index->scratch);
+    RAYUI_FREE(d->index);
+    d->index = NULL;
+}
+
+static const char* _rayui_DropdownOption(RAYUI_WITH_PREFIX(Dropdown)* d, int index);
+
+// Returns false and leaves d->index NULL when out of memory, the dropdown then
+// shows every option unfiltered
+static bool _rayui_BuildDropdownIndex(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    _rayui_FreeDropdownIndex(d);
+    struct _rayui_DropdownIndex* ix = (struct _rayui_DropdownIndex*)RAYUI_CALLOC(1, sizeof(*ix));
+    if (!ix) return false;
+    d->index = ix; // so a failure below can free the partial index
+    int n = d->optionCount > 0 ? d->optionCount : 0;
+    ix->optionCount = n;
+    ix->offsets = (int*)RAYUI_MALLOC(sizeof(int) * (n + 1));
+    ix->chars = (unsigned long long*)RAYUI_MALLOC(sizeof(unsigned long long) * (n + 1));
+    ix->pairs = (unsigned long long*)RAYUI_MALLOC(sizeof(unsigned long long) * (n + 1));
+    ix->results = (int*)RAYUI_MALLOC(sizeof(int) * (n + 1));
+    ix->scratch = (int*)RAYUI_MALLOC(sizeof(int) * (n + 1));
+
+    size_t size = 0, capacity = (size_t)n * 16 + 1;
+    ix->text = (char*)RAYUI_MALLOC(capacity);
+    if (!ix->offsets || !ix->chars || !ix->pairs || !ix->results || !ix->scratch || !ix->text) {
+        _rayui_FreeDropdownIndex(d);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        const char* s = _rayui_DropdownOption(d, i);
+        size_t len = strlen(s);
+        if (size + len + 1 > capacity) {
+            while (size + len + 1 > capacity) capacity *= 2;
+            char* text = (char*)RAYUI_REALLOC(ix->text, capacity);
+            if (!text) {
+                _rayui_FreeDropdownIndex(d);
+                return false;
+            }
+            ix->text = text;
+        }
+        char* t = ix->text + size;
+        unsigned long long chars = 0, pairs = 0;
+        for (size_t k = 0; k < len; k++) {
+            t[k] = _rayui_Lower(s[k]);
+            chars |= _rayui_CharBit((unsigned char)t[k]);
+            if (k > 0) pairs |= _rayui_PairBit((unsigned char)t[k - 1], (unsigned char)t[k]);
+        }
+        t[len] = '\0';
+        ix->offsets[i] = (int)size;
+        ix->chars[i] = chars;
+        ix->pairs[i] = pairs;
+        size += len + 1;
+    }
+    return true;
+}
+
+// Option labels are short, so plain loops beat strstr's setup cost
+static inline bool _rayui_StartsWith(const char* s, const char* q, int qlen) {
+    for (int k = 0; k < qlen; k++) if (s[k] != q[k]) return false;
+    return true;
+}
+
+static inline bool _rayui_ContainsFrom(const char* s, const char* q, int qlen) {
+    for (; *s; s++) if (*s == q[0] && _rayui_StartsWith(s, q, qlen)) return true;
+    return false;
+}
+
+typedef struct {
+    const char* text;
+    int length;
+    unsigned long long chars;
+    unsigned long long pairs;
+    bool exact; // a single letter or digit, fully decided by the character mask
+} _rayui_DropdownQuery;
+
+// 0 = no match, 1 = prefix match, 2 = substring match
+static inline int _rayui_MatchOption(struct _rayui_DropdownIndex* ix, int i, const _rayui_DropdownQuery* q) {
+    if ((ix->chars[i] & q->chars) != q->chars || (ix->pairs[i] & q->pairs) != q->pairs) return 0;
+    const char* s = ix->text + ix->offsets[i];
+    if (s[0] == q->text[0] && _rayui_StartsWith(s, q->text, q->length)) return 1;
+    if (q->exact) return 2;
+    return _rayui_ContainsFrom(s + 1, q->text, q->length) ? 2 : 0;
+}
+
+// Recomputes results for d->query, narrowing the previous results when possible
+static void _rayui_FilterDropdown(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    struct _rayui_DropdownIndex* ix = d->index;
+    char text[RAYUI_DROPDOWN_QUERY_SIZE];
+    _rayui_DropdownQuery q = { text, d->queryLength, 0, 0, false };
+    for (int k = 0; k < q.length; k++) {
+        text[k] = _rayui_Lower(d->query[k]);
+        q.chars |= _rayui_CharBit((unsigned char)text[k]);
+        if (k > 0) q.pairs |= _rayui_PairBit((unsigned char)text[k - 1], (unsigned char)text[k]);
+    }
+    text[q.length] = '\0';
+    q.exact = q.length == 1 && ((text[0] >= 'a' && text[0] <= 'z') || (text[0] >= '0' && text[0] <= '9'));
+
+    bool narrow = ix->queryLength > 0 && q.length >= ix->queryLength && memcmp(text, ix->query, ix->queryLength) == 0;
+    memcpy(ix->query, text, q.length + 1);
+    ix->queryLength = q.length;
+    if (q.length == 0) {
+        ix->resultCount = ix->prefixCount = 0;
+        return;
+    }
+
+    int prefix = 0, substring = 0;
+    int* out = ix->scratch;
+    if (!narrow) {
+        // Prefix tier goes to the front of scratch, substring tier to results
+        for (int i = 0; i < ix->optionCount; i++) {
+            int match = _rayui_MatchOption(ix, i, &q);
+            if (match == 1) out[prefix++] = i;
+            else if (match == 2) ix->results[substring++] = i;
+        }
+        memcpy(out + prefix, ix->results, sizeof(int) * substring);
+    } else {
+        // Old prefix matches either stay, drop to the substring tier or go;
+        // old substring matches can only stay or go. Survivors are compacted
+        // in place, then the two sorted substring lists are merged
+        int demoted = 0;
+        for (int k = 0; k < ix->prefixCount; k++) {
+            int i = ix->results[k];
+            int match = _rayui_MatchOption(ix, i, &q);
+            if (match == 1) out[prefix++] = i;
+            else if (match == 2) ix->results[demoted++] = i;
+        }
+        int* kept = ix->results + ix->prefixCount;
+        for (int k = ix->prefixCount; k < ix->resultCount; k++) {
+            int i = ix->results[k];
+            if (_rayui_MatchOption(ix, i, &q)) kept[substring++] = i;
+        }
+
+        int* merged = out + prefix;
+        int a = 0, b = 0, w = 0;
+        while (a < demoted || b < substring) {
+            if (b == substring || (a < demoted && ix->results[a] < kept[b])) merged[w++] = ix->results[a++];
+            else merged[w++] = kept[b++];
+        }
+        substring = w;
+    }
+
+    int* swap = ix->results;
+    ix->results = ix->scratch;
+    ix->scratch = swap;
+    ix->prefixCount = prefix;
+    ix->resultCount = prefix + substring;
+}
+
 // ---------------- DROPDOWN ----------------
 
+#define _RAYUI_DROPDOWN_SCROLLBAR 8
+#define _RAYUI_DROPDOWN_WHEEL_ROWS 3
+
+static void _rayui_InitDropdown(RAYUI_WITH_PREFIX(Dropdown)* d, float x, float y, float width, float height, const char** options, int optionCount, int initialIndex) {
+    d->rect = (Rectangle){x, y, width, height};
+    d->options = options;
+    d->optionCount = optionCount;
+    d->selectedIndex = initialIndex;
+    d->expanded = false;
+    d->hovered = false;
+    d->source = NULL;
+    d->userData = NULL;
+    d->maxVisible = 0;
+    d->scrollIndex = 0;
+    d->dragging = false;
+    d->dragOffset = 0;
+    d->query[0] = '\0';
+    d->queryLength = 0;
+    d->index = NULL;
+    d->hover.hoverInfo = NULL;
+    d->hover.hoverStartTime = 0;
+    d->hover.hovered = false;
+    d->hover.delay = DEFAULT_HOVER_INFO_DELAY;
+    d->hover.active = false;
+    d->hover.handle = 0;
+    d->hover.hitHandle = 0;
+}
+
 RAYUI_WITH_PREFIX(Dropdown) RAYUI_WITH_PREFIX(CreateDropdown)(float x, float y, float width, float height, const char** options, int optionCount, int initialIndex) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
     RAYUI_WITH_PREFIX(Dropdown) d;
-    d.rect = (Rectangle){x, y, width, height};
-    d.options = options;
-    d.optionCount = optionCount;
-    d.selectedIndex = initialIndex;
-    d.expanded = false;
-    d.hovered = false;
-    d.hoverSound = _rayui_DefaultSound;
-    d.clickSound = _rayui_DefaultSound;
-    d.hover.hoverInfo = NULL;
-    d.hover.hoverStartTime = 0;
-    d.hover.hovered = false;
-    d.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    d.hover.active = false;
+    _rayui_InitDropdown(&d, x, y, width, height, options, optionCount, initialIndex);
+    d.hoverSound = ctx->defaultSound;
+    d.clickSound = ctx->defaultSound;
     return d;
 }
 
 RAYUI_WITH_PREFIX(Dropdown) RAYUI_WITH_PREFIX(CreateDropdownWithSound)(float x, float y, float width, float height, const char** options, int optionCount, int initialIndex, Sound hoverSound, Sound clickSound) {
     RAYUI_WITH_PREFIX(Dropdown) d;
-    d.rect = (Rectangle){x, y, width, height};
-    d.options = options;
-    d.optionCount = optionCount;
-    d.selectedIndex = initialIndex;
-    d.expanded = false;
-    d.hovered = false;
+    _rayui_InitDropdown(&d, x, y, width, height, options, optionCount, initialIndex);
     d.hoverSound = hoverSound;
     d.clickSound = clickSound;
-    d.hover.hoverInfo = NULL;
-    d.hover.hoverStartTime = 0;
-    d.hover.hovered = false;
-    d.hover.delay = DEFAULT_HOVER_INFO_DELAY;
-    d.hover.active = false;
     return d;
 }
 
+void RAYUI_WITH_PREFIX(SetDropdownSource)(RAYUI_WITH_PREFIX(Dropdown)* d, RAYUI_WITH_PREFIX(DropdownSource) source, int optionCount, void* userData) {
+    d->source = source;
+    d->userData = userData;
+    d->optionCount = optionCount;
+    if (d->selectedIndex >= optionCount) d->selectedIndex = -1;
+    d->scrollIndex = 0;
+    if (d->index && _rayui_BuildDropdownIndex(d)) _rayui_FilterDropdown(d);
+}
+
+void RAYUI_WITH_PREFIX(SetDropdownMaxVisible)(RAYUI_WITH_PREFIX(Dropdown)* d, int rows) {
+    d->maxVisible = rows > 0 ? rows : 0;
+    d->scrollIndex = 0;
+}
+
+static const char* _rayui_DropdownOption(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
+    const char* text = d->source ? d->source(index, d->userData) : d->options[index];
+    return text ? text : "";
+}
+
+static inline bool _rayui_DropdownFiltering(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return d->index && d->queryLength > 0;
+}
+
+// Options in the current view: all of them, or the filter results
+static inline int _rayui_DropdownViewCount(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return _rayui_DropdownFiltering(d) ? d->index->resultCount : d->optionCount;
+}
+
+static inline int _rayui_DropdownViewOption(RAYUI_WITH_PREFIX(Dropdown)* d, int row) {
+    return _rayui_DropdownFiltering(d) ? d->index->results[row] : row;
+}
+
+// Rows shown while expanded
+static inline int _rayui_DropdownRows(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    int count = _rayui_DropdownViewCount(d);
+    return (d->maxVisible > 0 && d->maxVisible < count) ? d->maxVisible : count;
+}
+
+static inline bool _rayui_DropdownScrolls(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return _rayui_DropdownRows(d) < _rayui_DropdownViewCount(d);
+}
+
+static void _rayui_ClampDropdownScroll(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    int maxScroll = _rayui_DropdownViewCount(d) - _rayui_DropdownRows(d);
+    if (d->scrollIndex > maxScroll) d->scrollIndex = maxScroll;
+    if (d->scrollIndex < 0) d->scrollIndex = 0;
+}
+
+void RAYUI_WITH_PREFIX(ScrollDropdownTo)(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
+    if (_rayui_DropdownFiltering(d)) {
+        int row = 0;
+        while (row < d->index->resultCount && d->index->results[row] != index) row++;
+        if (row == d->index->resultCount) return;
+        index = row;
+    }
+    int rows = _rayui_DropdownRows(d);
+    if (index < d->scrollIndex) d->scrollIndex = index;
+    else if (index >= d->scrollIndex + rows) d->scrollIndex = index - rows + 1;
+    _rayui_ClampDropdownScroll(d);
+}
+
+// Scrollbar track and thumb, to the right of the visible rows
+static void _rayui_DropdownScrollbar(RAYUI_WITH_PREFIX(Dropdown)* d, Rectangle* track, Rectangle* thumb) {
+    int rows = _rayui_DropdownRows(d);
+    *track = (Rectangle){ d->rect.x + d->rect.width - _RAYUI_DROPDOWN_SCROLLBAR, d->rect.y + d->rect.height,
+                          _RAYUI_DROPDOWN_SCROLLBAR, d->rect.height * rows };
+    int count = _rayui_DropdownViewCount(d);
+    float thumbHeight = track->height * rows / count;
+    if (thumbHeight < 12) thumbHeight = 12;
+    int maxScroll = count - rows;
+    float t = maxScroll > 0 ? (float)d->scrollIndex / maxScroll : 0;
+    *thumb = (Rectangle){ track->x, track->y + (track->height - thumbHeight) * t, track->width, thumbHeight };
+}
+
+static bool _rayui_UpdateDropdown(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return RAYUI_WITH_PREFIX(UpdateDropdownWithMousePoint)(d, _rayui_MousePosition());
+}
+
 bool RAYUI_WITH_PREFIX(UpdateDropdown)(RAYUI_WITH_PREFIX(Dropdown)* d) {
-    d->hovered = CheckCollisionPointRec(GetMousePosition(), d->rect);
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_DROPDOWN);
+    bool result = _rayui_UpdateDropdown(d);
+    _RAYUI_STATS_END(WIDGET_TYPE_DROPDOWN, false);
+    return result;
+}
+
+// Index of the expanded option under the mouse, or -1. Rows are a fixed
+// height, so this is arithmetic on the visible window rather than a scan
+static int _rayui_DropdownOptionAt(RAYUI_WITH_PREFIX(Dropdown)* d, Vector2 mousePoint) {
+    if (!d->expanded || d->rect.height <= 0) return -1;
+    float right = d->rect.x + d->rect.width;
+    if (_rayui_DropdownScrolls(d)) right -= _RAYUI_DROPDOWN_SCROLLBAR;
+    if (mousePoint.x < d->rect.x || mousePoint.x >= right) return -1;
+    float row = (mousePoint.y - d->rect.y) / d->rect.height;
+    if (row < 1) return -1;
+    int i = (int)row - 1;
+    if (i >= _rayui_DropdownRows(d)) return -1;
+    i += d->scrollIndex;
+    return i < _rayui_DropdownViewCount(d) ? _rayui_DropdownViewOption(d, i) : -1;
+}
+
+static bool _rayui_UpdateDropdownWithMousePoint(RAYUI_WITH_PREFIX(Dropdown)* d, Vector2 mousePoint) {
+    Rectangle bounds = d->rect;
+    if (d->expanded) bounds.height *= _rayui_DropdownRows(d) + 1;
+    bool candidate = _rayui_HitTest(&d->hover, bounds, mousePoint);
+
+    d->hovered = candidate && CheckCollisionPointRec(mousePoint, d->rect);
     d->hover.hovered = d->hovered;
+    _rayui_SyncHover(&d->hover);
 
     if (d->hover.hovered && d->hover.hoverStartTime == 0 && d->hover.active) {
-        d->hover.hoverStartTime = GetTime();
-        if (d->hoverSound.frameCount > 0) PlaySound(d->hoverSound);
+        d->hover.hoverStartTime = _rayui_Time();
+        if (d->hoverSound.frameCount > 0) _rayui_PlaySound(d->hoverSound);
     }
 
     if (!d->hover.hovered)
         d->hover.hoverStartTime = 0;
 
-    if (d->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (d->clickSound.frameCount > 0 && d->hover.active) PlaySound(d->clickSound);
+    if (d->hovered && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        if (d->clickSound.frameCount > 0 && d->hover.active) _rayui_PlaySound(d->clickSound);
         d->expanded = !d->expanded;
+        d->dragging = false;
+        if (d->queryLength > 0) RAYUI_WITH_PREFIX(SetDropdownQuery)(d, "");
+        if (d->expanded && d->selectedIndex >= 0) {
+            // Open with the selection centred in the visible rows
+            d->scrollIndex = d->selectedIndex - _rayui_DropdownRows(d) / 2;
+            _rayui_ClampDropdownScroll(d);
+        }
         return false;
     }
 
-    if (d->expanded) {
-        for (int i = 0; i < d->optionCount; i++) {
-            Rectangle optionRect = {d->rect.x, d->rect.y + d->rect.height * (i + 1), d->rect.width, d->rect.height};
-            if (CheckCollisionPointRec(GetMousePosition(), optionRect) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                d->selectedIndex = i;
-                d->expanded = false;
-                if (d->clickSound.frameCount > 0 && d->hover.active) PlaySound(d->clickSound);
-                return true;
+    if (!d->expanded) return false;
+
+    if (d->index) {
+        // Type-ahead: printable characters narrow the list, Backspace widens
+        // it, Enter picks the first match and Escape clears the query
+        int length = d->queryLength, cursor = 0, c;
+        while ((c = _rayui_NextCharPressed(&cursor)) > 0) {
+            if (c >= 32 && c < 127 && length < RAYUI_DROPDOWN_QUERY_SIZE - 1) d->query[length++] = (char)c;
+        }
+        if (_rayui_KeyPressed(KEY_BACKSPACE) && length > 0) length--;
+        if (length != d->queryLength) {
+            d->query[length] = '\0';
+            d->queryLength = length;
+            _rayui_FilterDropdown(d);
+            d->scrollIndex = 0;
+        }
+        if (_rayui_KeyPressed(KEY_ESCAPE)) {
+            if (d->queryLength > 0) RAYUI_WITH_PREFIX(SetDropdownQuery)(d, "");
+            else d->expanded = false;
+            return false;
+        }
+        if (_rayui_KeyPressed(KEY_ENTER) && _rayui_DropdownViewCount(d) > 0) {
+            d->selectedIndex = _rayui_DropdownViewOption(d, 0);
+            d->expanded = false;
+            RAYUI_WITH_PREFIX(SetDropdownQuery)(d, "");
+            return true;
+        }
+    }
+
+    if (_rayui_DropdownScrolls(d)) {
+        Rectangle track, thumb;
+        _rayui_DropdownScrollbar(d, &track, &thumb);
+
+        if (d->dragging) {
+            if (_rayui_MouseDown(MOUSE_LEFT_BUTTON)) {
+                float range = track.height - thumb.height;
+                float t = range > 0 ? (mousePoint.y - d->dragOffset - track.y) / range : 0;
+                d->scrollIndex = (int)(t * (_rayui_DropdownViewCount(d) - _rayui_DropdownRows(d)) + 0.5f);
+                _rayui_ClampDropdownScroll(d);
+            } else {
+                d->dragging = false;
+            }
+            return false;
+        }
+
+        if (candidate && CheckCollisionPointRec(mousePoint, track)) {
+            if (_rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+                // Grabbing the track outside the thumb jumps the thumb there
+                float grab = CheckCollisionPointRec(mousePoint, thumb) ? mousePoint.y - thumb.y : thumb.height / 2;
+                d->dragging = true;
+                d->dragOffset = grab;
+                float range = track.height - thumb.height;
+                float t = range > 0 ? (mousePoint.y - grab - track.y) / range : 0;
+                d->scrollIndex = (int)(t * (_rayui_DropdownViewCount(d) - _rayui_DropdownRows(d)) + 0.5f);
+                _rayui_ClampDropdownScroll(d);
+                return false;
             }
         }
+
+        float wheel = _rayui_MouseWheel();
+        if (wheel != 0 && candidate && CheckCollisionPointRec(mousePoint, bounds)) {
+            d->scrollIndex -= (int)(wheel * _RAYUI_DROPDOWN_WHEEL_ROWS);
+            _rayui_ClampDropdownScroll(d);
+        }
+    }
+
+    if (candidate && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
+        int i = _rayui_DropdownOptionAt(d, mousePoint);
+        if (i >= 0) {
+            d->selectedIndex = i;
+            d->expanded = false;
+            if (d->queryLength > 0) RAYUI_WITH_PREFIX(SetDropdownQuery)(d, "");
+            if (d->clickSound.frameCount > 0 && d->hover.active) _rayui_PlaySound(d->clickSound);
+            return true;
+        }
     }
 
     return false;
 }
 
 bool RAYUI_WITH_PREFIX(UpdateDropdownWithMousePoint)(RAYUI_WITH_PREFIX(Dropdown)* d, Vector2 mousePoint) {
-    d->hovered = CheckCollisionPointRec(mousePoint, d->rect);
-    d->hover.hovered = d->hovered;
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_DROPDOWN);
+    bool result = _rayui_UpdateDropdownWithMousePoint(d, mousePoint);
+    _RAYUI_STATS_END(WIDGET_TYPE_DROPDOWN, false);
+    return result;
+}
 
-    if (d->hover.hovered && d->hover.hoverStartTime == 0 && d->hover.active) {
-        d->hover.hoverStartTime = GetTime();
-        if (d->hoverSound.frameCount > 0) PlaySound(d->hoverSound);
+// Draws only the visible rows, so cost does not grow with optionCount
+static void _rayui_DrawDropdownList(RAYUI_WITH_PREFIX(Dropdown)* d, Font font, int fontSize, Color textColor,
+                                    Color optionBgColor, Color optionHoverColor, int outlineWidth, Color outlineColor) {
+    int rows = _rayui_DropdownRows(d);
+    int hoveredOption = _rayui_DropdownOptionAt(d, _rayui_MousePosition());
+    for (int row = 0; row < rows; row++) {
+        int i = _rayui_DropdownViewOption(d, d->scrollIndex + row);
+        Rectangle optionRect = { d->rect.x, d->rect.y + d->rect.height * (row + 1), d->rect.width, d->rect.height };
+        Color optionBg = (i == hoveredOption) ? optionHoverColor : optionBgColor;
+        _rayui_DrawRectangleRec(optionRect, optionBg);
+
+        const char* optionText = _rayui_DropdownOption(d, i);
+        Vector2 optTextSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, optionText, fontSize, 1);
+        Vector2 optPos = { optionRect.x + 8, optionRect.y + (optionRect.height - optTextSize.y)/2 };
+        _rayui_DrawTextEx(font, optionText, optPos, fontSize, 1, textColor);
+
+        if (outlineWidth > 0) {
+            Rectangle divider = { d->rect.x, optionRect.y, d->rect.width, (float)outlineWidth };
+            _rayui_DrawRectangleRec(divider, outlineColor);
+        }
     }
 
-    if (!d->hover.hovered)
-        d->hover.hoverStartTime = 0;
+    if (_rayui_DropdownScrolls(d)) {
+        Rectangle track, thumb;
+        _rayui_DropdownScrollbar(d, &track, &thumb);
+        _rayui_DrawRectangleRec(track, optionBgColor);
+        _rayui_DrawRectangleRec(thumb, (Color){ textColor.r, textColor.g, textColor.b, textColor.a / 2 });
+    }
+}
 
-    if (d->hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (d->clickSound.frameCount > 0 && d->hover.active) PlaySound(d->clickSound);
-        d->expanded = !d->expanded;
-        return false;
+void RAYUI_WITH_PREFIX(DrawDropdown)(RAYUI_WITH_PREFIX(Dropdown)* d, Font font, int fontSize, Color bgColor, Color textColor, Color hoverColor, Color optionBgColor, Color optionHoverColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_DROPDOWN);
+    Color textCol = (d->hovered) ? hoverColor : textColor;
+    _rayui_DrawRectangleRec(d->rect, bgColor);
+
+    const char* selectedText = (d->selectedIndex >= 0 && d->selectedIndex < d->optionCount) ? _rayui_DropdownOption(d, d->selectedIndex) : "Select";
+    if (d->expanded && _rayui_DropdownFiltering(d)) selectedText = d->query;
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, selectedText, fontSize, 1);
+    Vector2 pos = { d->rect.x + 8, d->rect.y + (d->rect.height - textSize.y)/2 };
+    _rayui_DrawTextEx(font, selectedText, pos, fontSize, 1, textCol);
+
+    if (d->expanded) {
+        _rayui_DrawDropdownList(d, font, fontSize, textColor, optionBgColor, optionHoverColor, 0, BLANK);
     }
+    _RAYUI_STATS_END(WIDGET_TYPE_DROPDOWN, true);
+}
+
+void RAYUI_WITH_PREFIX(DrawDropdownEx)(RAYUI_WITH_PREFIX(Dropdown)* d, Font font, int fontSize,
+                                       Color bgColor, Color textColor, Color hoverColor,
+                                       Color optionBgColor, Color optionHoverColor,
+                                       int outlineWidth, Color outlineColor, const char* placeholderText)
+{
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_DROPDOWN);
+    Color textCol = (d->hovered) ? hoverColor : textColor;
+
+    _rayui_DrawRectangleRec(d->rect, bgColor);
+
+    const char* selectedText = (d->selectedIndex >= 0 && d->selectedIndex < d->optionCount) ? _rayui_DropdownOption(d, d->selectedIndex) : placeholderText;
+    if (d->expanded && _rayui_DropdownFiltering(d)) selectedText = d->query;
+    Vector2 textSize = RAYUI_WITH_PREFIX(MeasureTextCached)(font, selectedText, fontSize, 1);
+    Vector2 pos = { d->rect.x + 8, d->rect.y + (d->rect.height - textSize.y)/2 };
+    _rayui_DrawTextEx(font, selectedText, pos, fontSize, 1, textCol);
 
     if (d->expanded) {
-        for (int i = 0; i < d->optionCount; i++) {
-            Rectangle optionRect = {d->rect.x, d->rect.y + d->rect.height * (i + 1), d->rect.width, d->rect.height};
-            if (CheckCollisionPointRec(mousePoint, optionRect) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                d->selectedIndex = i;
-                d->expanded = false;
-                if (d->clickSound.frameCount > 0 && d->hover.active) PlaySound(d->clickSound);
-                return true;
-            }
+        _rayui_DrawDropdownList(d, font, fontSize, textColor, optionBgColor, optionHoverColor, outlineWidth, outlineColor);
+
+        if (outlineWidth > 0) {
+            Rectangle divider = { d->rect.x, d->rect.y + d->rect.height, d->rect.width, (float)outlineWidth };
+            _rayui_DrawRectangleRec(divider, outlineColor);
         }
     }
 
-    return false;
+    if (outlineWidth > 0) {
+        float totalHeight = d->rect.height + (d->expanded ? d->rect.height * _rayui_DropdownRows(d) : 0);
+        Rectangle totalRect = { d->rect.x, d->rect.y, d->rect.width, totalHeight };
+        _rayui_DrawRectangleLinesEx(totalRect, outlineWidth, outlineColor);
+    }
+    _RAYUI_STATS_END(WIDGET_TYPE_DROPDOWN, true);
+}
+
+void RAYUI_WITH_PREFIX(SetDropdownFilter)(RAYUI_WITH_PREFIX(Dropdown)* d, bool enabled) {
+    if (enabled) {
+        if (_rayui_BuildDropdownIndex(d)) _rayui_FilterDropdown(d);
+    } else {
+        _rayui_FreeDropdownIndex(d);
+    }
+    d->scrollIndex = 0;
+}
+
+void RAYUI_WITH_PREFIX(SetDropdownQuery)(RAYUI_WITH_PREFIX(Dropdown)* d, const char* query) {
+    size_t length = strlen(query);
+    if (length > RAYUI_DROPDOWN_QUERY_SIZE - 1) {
+        // Cut at a codepoint boundary, never inside a UTF-8 sequence
+        length = RAYUI_DROPDOWN_QUERY_SIZE - 1;
+        while (length > 0 && ((unsigned char)query[length] & 0xC0) == 0x80) length--;
+    }
+    memcpy(d->query, query, length);
+    d->query[length] = '\0';
+    d->queryLength = (int)length;
+    if (d->index) _rayui_FilterDropdown(d);
+    d->scrollIndex = 0;
+}
+
+int RAYUI_WITH_PREFIX(GetDropdownFilteredCount)(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return _rayui_DropdownViewCount(d);
+}
+
+int RAYUI_WITH_PREFIX(GetDropdownFilteredIndex)(RAYUI_WITH_PREFIX(Dropdown)* d, int row) {
+    if (row < 0 || row >= _rayui_DropdownViewCount(d)) return -1;
+    return _rayui_DropdownViewOption(d, row);
+}
+
+const char* RAYUI_WITH_PREFIX(DropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    if (d->selectedIndex < 0 || d->selectedIndex >= d->optionCount) return NULL;
+    return _rayui_DropdownOption(d, d->selectedIndex);
+}
+
+void RAYUI_WITH_PREFIX(SetDropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
+    if (index < 0 || index >= d->optionCount) return;
+    d->selectedIndex = index;
+}
+
+int RAYUI_WITH_PREFIX(GetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d) {
+    return d->selectedIndex;
+}
+
+void RAYUI_WITH_PREFIX(SetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
+    if (index < 0 || index >= d->optionCount) return;
+    d->selectedIndex = index;
+}
+
+// ---------------- COLOR CONVERSION ----------------
+// Same formulas as raylib's ColorFromHSV/ColorToHSV, over structure-of-arrays spans
+
+static inline unsigned char _rayui_HSVChannel(float h, float s, float v, float n) {
+    float k = n + h / 60.0f;
+    k = k - 6.0f * floorf(k / 6.0f);
+    float t = 4.0f - k;
+    k = (t < k) ? t : k;
+    k = (k < 1.0f) ? k : 1.0f;
+    k = (k > 0.0f) ? k : 0.0f;
+    // Clamp before the cast so out-of-range and NaN inputs saturate (NaN to 0)
+    // exactly like the SIMD paths instead of wrapping
+    float c = (v - v*s*k) * 255.0f;
+    c = (c > 0.0f) ? c : 0.0f;
+    c = (c < 255.0f) ? c : 255.0f;
+    return (unsigned char)c;
+}
+
+static void _rayui_HSVToRGBAScalar(const float* h, const float* s, const float* v, Color* out, int count) {
+    for (int i = 0; i < count; i++) {
+        out[i].r = _rayui_HSVChannel(h[i], s[i], v[i], 5.0f);
+        out[i].g = _rayui_HSVChannel(h[i], s[i], v[i], 3.0f);
+        out[i].b = _rayui_HSVChannel(h[i], s[i], v[i], 1.0f);
+        out[i].a = 255;
+    }
+}
+
+static void _rayui_RGBAToHSVScalar(const Color* in, float* h, float* s, float* v, int count) {
+    for (int i = 0; i < count; i++) {
+        float r = in[i].r / 255.0f, g = in[i].g / 255.0f, b = in[i].b / 255.0f;
+        float mn = r < g ? r : g; mn = mn < b ? mn : b;
+        float mx = r > g ? r : g; mx = mx > b ? mx : b;
+        float delta = mx - mn;
+
+        v[i] = mx;
+        if (delta < 0.00001f) { s[i] = 0.0f; h[i] = 0.0f; continue; }
+        s[i] = delta / mx;
+
+        float hue;
+        if (r >= mx) hue = (g - b) / delta;
+        else if (g >= mx) hue = 2.0f + (b - r) / delta;
+        else hue = 4.0f + (r - g) / delta;
+        hue *= 60.0f;
+        if (hue < 0.0f) hue += 360.0f;
+        h[i] = hue;
+    }
+}
+
+#if defined(RAYUI_SIMD_AVX2)
+
+static inline __m256i _rayui_HSVChannelAVX2(__m256 h60, __m256 vs, __m256 v, float n) {
+    __m256 k = _mm256_add_ps(_mm256_set1_ps(n), h60);
+    k = _mm256_sub_ps(k, _mm256_mul_ps(_mm256_set1_ps(6.0f), _mm256_floor_ps(_mm256_div_ps(k, _mm256_set1_ps(6.0f)))));
+    k = _mm256_min_ps(_mm256_sub_ps(_mm256_set1_ps(4.0f), k), k);
+    k = _mm256_max_ps(_mm256_min_ps(k, _mm256_set1_ps(1.0f)), _mm256_setzero_ps());
+    __m256 c = _mm256_mul_ps(_mm256_sub_ps(v, _mm256_mul_ps(vs, k)), _mm256_set1_ps(255.0f));
+    c = _mm256_min_ps(_mm256_max_ps(c, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)); // max returns 0 for NaN
+    return _mm256_cvttps_epi32(c);
+}
+
+static void _rayui_HSVToRGBA(const float* h, const float* s, const float* v, Color* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vv = _mm256_loadu_ps(v + i);
+        __m256 h60 = _mm256_div_ps(_mm256_loadu_ps(h + i), _mm256_set1_ps(60.0f));
+        __m256 vs = _mm256_mul_ps(vv, _mm256_loadu_ps(s + i));
+        __m256i r = _rayui_HSVChannelAVX2(h60, vs, vv, 5.0f);
+        __m256i g = _rayui_HSVChannelAVX2(h60, vs, vv, 3.0f);
+        __m256i b = _rayui_HSVChannelAVX2(h60, vs, vv, 1.0f);
+        __m256i px = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                     _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_set1_epi32((int)0xFF000000)));
+        _mm256_storeu_si256((__m256i*)(out + i), px);
+    }
+    _rayui_HSVToRGBAScalar(h + i, s + i, v + i, out + i, count - i);
+}
+
+static void _rayui_RGBAToHSV(const Color* in, float* h, float* s, float* v, int count) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256 c255 = _mm256_set1_ps(255.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256 r = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(px, mask)), c255);
+        __m256 g = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 8), mask)), c255);
+        __m256 b = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 16), mask)), c255);
+        __m256 mx = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        __m256 mn = _mm256_min_ps(r, _mm256_min_ps(g, b));
+        __m256 delta = _mm256_sub_ps(mx, mn);
+        __m256 valid = _mm256_cmp_ps(delta, _mm256_set1_ps(0.00001f), _CMP_GE_OQ);
+
+        __m256 hr = _mm256_div_ps(_mm256_sub_ps(g, b), delta);
+        __m256 hg = _mm256_add_ps(_mm256_set1_ps(2.0f), _mm256_div_ps(_mm256_sub_ps(b, r), delta));
+        __m256 hb = _mm256_add_ps(_mm256_set1_ps(4.0f), _mm256_div_ps(_mm256_sub_ps(r, g), delta));
+        __m256 hue = _mm256_blendv_ps(hb, hg, _mm256_cmp_ps(g, mx, _CMP_GE_OQ));
+        hue = _mm256_blendv_ps(hue, hr, _mm256_cmp_ps(r, mx, _CMP_GE_OQ));
+        hue = _mm256_mul_ps(hue, _mm256_set1_ps(60.0f));
+        hue = _mm256_add_ps(hue, _mm256_and_ps(_mm256_cmp_ps(hue, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(360.0f)));
+
+        _mm256_storeu_ps(h + i, _mm256_and_ps(valid, hue));
+        _mm256_storeu_ps(s + i, _mm256_and_ps(valid, _mm256_div_ps(delta, mx)));
+        _mm256_storeu_ps(v + i, mx);
+    }
+    _rayui_RGBAToHSVScalar(in + i, h + i, s + i, v + i, count - i);
+}
+
+#elif defined(RAYUI_SIMD_SSE2)
+
+static inline __m128 _rayui_SelectSSE2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Floats at or above 2^23 are already integral, and inf and NaN must pass
+// through like floorf instead of overflowing the int conversion
+static inline __m128 _rayui_FloorSSE2(__m128 x) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+    __m128 abs = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    return _rayui_SelectSSE2(_mm_cmplt_ps(abs, _mm_set1_ps(8388608.0f)), t, x);
+}
+
+static inline __m128i _rayui_HSVChannelSSE2(__m128 h60, __m128 vs, __m128 v, float n) {
+    __m128 k = _mm_add_ps(_mm_set1_ps(n), h60);
+    k = _mm_sub_ps(k, _mm_mul_ps(_mm_set1_ps(6.0f), _rayui_FloorSSE2(_mm_div_ps(k, _mm_set1_ps(6.0f)))));
+    k = _mm_min_ps(_mm_sub_ps(_mm_set1_ps(4.0f), k), k);
+    k = _mm_max_ps(_mm_min_ps(k, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+    __m128 c = _mm_mul_ps(_mm_sub_ps(v, _mm_mul_ps(vs, k)), _mm_set1_ps(255.0f));
+    c = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(255.0f)); // max returns 0 for NaN
+    return _mm_cvttps_epi32(c);
+}
+
+static void _rayui_HSVToRGBA(const float* h, const float* s, const float* v, Color* out, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vv = _mm_loadu_ps(v + i);
+        __m128 h60 = _mm_div_ps(_mm_loadu_ps(h + i), _mm_set1_ps(60.0f));
+        __m128 vs = _mm_mul_ps(vv, _mm_loadu_ps(s + i));
+        __m128i r = _rayui_HSVChannelSSE2(h60, vs, vv, 5.0f);
+        __m128i g = _rayui_HSVChannelSSE2(h60, vs, vv, 3.0f);
+        __m128i b = _rayui_HSVChannelSSE2(h60, vs, vv, 1.0f);
+        __m128i px = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                  _mm_or_si128(_mm_slli_epi32(b, 16), _mm_set1_epi32((int)0xFF000000)));
+        _mm_storeu_si128((__m128i*)(out + i), px);
+    }
+    _rayui_HSVToRGBAScalar(h + i, s + i, v + i, out + i, count - i);
 }
 
-void RAYUI_WITH_PREFIX(DrawDropdown)(RAYUI_WITH_PREFIX(Dropdown)* d, Font font, int fontSize, Color bgColor, Color textColor, Color hoverColor, Color optionBgColor, Color optionHoverColor) {
-    Color textCol = (d->hovered) ? hoverColor : textColor;
-    DrawRectangleRec(d->rect, bgColor);
+static void _rayui_RGBAToHSV(const Color* in, float* h, float* s, float* v, int count) {
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128 r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(px, mask)), c255);
+        __m128 g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), mask)), c255);
+        __m128 b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), mask)), c255);
+        __m128 mx = _mm_max_ps(r, _mm_max_ps(g, b));
+        __m128 mn = _mm_min_ps(r, _mm_min_ps(g, b));
+        __m128 delta = _mm_sub_ps(mx, mn);
+        __m128 valid = _mm_cmpge_ps(delta, _mm_set1_ps(0.00001f));
+
+        __m128 hr = _mm_div_ps(_mm_sub_ps(g, b), delta);
+        __m128 hg = _mm_add_ps(_mm_set1_ps(2.0f), _mm_div_ps(_mm_sub_ps(b, r), delta));
+        __m128 hb = _mm_add_ps(_mm_set1_ps(4.0f), _mm_div_ps(_mm_sub_ps(r, g), delta));
+        __m128 hue = _rayui_SelectSSE2(_mm_cmpge_ps(r, mx), hr, _rayui_SelectSSE2(_mm_cmpge_ps(g, mx), hg, hb));
+        hue = _mm_mul_ps(hue, _mm_set1_ps(60.0f));
+        hue = _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, _mm_setzero_ps()), _mm_set1_ps(360.0f)));
+
+        _mm_storeu_ps(h + i, _mm_and_ps(valid, hue));
+        _mm_storeu_ps(s + i, _mm_and_ps(valid, _mm_div_ps(delta, mx)));
+        _mm_storeu_ps(v + i, mx);
+    }
+    _rayui_RGBAToHSVScalar(in + i, h + i, s + i, v + i, count - i);
+}
 
-    const char* selectedText = (d->selectedIndex >= 0 && d->selectedIndex < d->optionCount) ? d->options[d->selectedIndex] : "Select";
-    Vector2 textSize = MeasureTextEx(font, selectedText, fontSize, 1);
-    Vector2 pos = { d->rect.x + 8, d->rect.y + (d->rect.height - textSize.y)/2 };
-    DrawTextEx(font, selectedText, pos, fontSize, 1, textCol);
+#elif defined(RAYUI_SIMD_NEON)
+
+static inline uint32x4_t _rayui_HSVChannelNEON(float32x4_t h60, float32x4_t vs, float32x4_t v, float n) {
+    float32x4_t k = vaddq_f32(vdupq_n_f32(n), h60);
+    k = vsubq_f32(k, vmulq_f32(vdupq_n_f32(6.0f), vrndmq_f32(vdivq_f32(k, vdupq_n_f32(6.0f)))));
+    k = vminq_f32(vsubq_f32(vdupq_n_f32(4.0f), k), k);
+    // The nm forms drop a NaN operand, matching the scalar and x86 clamps
+    k = vmaxnmq_f32(vminnmq_f32(k, vdupq_n_f32(1.0f)), vdupq_n_f32(0.0f));
+    float32x4_t c = vmulq_f32(vsubq_f32(v, vmulq_f32(vs, k)), vdupq_n_f32(255.0f));
+    c = vminnmq_f32(vmaxnmq_f32(c, vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+    return vreinterpretq_u32_s32(vcvtq_s32_f32(c));
+}
 
-    if (d->expanded) {
-        for (int i = 0; i < d->optionCount; i++) {
-            Rectangle optionRect = {d->rect.x, d->rect.y + d->rect.height * (i + 1), d->rect.width, d->rect.height};
-            Color optionBg = CheckCollisionPointRec(GetMousePosition(), optionRect) ? optionHoverColor : optionBgColor;
-            DrawRectangleRec(optionRect, optionBg);
+static void _rayui_HSVToRGBA(const float* h, const float* s, const float* v, Color* out, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t vv = vld1q_f32(v + i);
+        float32x4_t h60 = vdivq_f32(vld1q_f32(h + i), vdupq_n_f32(60.0f));
+        float32x4_t vs = vmulq_f32(vv, vld1q_f32(s + i));
+        uint32x4_t r = _rayui_HSVChannelNEON(h60, vs, vv, 5.0f);
+        uint32x4_t g = _rayui_HSVChannelNEON(h60, vs, vv, 3.0f);
+        uint32x4_t b = _rayui_HSVChannelNEON(h60, vs, vv, 1.0f);
+        uint32x4_t px = vorrq_u32(vorrq_u32(r, vshlq_n_u32(g, 8)),
+                                  vorrq_u32(vshlq_n_u32(b, 16), vdupq_n_u32(0xFF000000u)));
+        vst1q_u32((uint32_t*)(out + i), px);
+    }
+    _rayui_HSVToRGBAScalar(h + i, s + i, v + i, out + i, count - i);
+}
 
-            const char* optionText = d->options[i];
-            Vector2 optTextSize = MeasureTextEx(font, optionText, fontSize, 1);
-            Vector2 optPos = { optionRect.x + 8, optionRect.y + (optionRect.height - optTextSize.y)/2 };
-            DrawTextEx(font, optionText, optPos, fontSize, 1, textColor);
-        }
+static void _rayui_RGBAToHSV(const Color* in, float* h, float* s, float* v, int count) {
+    const uint32x4_t mask = vdupq_n_u32(0xFF);
+    const float32x4_t c255 = vdupq_n_f32(255.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t p = vld1q_u32((const uint32_t*)(in + i));
+        float32x4_t r = vdivq_f32(vcvtq_f32_u32(vandq_u32(p, mask)), c255);
+        float32x4_t g = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(p, 8), mask)), c255);
+        float32x4_t b = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(p, 16), mask)), c255);
+        float32x4_t mx = vmaxq_f32(r, vmaxq_f32(g, b));
+        float32x4_t mn = vminq_f32(r, vminq_f32(g, b));
+        float32x4_t delta = vsubq_f32(mx, mn);
+        uint32x4_t valid = vcgeq_f32(delta, vdupq_n_f32(0.00001f));
+
+        float32x4_t hr = vdivq_f32(vsubq_f32(g, b), delta);
+        float32x4_t hg = vaddq_f32(vdupq_n_f32(2.0f), vdivq_f32(vsubq_f32(b, r), delta));
+        float32x4_t hb = vaddq_f32(vdupq_n_f32(4.0f), vdivq_f32(vsubq_f32(r, g), delta));
+        float32x4_t hue = vbslq_f32(vcgeq_f32(r, mx), hr, vbslq_f32(vcgeq_f32(g, mx), hg, hb));
+        hue = vmulq_f32(hue, vdupq_n_f32(60.0f));
+        hue = vbslq_f32(vcltq_f32(hue, vdupq_n_f32(0.0f)), vaddq_f32(hue, vdupq_n_f32(360.0f)), hue);
+
+        vst1q_f32(h + i, vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(hue))));
+        vst1q_f32(s + i, vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vdivq_f32(delta, mx)))));
+        vst1q_f32(v + i, mx);
     }
+    _rayui_RGBAToHSVScalar(in + i, h + i, s + i, v + i, count - i);
 }
 
-void RAYUI_WITH_PREFIX(DrawDropdownEx)(RAYUI_WITH_PREFIX(Dropdown)* d, Font font, int fontSize,
-                                       Color bgColor, Color textColor, Color hoverColor,
-                                       Color optionBgColor, Color optionHoverColor,
-                                       int outlineWidth, Color outlineColor, const char* placeholderText)
-{
-    Color textCol = (d->hovered) ? hoverColor : textColor;
+#else
 
-    DrawRectangleRec(d->rect, bgColor);
+static void _rayui_HSVToRGBA(const float* h, const float* s, const float* v, Color* out, int count) {
+    _rayui_HSVToRGBAScalar(h, s, v, out, count);
+}
 
-    const char* selectedText = (d->selectedIndex >= 0 && d->selectedIndex < d->optionCount) ? d->options[d->selectedIndex] : placeholderText;
-    Vector2 textSize = MeasureTextEx(font, selectedText, fontSize, 1);
-    Vector2 pos = { d->rect.x + 8, d->rect.y + (d->rect.height - textSize.y)/2 };
-    DrawTextEx(font, selectedText, pos, fontSize, 1, textCol);
+static void _rayui_RGBAToHSV(const Color* in, float* h, float* s, float* v, int count) {
+    _rayui_RGBAToHSVScalar(in, h, s, v, count);
+}
 
-    if (d->expanded) {
-        for (int i = 0; i < d->optionCount; i++) {
-            Rectangle optionRect = { d->rect.x, d->rect.y + d->rect.height * (i + 1), d->rect.width, d->rect.height };
-            Color optionBg = CheckCollisionPointRec(GetMousePosition(), optionRect) ? optionHoverColor : optionBgColor;
-            DrawRectangleRec(optionRect, optionBg);
-
-            const char* optionText = d->options[i];
-            Vector2 optTextSize = MeasureTextEx(font, optionText, fontSize, 1);
-            Vector2 optPos = { optionRect.x + 8, optionRect.y + (optionRect.height - optTextSize.y)/2 };
-            DrawTextEx(font, optionText, optPos, fontSize, 1, textColor);
-
-            if (outlineWidth > 0) {
-                Rectangle divider = { d->rect.x, optionRect.y, d->rect.width, (float)outlineWidth };
-                DrawRectangleRec(divider, outlineColor);
-            }
-        }
+#endif
 
-        if (outlineWidth > 0) {
-            Rectangle divider = { d->rect.x, d->rect.y + d->rect.height, d->rect.width, (float)outlineWidth };
-            DrawRectangleRec(divider, outlineColor);
+#define _RAYUI_HSV_CHUNK 256
+
+void RAYUI_WITH_PREFIX(ColorsFromHSV)(const Vector3* hsv, Color* colors, int count) {
+    float h[_RAYUI_HSV_CHUNK], s[_RAYUI_HSV_CHUNK], v[_RAYUI_HSV_CHUNK];
+    for (int base = 0; base < count; base += _RAYUI_HSV_CHUNK) {
+        int n = (count - base < _RAYUI_HSV_CHUNK) ? count - base : _RAYUI_HSV_CHUNK;
+        for (int i = 0; i < n; i++) {
+            h[i] = hsv[base + i].x;
+            s[i] = hsv[base + i].y;
+            v[i] = hsv[base + i].z;
         }
+        _rayui_HSVToRGBA(h, s, v, colors + base, n);
     }
+}
 
-    if (outlineWidth > 0) {
-        float totalHeight = d->rect.height + (d->expanded ? d->rect.height * d->optionCount : 0);
-        Rectangle totalRect = { d->rect.x, d->rect.y, d->rect.width, totalHeight };
-        DrawRectangleLinesEx(totalRect, outlineWidth, outlineColor);
+void RAYUI_WITH_PREFIX(ColorsToHSV)(const Color* colors, Vector3* hsv, int count) {
+    float h[_RAYUI_HSV_CHUNK], s[_RAYUI_HSV_CHUNK], v[_RAYUI_HSV_CHUNK];
+    for (int base = 0; base < count; base += _RAYUI_HSV_CHUNK) {
+        int n = (count - base < _RAYUI_HSV_CHUNK) ? count - base : _RAYUI_HSV_CHUNK;
+        _rayui_RGBAToHSV(colors + base, h, s, v, n);
+        for (int i = 0; i < n; i++) hsv[base + i] = (Vector3){h[i], s[i], v[i]};
     }
 }
 
-const char* RAYUI_WITH_PREFIX(DropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d) {
-    if (d->selectedIndex < 0 || d->selectedIndex >= d->optionCount) return NULL;
-    return d->options[d->selectedIndex];
-}
+// ---------------- COLOR PICKER ----------------
 
-void RAYUI_WITH_PREFIX(SetDropdownValue)(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
-    if (index < 0 || index >= d->optionCount) return;
-    d->selectedIndex = index;
+// Width of the value and alpha tracks HSV modes draw right of the square
+static float _rayui_ColorPickerStripWidth(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    if (cp->mode != COLOR_PICKER_MODE_HSV && cp->mode != COLOR_PICKER_MODE_HSVA) return 0;
+    return cp->showAlpha ? 32 : 16;
 }
 
-int RAYUI_WITH_PREFIX(GetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d) {
-    return d->selectedIndex;
-}
+// Value, channel and alpha tracks are placed from the rect and mode; tracks
+// the mode doesn't use are left empty
+static void _rayui_ColorPickerGeometry(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    float x = cp->rect.x, y = cp->rect.y, width = cp->rect.width, height = cp->rect.height;
+    float sliderWidth = 12;
+    float sliderSpacing = 2;
+    bool hsv = cp->mode == COLOR_PICKER_MODE_HSV || cp->mode == COLOR_PICKER_MODE_HSVA;
 
-void RAYUI_WITH_PREFIX(SetDropdownIndex)(RAYUI_WITH_PREFIX(Dropdown)* d, int index) {
-    if (index < 0 || index >= d->optionCount) return;
-    d->selectedIndex = index;
-}
+    cp->valueRect = hsv ? (Rectangle){x + width + 4, y, 12, height} : (Rectangle){0, 0, 0, 0};
 
-// ---------------- COLOR PICKER ----------------
+    // RGB sliders
+    if (!hsv) {
+        cp->sliderR = (Rectangle){x, y, sliderWidth, height};
+        cp->sliderG = (Rectangle){x + sliderWidth + sliderSpacing, y, sliderWidth, height};
+        cp->sliderB = (Rectangle){x + 2*(sliderWidth + sliderSpacing), y, sliderWidth, height};
+    } else {
+        cp->sliderR = cp->sliderG = cp->sliderB = (Rectangle){0, 0, 0, 0};
+    }
+
+    // Alpha slider
+    if (!cp->showAlpha) {
+        cp->alphaRect = (Rectangle){0, 0, 0, 0};
+    } else if (cp->mode == COLOR_PICKER_MODE_RGBA) {
+        cp->alphaRect = (Rectangle){x + 3*(sliderWidth + sliderSpacing) + sliderSpacing, y, sliderWidth, height};
+    } else {
+        cp->alphaRect = (Rectangle){x + width + 4 + 16, y, 12, height};
+    }
+}
 
 RAYUI_WITH_PREFIX(ColorPicker) RAYUI_WITH_PREFIX(CreateColorPicker)(float x, float y, float size, Color initialColor, RAYUI_WITH_PREFIX(ColorPickerMode) mode) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
     RAYUI_WITH_PREFIX(ColorPicker) cp;
     cp.rect = (Rectangle){x, y, size, size};
     cp.selectedColor = initialColor;
@@ -1563,43 +7056,37 @@ RAYUI_WITH_PREFIX(ColorPicker) RAYUI_WITH_PREFIX(CreateColorPicker)(float x, flo
     cp.hover.hovered = false;
     cp.hover.delay = DEFAULT_HOVER_INFO_DELAY;
     cp.hover.active = false;
-    cp.hoverSound = _rayui_DefaultSound;
-    cp.clickSound = _rayui_DefaultSound;
+    cp.hover.handle = 0;
+    cp.hover.hitHandle = 0;
+    cp.hoverSound = ctx->defaultSound;
+    cp.clickSound = ctx->defaultSound;
     cp.expanded = true;
     cp.showAlpha = (mode == COLOR_PICKER_MODE_RGBA || mode == COLOR_PICKER_MODE_HSVA);
     cp.draggingAlpha = false;
     cp.draggingColor = false;
+    cp.draggingValue = false;
 
     // HSV selector
     if (mode == COLOR_PICKER_MODE_HSV || mode == COLOR_PICKER_MODE_HSVA) {
-        Vector3 hsv = ColorToHSV(initialColor);
+        Vector3 hsv;
+        RAYUI_WITH_PREFIX(ColorsToHSV)(&initialColor, &hsv, 1);
         cp.selectorPos = (Vector2){hsv.x / 360.0f, hsv.y};
+        cp.value = hsv.z;
     } else {
         cp.selectorPos = (Vector2){0, 0};
+        cp.value = 1.0f;
     }
-
-    // RGB sliders
-    float sliderWidth = 12;
-    float sliderSpacing = 2;
-    if (mode == COLOR_PICKER_MODE_RGB || mode == COLOR_PICKER_MODE_RGBA) {
-        cp.sliderR = (Rectangle){x, y, sliderWidth, size};
-        cp.sliderG = (Rectangle){x + sliderWidth + sliderSpacing, y, sliderWidth, size};
-        cp.sliderB = (Rectangle){x + 2*(sliderWidth + sliderSpacing), y, sliderWidth, size};
-    }
-
-    // Alpha slider
-    if (cp.showAlpha) {
-        if (mode == COLOR_PICKER_MODE_RGBA) {
-            cp.alphaRect = (Rectangle){x + 3*(sliderWidth + sliderSpacing) + sliderSpacing, y, sliderWidth, size};
-        } else {
-            cp.alphaRect = (Rectangle){x + size + 4, y, 12, size};
-        }
-    }
+    _rayui_ColorPickerGeometry(&cp);
 
     cp.draggingSliderR = false;
     cp.draggingSliderG = false;
     cp.draggingSliderB = false;
 
+    cp.gradientTexture = (Texture){0};
+    cp.rampTexture = (Texture){0};
+    cp.cachedRect = (Rectangle){0, 0, 0, 0};
+    cp.cachedMode = mode;
+
     return cp;
 }
 
@@ -1610,20 +7097,22 @@ RAYUI_WITH_PREFIX(ColorPicker) RAYUI_WITH_PREFIX(CreateColorPickerWithSound)(flo
     return cp;
 }
 
-void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
-    Vector2 mouse = GetMousePosition();
+static void _rayui_UpdateColorPicker(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    Vector2 mouse = _rayui_MousePosition();
 
-    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && CheckCollisionPointRec(mouse, cp->rect))
+    if (_rayui_MousePressed(MOUSE_BUTTON_RIGHT) && CheckCollisionPointRec(mouse, cp->rect))
         cp->expanded = !cp->expanded;
     if (!cp->expanded) return;
 
     cp->hovered = CheckCollisionPointRec(mouse, cp->rect);
     cp->hover.hovered = cp->hovered;
+    _rayui_SyncHover(&cp->hover);
 
     // Reset dragging flags only when mouse released
-    if (!IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+    if (!_rayui_MouseDown(MOUSE_LEFT_BUTTON)) {
         cp->draggingAlpha = false;
         cp->draggingColor = false;
+        cp->draggingValue = false;
         cp->draggingSliderR = false;
         cp->draggingSliderG = false;
         cp->draggingSliderB = false;
@@ -1638,7 +7127,7 @@ void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
             cp->selectorPos = (Vector2){rx, ry};
             float h = rx * 360.0f;
             float s = ry;
-            Color c = ColorFromHSV(h, s, 1.0f);
+            Color c = ColorFromHSV(h, s, cp->value);
             if (cp->mode == COLOR_PICKER_MODE_HSVA) c.a = cp->selectedColor.a;
             cp->selectedColor = c;
         } else {
@@ -1657,6 +7146,14 @@ void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
         return; // do not allow alpha while dragging color
     }
 
+    if (cp->draggingValue) {
+        cp->value = Clamp((mouse.y - cp->valueRect.y) / cp->valueRect.height, 0.0f, 1.0f);
+        Color c = ColorFromHSV(cp->selectorPos.x * 360.0f, cp->selectorPos.y, cp->value);
+        if (cp->mode == COLOR_PICKER_MODE_HSVA) c.a = cp->selectedColor.a;
+        cp->selectedColor = c;
+        return;
+    }
+
     if (cp->draggingAlpha) {
         float rel = Clamp((mouse.y - cp->alphaRect.y) / cp->alphaRect.height, 0.0f, 1.0f);
         cp->selectedColor.a = (unsigned char)(rel * 255);
@@ -1665,8 +7162,10 @@ void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
 
     // Start dragging: check which area the mouse pressed first
     if (cp->mode == COLOR_PICKER_MODE_HSV || cp->mode == COLOR_PICKER_MODE_HSVA) {
-        if (CheckCollisionPointRec(mouse, cp->rect) && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+        if (CheckCollisionPointRec(mouse, cp->rect) && _rayui_MouseDown(MOUSE_LEFT_BUTTON))
             cp->draggingColor = true;
+        else if (CheckCollisionPointRec(mouse, cp->valueRect) && _rayui_MouseDown(MOUSE_LEFT_BUTTON))
+            cp->draggingValue = true;
     } else {
         struct {Rectangle* r; bool* dragging;} sliders[3] = {
             {&cp->sliderR, &cp->draggingSliderR},
@@ -1674,102 +7173,225 @@ void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
             {&cp->sliderB, &cp->draggingSliderB},
         };
         for (int i = 0; i < 3; i++) {
-            if (CheckCollisionPointRec(mouse, *sliders[i].r) && IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+            if (CheckCollisionPointRec(mouse, *sliders[i].r) && _rayui_MouseDown(MOUSE_LEFT_BUTTON)) {
                 *sliders[i].dragging = true;
                 cp->draggingColor = true;
             }
         }
     }
 
-    if (cp->showAlpha && CheckCollisionPointRec(mouse, cp->alphaRect) && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+    if (cp->showAlpha && CheckCollisionPointRec(mouse, cp->alphaRect) && _rayui_MouseDown(MOUSE_LEFT_BUTTON))
         cp->draggingAlpha = true;
 }
 
+void RAYUI_WITH_PREFIX(UpdateColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_COLOR_PICKER);
+    _rayui_UpdateColorPicker(cp);
+    _RAYUI_STATS_END(WIDGET_TYPE_COLOR_PICKER, false);
+}
+
+static void _rayui_UpdateColorPickerTextures(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    bool hsv = (cp->mode == COLOR_PICKER_MODE_HSV || cp->mode == COLOR_PICKER_MODE_HSVA);
+    bool sizeChanged = (int)cp->cachedRect.width != (int)cp->rect.width ||
+                       (int)cp->cachedRect.height != (int)cp->rect.height;
+    bool modeChanged = cp->cachedMode != cp->mode;
+
+    if (hsv && (cp->gradientTexture.id == 0 || sizeChanged || modeChanged)) {
+        int w = (int)cp->rect.width;
+        int h = (int)cp->rect.height;
+        if (w < 1) w = 1;
+        if (h < 1) h = 1;
+
+        // Built at full value, the draw tint scales it by cp->value (HSV value is linear in RGB)
+        Image img = GenImageColor(w, h, BLANK);
+        Color* pixels = (Color*)img.data;
+        float* row = (float*)RAYUI_MALLOC(3 * w * sizeof(float));
+        if (!pixels || !row) {
+            // Out of memory: keep the old texture and cache state, the next draw retries
+            RAYUI_FREE(row);
+            UnloadImage(img);
+            return;
+        }
+        float* hue = row;
+        float* sat = row + w;
+        float* val = row + 2*w;
+        for (int x = 0; x < w; x++) {
+            hue[x] = (float)x / w * 360.0f;
+            val[x] = 1.0f;
+        }
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) sat[x] = (float)y / h;
+            _rayui_HSVToRGBA(hue, sat, val, pixels + y*w, w);
+        }
+        RAYUI_FREE(row);
+
+        if (cp->gradientTexture.id) UnloadTexture(cp->gradientTexture);
+        cp->gradientTexture = LoadTextureFromImage(img);
+        UnloadImage(img);
+    } else if (!hsv && cp->gradientTexture.id) {
+        UnloadTexture(cp->gradientTexture);
+        cp->gradientTexture = (Texture){0};
+    }
+
+    // One texel per 8-bit step, so the ramps do not depend on the rect size
+    if (cp->rampTexture.id == 0) {
+        Image img = GenImageColor(2, 256, BLANK);
+        Color* pixels = (Color*)img.data;
+        if (!pixels) return;
+        for (int y = 0; y < 256; y++) {
+            unsigned char v = (unsigned char)y;
+            pixels[y*2 + 0] = (Color){v, v, v, 255};
+            pixels[y*2 + 1] = (Color){255, 255, 255, v};
+        }
+
+        cp->rampTexture = LoadTextureFromImage(img);
+        UnloadImage(img);
+    }
+
+    cp->cachedRect = cp->rect;
+    cp->cachedMode = cp->mode;
+}
+
 void RAYUI_WITH_PREFIX(DrawColorPicker)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_COLOR_PICKER);
     RAYUI_WITH_PREFIX(DrawColorPickerEx)(cp, 1, GRAY, WHITE);
+    _RAYUI_STATS_END(WIDGET_TYPE_COLOR_PICKER, true);
 }
 
-void RAYUI_WITH_PREFIX(DrawColorPickerEx)(RAYUI_WITH_PREFIX(ColorPicker)* cp,
-                                          int outlineWidth,
-                                          Color outlineColor,
-                                          Color thumbColor) {
+static void _rayui_DrawColorPickerEx(RAYUI_WITH_PREFIX(ColorPicker)* cp,
+                                     int outlineWidth,
+                                     Color outlineColor,
+                                     Color thumbColor) {
     if (!cp->expanded) {
-        DrawRectangleRec(cp->rect, cp->selectedColor);
-        DrawTriangle((Vector2){cp->rect.x + cp->rect.width / 2 - 4, cp->rect.y + cp->rect.height / 2 - 2},
+        _rayui_DrawRectangleRec(cp->rect, cp->selectedColor);
+        _rayui_DrawTriangle((Vector2){cp->rect.x + cp->rect.width / 2 - 4, cp->rect.y + cp->rect.height / 2 - 2},
                      (Vector2){cp->rect.x + cp->rect.width / 2 + 4, cp->rect.y + cp->rect.height / 2 - 2},
                      (Vector2){cp->rect.x + cp->rect.width / 2, cp->rect.y + cp->rect.height / 2 + 4},
                      DARKGRAY);
         return;
     }
 
+    _rayui_UpdateColorPickerTextures(cp);
+
     if (cp->mode == COLOR_PICKER_MODE_HSV || cp->mode == COLOR_PICKER_MODE_HSVA) {
-        for (int y = 0; y < (int)cp->rect.height; y++)
-            for (int x = 0; x < (int)cp->rect.width; x++)
-                DrawPixel((int)(cp->rect.x + x), (int)(cp->rect.y + y), ColorFromHSV((float)x / cp->rect.width * 360.0f, (float)y / cp->rect.height, 1.0f));
+        Rectangle src = {0, 0, (float)cp->gradientTexture.width, (float)cp->gradientTexture.height};
+        unsigned char v = (unsigned char)(cp->value * 255.0f);
+        _rayui_DrawTexturePro(cp->gradientTexture, src, cp->rect, (Color){v, v, v, 255});
 
         if (outlineWidth > 0)
-            DrawRectangleLinesEx(cp->rect, outlineWidth, outlineColor);
+            _rayui_DrawRectangleLinesEx(cp->rect, outlineWidth, outlineColor);
 
         float dotX = cp->rect.x + cp->selectorPos.x * cp->rect.width;
         float dotY = cp->rect.y + cp->selectorPos.y * cp->rect.height;
-        DrawCircle((int)dotX, (int)dotY, 4, BLACK);
-        DrawCircleLines((int)dotX, (int)dotY, 4, thumbColor);
+        _rayui_DrawCircle((int)dotX, (int)dotY, 4, BLACK);
+        _rayui_DrawCircleLines((int)dotX, (int)dotY, 4, thumbColor);
+
+        // Value track: grey ramp tinted by the full-brightness hue
+        Rectangle rampSrc = {0, 0, 1, (float)cp->rampTexture.height};
+        Color full = ColorFromHSV(cp->selectorPos.x * 360.0f, cp->selectorPos.y, 1.0f);
+        _rayui_DrawTexturePro(cp->rampTexture, rampSrc, cp->valueRect, full);
+
+        if (outlineWidth > 0)
+            _rayui_DrawRectangleLinesEx(cp->valueRect, outlineWidth, outlineColor);
+
+        float thumbY = cp->valueRect.y + cp->value * cp->valueRect.height;
+        _rayui_DrawRectangleRec((Rectangle){(int)cp->valueRect.x - 1, (int)thumbY - 2, (int)cp->valueRect.width + 2, 4}, thumbColor);
 
     } else {
-        struct {Rectangle* r; unsigned char val; Color color;} sliders[3] = {
-            {&cp->sliderR, cp->selectedColor.r, RED},
-            {&cp->sliderG, cp->selectedColor.g, GREEN},
-            {&cp->sliderB, cp->selectedColor.b, BLUE},
+        // One grey ramp tinted per channel: (v, v, v) * (1, 0, 0) == (v, 0, 0)
+        struct {Rectangle* r; unsigned char val; Color tint;} sliders[3] = {
+            {&cp->sliderR, cp->selectedColor.r, (Color){255, 0, 0, 255}},
+            {&cp->sliderG, cp->selectedColor.g, (Color){0, 255, 0, 255}},
+            {&cp->sliderB, cp->selectedColor.b, (Color){0, 0, 255, 255}},
         };
+        Rectangle src = {0, 0, 1, (float)cp->rampTexture.height};
         for (int i = 0; i < 3; i++) {
             Rectangle rect = *sliders[i].r;
-            for (int y = 0; y < (int)rect.height; y++) {
-                float t = (float)y / rect.height;
-                unsigned char v = (unsigned char)(t * 255);
-                Color c = sliders[i].color;
-                c.r = (i==0)? v : 0;
-                c.g = (i==1)? v : 0;
-                c.b = (i==2)? v : 0;
-                DrawRectangle((int)rect.x, (int)(rect.y + y), (int)rect.width, 1, c);
-            }
+            _rayui_DrawTexturePro(cp->rampTexture, src, rect, sliders[i].tint);
 
             if (outlineWidth > 0)
-                DrawRectangleLinesEx(rect, outlineWidth, outlineColor);
+                _rayui_DrawRectangleLinesEx(rect, outlineWidth, outlineColor);
 
             float thumbY = rect.y + ((float)sliders[i].val / 255.0f) * rect.height;
-            DrawRectangle((int)rect.x - 1, (int)thumbY - 2, (int)rect.width + 2, 4, thumbColor);
+            _rayui_DrawRectangleRec((Rectangle){(int)rect.x - 1, (int)thumbY - 2, (int)rect.width + 2, 4}, thumbColor);
         }
     }
 
     if (cp->showAlpha) {
-        for (int y = 0; y < (int)cp->alphaRect.height; y++) {
-            float t = (float)y / cp->alphaRect.height;
-            Color c = cp->selectedColor;
-            c.a = (unsigned char)(t * 255);
-            DrawRectangle((int)cp->alphaRect.x, (int)(cp->alphaRect.y + y), (int)cp->alphaRect.width, 1, Fade(c, t));
-        }
+        // White alpha ramp tinted by the current color, so color changes need no rebuild
+        Rectangle src = {1, 0, 1, (float)cp->rampTexture.height};
+        Color tint = {cp->selectedColor.r, cp->selectedColor.g, cp->selectedColor.b, 255};
+        _rayui_DrawTexturePro(cp->rampTexture, src, cp->alphaRect, tint);
 
         if (outlineWidth > 0)
-            DrawRectangleLinesEx(cp->alphaRect, outlineWidth, outlineColor);
+            _rayui_DrawRectangleLinesEx(cp->alphaRect, outlineWidth, outlineColor);
 
         float thumbY = cp->alphaRect.y + ((float)cp->selectedColor.a / 255.0f) * cp->alphaRect.height;
-        DrawRectangle((int)cp->alphaRect.x - 1, (int)thumbY - 2, (int)cp->alphaRect.width + 2, 4, thumbColor);
+        _rayui_DrawRectangleRec((Rectangle){(int)cp->alphaRect.x - 1, (int)thumbY - 2, (int)cp->alphaRect.width + 2, 4}, thumbColor);
     }
 }
 
+void RAYUI_WITH_PREFIX(DrawColorPickerEx)(RAYUI_WITH_PREFIX(ColorPicker)* cp,
+                                          int outlineWidth,
+                                          Color outlineColor,
+                                          Color thumbColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_COLOR_PICKER);
+    _rayui_DrawColorPickerEx(cp, outlineWidth, outlineColor, thumbColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_COLOR_PICKER, true);
+}
+
 Color RAYUI_WITH_PREFIX(GetColorPickerValue)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
     return cp->selectedColor;
 }
 
 void RAYUI_WITH_PREFIX(SetColorPickerValue)(RAYUI_WITH_PREFIX(ColorPicker)* cp, Color color) {
     cp->selectedColor = color;
+
+    if (cp->mode == COLOR_PICKER_MODE_HSV || cp->mode == COLOR_PICKER_MODE_HSVA) {
+        Vector3 hsv;
+        RAYUI_WITH_PREFIX(ColorsToHSV)(&color, &hsv, 1);
+        cp->selectorPos = (Vector2){hsv.x / 360.0f, hsv.y};
+        cp->value = hsv.z;
+    }
+}
+
+void RAYUI_WITH_PREFIX(FreeColorPickerTextures)(RAYUI_WITH_PREFIX(ColorPicker)* cp) {
+    if (cp->gradientTexture.id) UnloadTexture(cp->gradientTexture);
+    if (cp->rampTexture.id) UnloadTexture(cp->rampTexture);
+    cp->gradientTexture = (Texture){0};
+    cp->rampTexture = (Texture){0};
+}
+
+void RAYUI_WITH_PREFIX(SetColorPickerRect)(RAYUI_WITH_PREFIX(ColorPicker)* cp, Rectangle rect) {
+    cp->rect = rect;
+    _rayui_ColorPickerGeometry(cp);
 }
 
 // ---------------- NUMERIC INPUT ----------------
 
+// Arrow triangles follow the rect
+static void _rayui_NumericInputGeometry(RAYUI_WITH_PREFIX(NumericInput)* n) {
+    float x = n->rect.x, y = n->rect.y, width = n->rect.width, height = n->rect.height;
+    float triHeight = height / 6.0f;
+    float triWidth = width / 5.0f;
+
+    n->upTriangle = (Triangle){
+        {x + width / 2, y + 2},
+        {x + width / 2 - triWidth, y + triHeight},
+        {x + width / 2 + triWidth, y + triHeight}
+    };
+
+    n->downTriangle = (Triangle){
+        {x + width / 2 + triWidth, y + height - 2 - triHeight},
+        {x + width / 2 - triWidth, y + height - 2 - triHeight},
+        {x + width / 2, y + height - 2}
+    };
+}
+
 RAYUI_WITH_PREFIX(NumericInput) RAYUI_WITH_PREFIX(CreateNumericInput)(
     float x, float y, float width, float height, float initialValue,
     float minValue, float maxValue, float step, int decimalPlaces) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
     RAYUI_WITH_PREFIX(NumericInput) n;
 
     n.rect = (Rectangle){x, y, width, height};
@@ -1780,29 +7402,16 @@ RAYUI_WITH_PREFIX(NumericInput) RAYUI_WITH_PREFIX(CreateNumericInput)(
     n.step = step;
     n.hoveredUp = false;
     n.hoveredDown = false;
-    n.hoverSound = _rayui_DefaultSound;
-    n.clickSound = _rayui_DefaultSound;
+    n.hoverSound = ctx->defaultSound;
+    n.clickSound = ctx->defaultSound;
     n.hover.hoverInfo = NULL;
     n.hover.hoverStartTime = 0;
     n.hover.hovered = false;
     n.hover.delay = DEFAULT_HOVER_INFO_DELAY;
     n.hover.active = false;
-
-    float triHeight = height / 6.0f;
-    float triWidth = width / 5.0f;
-
-    n.upTriangle = (Triangle){
-        {x + width / 2, y + 2},
-        {x + width / 2 - triWidth, y + triHeight},
-        {x + width / 2 + triWidth, y + triHeight}
-    };
-
-    n.downTriangle = (Triangle){
-        {x + width / 2 + triWidth, y + height - 2 - triHeight},
-        {x + width / 2 - triWidth, y + height - 2 - triHeight},
-        {x + width / 2, y + height - 2}
-    };
-
+    n.hover.handle = 0;
+    n.hover.hitHandle = 0;
+    _rayui_NumericInputGeometry(&n);
 
     return n;
 }
@@ -1815,36 +7424,44 @@ RAYUI_WITH_PREFIX(NumericInput) RAYUI_WITH_PREFIX(CreateNumericInputWithSound)(f
 }
 
 void RAYUI_WITH_PREFIX(UpdateNumericInput)(RAYUI_WITH_PREFIX(NumericInput)* n) {
-    Vector2 mouse = GetMousePosition();
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_NUMERIC_INPUT);
+    Vector2 mouse = _rayui_MousePosition();
 
     bool prevHoveredUp = n->hoveredUp;
     bool prevHoveredDown = n->hoveredDown;
 
-    n->hoveredUp   = CheckCollisionPointTriangle(mouse, n->upTriangle.a, n->upTriangle.b, n->upTriangle.c);
-    n->hoveredDown = CheckCollisionPointTriangle(mouse, n->downTriangle.a, n->downTriangle.b, n->downTriangle.c);
+    bool candidate = _rayui_HitTest(&n->hover, n->rect, mouse);
+    Triangle arrows[2] = { n->upTriangle, n->downTriangle };
+    unsigned int hit = 0;
+    if (candidate) RAYUI_WITH_PREFIX(PointInTriangles)(mouse, arrows, 2, &hit);
+    n->hoveredUp   = hit & 1u;
+    n->hoveredDown = (hit >> 1) & 1u;
 
     // Hover sound
-    if (n->hoveredUp && !prevHoveredUp && n->hoverSound.frameCount > 0) PlaySound(n->hoverSound);
-    if (n->hoveredDown && !prevHoveredDown && n->hoverSound.frameCount > 0) PlaySound(n->hoverSound);
+    if (n->hoveredUp && !prevHoveredUp && n->hoverSound.frameCount > 0) _rayui_PlaySound(n->hoverSound);
+    if (n->hoveredDown && !prevHoveredDown && n->hoverSound.frameCount > 0) _rayui_PlaySound(n->hoverSound);
 
     // Click
-    if (n->hoveredUp && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+    if (n->hoveredUp && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
         n->value += n->step;
         if (n->value > n->maxValue) n->value = n->maxValue;
-        if (n->clickSound.frameCount > 0) PlaySound(n->clickSound);
+        if (n->clickSound.frameCount > 0) _rayui_PlaySound(n->clickSound);
     }
-    else if (n->hoveredDown && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+    else if (n->hoveredDown && _rayui_MousePressed(MOUSE_LEFT_BUTTON)) {
         n->value -= n->step;
         if (n->value < n->minValue) n->value = n->minValue;
-        if (n->clickSound.frameCount > 0) PlaySound(n->clickSound);
+        if (n->clickSound.frameCount > 0) _rayui_PlaySound(n->clickSound);
     }
+    _RAYUI_STATS_END(WIDGET_TYPE_NUMERIC_INPUT, false);
 }
 
 void RAYUI_WITH_PREFIX(DrawNumericInput)(
     RAYUI_WITH_PREFIX(NumericInput)* n,
     Font font, int fontSize,
     Color bgColor, Color textColor) {
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_NUMERIC_INPUT);
     RAYUI_WITH_PREFIX(DrawNumericInputEx)(n, font, fontSize, bgColor, textColor, GRAY, DARKGRAY, 0, BLACK);
+    _RAYUI_STATS_END(WIDGET_TYPE_NUMERIC_INPUT, true);
 }
 
 void RAYUI_WITH_PREFIX(DrawNumericInputEx)(
@@ -1852,18 +7469,19 @@ void RAYUI_WITH_PREFIX(DrawNumericInputEx)(
     Font font, int fontSize,
     Color bgColor, Color textColor,
     Color triangleColor, Color triangleHoverColor, int outlineWidth, Color outlineColor) {
-    DrawRectangleRec(n->rect, bgColor);
+    _RAYUI_STATS_BEGIN(WIDGET_TYPE_NUMERIC_INPUT);
+    _rayui_DrawRectangleRec(n->rect, bgColor);
 
     float triHeight = n->rect.height / 6.0f;
 
-    DrawTriangle(
+    _rayui_DrawTriangle(
         n->upTriangle.a,
         n->upTriangle.b,
         n->upTriangle.c,
         n->hoveredUp ? triangleHoverColor : triangleColor
     );
 
-    DrawTriangle(
+    _rayui_DrawTriangle(
         n->downTriangle.a,
         n->downTriangle.b,
         n->downTriangle.c,
@@ -1877,17 +7495,18 @@ void RAYUI_WITH_PREFIX(DrawNumericInputEx)(
             n->rect.width + outlineWidth * 2,
             n->rect.height + outlineWidth * 2
         };
-        DrawRectangleLinesEx(outlineRect, outlineWidth, outlineColor);
+        _rayui_DrawRectangleLinesEx(outlineRect, outlineWidth, outlineColor);
     }
 
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%.*f", n->decimalPlaces, n->value);
-    Vector2 size = MeasureTextEx(font, buffer, fontSize, 1);
+    const char* text = _rayui_FrameFormat("%.*f", n->decimalPlaces, n->value);
+    if (!text) text = "";
+    Vector2 size = RAYUI_WITH_PREFIX(MeasureTextCached)(font, text, fontSize, 1);
     Vector2 pos = {
         n->rect.x + (n->rect.width - size.x)/2,
         n->rect.y + triHeight + ((n->rect.height - 2*triHeight - size.y)/2)
     };
-    DrawTextEx(font, buffer, pos, fontSize, 1, textColor);
+    _rayui_DrawTextEx(font, text, pos, fontSize, 1, textColor);
+    _RAYUI_STATS_END(WIDGET_TYPE_NUMERIC_INPUT, true);
 }
 
 float RAYUI_WITH_PREFIX(GetNumericInputValue)(RAYUI_WITH_PREFIX(NumericInput)* n) {
@@ -1900,6 +7519,642 @@ void RAYUI_WITH_PREFIX(SetNumericInputValue)(RAYUI_WITH_PREFIX(NumericInput)* n,
     n->value = value;
 }
 
+void RAYUI_WITH_PREFIX(SetNumericInputRect)(RAYUI_WITH_PREFIX(NumericInput)* n, Rectangle rect) {
+    n->rect = rect;
+    _rayui_NumericInputGeometry(n);
+}
+
+// ---------------- LAYOUT ----------------
+// Nodes live in one array and link to their children through first/next
+// indices. Setters only flag the node whose arrangement changed and mark its
+// ancestors with childDirty, so UpdateLayout walks down the flagged branches
+// alone. A re-arranged container flags the children whose rect changed as
+// moved, and only those are visited further, so a resize that leaves a branch
+// in place costs nothing below it.
+
+typedef struct _rayui_LayoutNode {
+    RAYUI_WITH_PREFIX(LayoutKind) kind;
+    int parent;
+    int firstChild;
+    int lastChild;
+    int next;
+    int childCount;
+    float width, height; // 0 stretches
+    float spacing;
+    float padding;
+    int columns;
+    float rowHeight;
+    RAYUI_WITH_PREFIX(LayoutAnchor) anchor;
+    Vector2 offset;
+    RAYUI_WITH_PREFIX(WidgetType) widgetType;
+    void* widget;
+    Rectangle rect;
+    bool dirty;      // children need to be re-arranged
+    bool childDirty; // some descendant is dirty
+    bool moved;      // rect changed since the last visit
+} _rayui_LayoutNode;
+
+// A bar keeps its height, centred in the cell, and is inset by `inset` on
+// both ends so a knob that overhangs it stays inside the cell
+static Rectangle _rayui_BarInCell(Rectangle cell, float height, float inset) {
+    if (height > cell.height) height = cell.height;
+    float width = cell.width - 2*inset;
+    return (Rectangle){ cell.x + inset, cell.y + (cell.height - height)/2, width > 0 ? width : 0, height };
+}
+
+void RAYUI_WITH_PREFIX(SetWidgetRect)(RAYUI_WITH_PREFIX(WidgetType) type, void* widget, Rectangle rect) {
+    if (!widget) return;
+    switch (type) {
+        case WIDGET_TYPE_BUTTON: ((RAYUI_WITH_PREFIX(Button)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_TOGGLE: ((RAYUI_WITH_PREFIX(ToggleLabel)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_CHECKBOX: ((RAYUI_WITH_PREFIX(Checkbox)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_SLIDER: {
+            // The 16x15 knob overhangs the bar by 8 on each end
+            RAYUI_WITH_PREFIX(Slider)* s = (RAYUI_WITH_PREFIX(Slider)*)widget;
+            s->bar = _rayui_BarInCell(rect, s->bar.height, 8);
+        } break;
+        case WIDGET_TYPE_OPTION_SLIDER: {
+            RAYUI_WITH_PREFIX(OptionSlider)* s = (RAYUI_WITH_PREFIX(OptionSlider)*)widget;
+            s->bar = _rayui_BarInCell(rect, s->bar.height, 8);
+        } break;
+        case WIDGET_TYPE_KEYBIND: ((RAYUI_WITH_PREFIX(KeybindInput)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_TEXT_INPUT: ((RAYUI_WITH_PREFIX(TextInput)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_PROGRESS_BAR: {
+            RAYUI_WITH_PREFIX(ProgressBar)* p = (RAYUI_WITH_PREFIX(ProgressBar)*)widget;
+            p->bar = _rayui_BarInCell(rect, p->bar.height, 0);
+        } break;
+        case WIDGET_TYPE_DROPDOWN: ((RAYUI_WITH_PREFIX(Dropdown)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_COLOR_PICKER: {
+            // The square gives up room for the tracks so the whole picker fits the rect
+            RAYUI_WITH_PREFIX(ColorPicker)* cp = (RAYUI_WITH_PREFIX(ColorPicker)*)widget;
+            rect.width -= _rayui_ColorPickerStripWidth(cp);
+            if (rect.width < 0) rect.width = 0;
+            RAYUI_WITH_PREFIX(SetColorPickerRect)(cp, rect);
+        } break;
+        case WIDGET_TYPE_NUMERIC_INPUT: RAYUI_WITH_PREFIX(SetNumericInputRect)((RAYUI_WITH_PREFIX(NumericInput)*)widget, rect); break;
+        case WIDGET_TYPE_TEXT_AREA: ((RAYUI_WITH_PREFIX(TextArea)*)widget)->rect = rect; break;
+        case WIDGET_TYPE_HOVER_TEXT: ((RAYUI_WITH_PREFIX(HoverText)*)widget)->position = (Vector2){rect.x, rect.y}; break;
+        default: break;
+    }
+}
+
+static bool _rayui_IsLayoutContainer(RAYUI_WITH_PREFIX(Layout)* l, int node) {
+    return node >= 0 && node < l->count && l->nodes[node].kind != LAYOUT_KIND_WIDGET;
+}
+
+static void _rayui_MarkLayoutDirty(RAYUI_WITH_PREFIX(Layout)* l, int node) {
+    l->nodes[node].dirty = true;
+    // Ancestors of a flagged node are already flagged
+    for (int p = l->nodes[node].parent; p >= 0 && !l->nodes[p].childDirty; p = l->nodes[p].parent) {
+        l->nodes[p].childDirty = true;
+    }
+}
+
+static int _rayui_AddLayoutNode(RAYUI_WITH_PREFIX(Layout)* l, int parent, RAYUI_WITH_PREFIX(LayoutKind) kind, float width, float height) {
+    if (!_rayui_IsLayoutContainer(l, parent)) return -1;
+    if (l->count == l->capacity) {
+        int capacity = l->capacity ? l->capacity * 2 : 64;
+        _rayui_LayoutNode* nodes = (_rayui_LayoutNode*)RAYUI_REALLOC(l->nodes, capacity * sizeof(_rayui_LayoutNode));
+        if (!nodes) return -1;
+        l->nodes = nodes;
+        l->capacity = capacity;
+    }
+    int index = l->count++;
+    _rayui_LayoutNode* n = &l->nodes[index];
+    memset(n, 0, sizeof(*n));
+    n->kind = kind;
+    n->parent = parent;
+    n->firstChild = n->lastChild = n->next = -1;
+    n->width = width > 0 ? width : 0;
+    n->height = height > 0 ? height : 0;
+    n->columns = 1;
+    n->moved = true;
+
+    _rayui_LayoutNode* p = &l->nodes[parent];
+    if (p->lastChild >= 0) l->nodes[p->lastChild].next = index;
+    else p->firstChild = index;
+    p->lastChild = index;
+    p->childCount++;
+    _rayui_MarkLayoutDirty(l, parent);
+    return index;
+}
+
+RAYUI_WITH_PREFIX(Layout) RAYUI_WITH_PREFIX(CreateLayout)(Rectangle bounds) {
+    RAYUI_WITH_PREFIX(Layout) l = { NULL, 0, 0, 0, 0 };
+    l.nodes = (_rayui_LayoutNode*)RAYUI_MALLOC(64 * sizeof(_rayui_LayoutNode));
+    if (!l.nodes) return l;
+    l.capacity = 64;
+    l.count = 1;
+    _rayui_LayoutNode* root = &l.nodes[0];
+    memset(root, 0, sizeof(*root));
+    root->kind = LAYOUT_KIND_ANCHOR;
+    root->parent = root->firstChild = root->lastChild = root->next = -1;
+    root->columns = 1;
+    root->rect = bounds;
+    root->moved = true;
+    return l;
+}
+
+int RAYUI_WITH_PREFIX(AddLayoutRow)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, float spacing) {
+    int node = _rayui_AddLayoutNode(l, parent, LAYOUT_KIND_ROW, width, height);
+    if (node >= 0) l->nodes[node].spacing = spacing;
+    return node;
+}
+
+int RAYUI_WITH_PREFIX(AddLayoutColumn)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, float spacing) {
+    int node = _rayui_AddLayoutNode(l, parent, LAYOUT_KIND_COLUMN, width, height);
+    if (node >= 0) l->nodes[node].spacing = spacing;
+    return node;
+}
+
+int RAYUI_WITH_PREFIX(AddLayoutGrid)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height, int columns, float rowHeight, float spacing) {
+    int node = _rayui_AddLayoutNode(l, parent, LAYOUT_KIND_GRID, width, height);
+    if (node >= 0) {
+        l->nodes[node].columns = columns > 0 ? columns : 1;
+        l->nodes[node].rowHeight = rowHeight > 0 ? rowHeight : 0;
+        l->nodes[node].spacing = spacing;
+    }
+    return node;
+}
+
+int RAYUI_WITH_PREFIX(AddLayoutAnchor)(RAYUI_WITH_PREFIX(Layout)* l, int parent, float width, float height) {
+    return _rayui_AddLayoutNode(l, parent, LAYOUT_KIND_ANCHOR, width, height);
+}
+
+int RAYUI_WITH_PREFIX(AddLayoutWidget)(RAYUI_WITH_PREFIX(Layout)* l, int parent, RAYUI_WITH_PREFIX(WidgetType) type, void* widget, float width, float height) {
+    if (type < 0 || type >= WIDGET_TYPE_TOOLTIPS) return -1;
+    int node = _rayui_AddLayoutNode(l, parent, LAYOUT_KIND_WIDGET, width, height);
+    if (node >= 0) {
+        l->nodes[node].widgetType = type;
+        l->nodes[node].widget = widget;
+    }
+    return node;
+}
+
+void RAYUI_WITH_PREFIX(SetLayoutBounds)(RAYUI_WITH_PREFIX(Layout)* l, Rectangle bounds) {
+    if (l->count == 0) return;
+    _rayui_LayoutNode* root = &l->nodes[0];
+    if (root->rect.x == bounds.x && root->rect.y == bounds.y &&
+        root->rect.width == bounds.width && root->rect.height == bounds.height) return;
+    root->rect = bounds;
+    root->moved = true;
+}
+
+void RAYUI_WITH_PREFIX(SetLayoutSize)(RAYUI_WITH_PREFIX(Layout)* l, int node, float width, float height) {
+    if (node <= 0 || node >= l->count) return;
+    _rayui_LayoutNode* n = &l->nodes[node];
+    width = width > 0 ? width : 0;
+    height = height > 0 ? height : 0;
+    if (n->width == width && n->height == height) return;
+    n->width = width;
+    n->height = height;
+    _rayui_MarkLayoutDirty(l, n->parent);
+}
+
+void RAYUI_WITH_PREFIX(SetLayoutAnchor)(RAYUI_WITH_PREFIX(Layout)* l, int node, RAYUI_WITH_PREFIX(LayoutAnchor) anchor, Vector2 offset) {
+    if (node <= 0 || node >= l->count) return;
+    _rayui_LayoutNode* n = &l->nodes[node];
+    if (n->anchor == anchor && n->offset.x == offset.x && n->offset.y == offset.y) return;
+    n->anchor = anchor;
+    n->offset = offset;
+    _rayui_MarkLayoutDirty(l, n->parent);
+}
+
+void RAYUI_WITH_PREFIX(SetLayoutPadding)(RAYUI_WITH_PREFIX(Layout)* l, int node, float padding) {
+    if (!_rayui_IsLayoutContainer(l, node) || l->nodes[node].padding == padding) return;
+    l->nodes[node].padding = padding;
+    _rayui_MarkLayoutDirty(l, node);
+}
+
+void RAYUI_WITH_PREFIX(SetLayoutSpacing)(RAYUI_WITH_PREFIX(Layout)* l, int node, float spacing) {
+    if (!_rayui_IsLayoutContainer(l, node) || l->nodes[node].spacing == spacing) return;
+    l->nodes[node].spacing = spacing;
+    _rayui_MarkLayoutDirty(l, node);
+}
+
+Rectangle RAYUI_WITH_PREFIX(GetLayoutRect)(RAYUI_WITH_PREFIX(Layout)* l, int node) {
+    if (node < 0 || node >= l->count) return (Rectangle){0, 0, 0, 0};
+    return l->nodes[node].rect;
+}
+
+static void _rayui_PlaceLayoutNode(_rayui_LayoutNode* n, float x, float y, float width, float height) {
+    if (n->rect.x == x && n->rect.y == y && n->rect.width == width && n->rect.height == height) return;
+    n->rect = (Rectangle){x, y, width, height};
+    n->moved = true;
+}
+
+// Gives each child of a container its rect, children whose rect changes are flagged moved
+static void _rayui_ArrangeLayout(RAYUI_WITH_PREFIX(Layout)* l, _rayui_LayoutNode* n) {
+    if (n->childCount == 0) return;
+    float x = n->rect.x + n->padding;
+    float y = n->rect.y + n->padding;
+    float width = n->rect.width - 2 * n->padding;
+    float height = n->rect.height - 2 * n->padding;
+    if (width < 0) width = 0;
+    if (height < 0) height = 0;
+
+    switch (n->kind) {
+        case LAYOUT_KIND_ROW:
+        case LAYOUT_KIND_COLUMN: {
+            bool row = n->kind == LAYOUT_KIND_ROW;
+            float fixed = 0;
+            int flex = 0;
+            for (int c = n->firstChild; c >= 0; c = l->nodes[c].next) {
+                float size = row ? l->nodes[c].width : l->nodes[c].height;
+                if (size > 0) fixed += size;
+                else flex++;
+            }
+            float remaining = (row ? width : height) - fixed - n->spacing * (n->childCount - 1);
+            float share = (flex > 0 && remaining > 0) ? remaining / flex : 0;
+            float cursor = row ? x : y;
+            for (int c = n->firstChild; c >= 0; c = l->nodes[c].next) {
+                _rayui_LayoutNode* child = &l->nodes[c];
+                if (row) {
+                    float w = child->width > 0 ? child->width : share;
+                    float h = child->height > 0 ? child->height : height;
+                    _rayui_PlaceLayoutNode(child, cursor, y + (height - h) / 2, w, h);
+                    cursor += w + n->spacing;
+                } else {
+                    float w = child->width > 0 ? child->width : width;
+                    float h = child->height > 0 ? child->height : share;
+                    _rayui_PlaceLayoutNode(child, x + (width - w) / 2, cursor, w, h);
+                    cursor += h + n->spacing;
+                }
+            }
+        } break;
+        case LAYOUT_KIND_GRID: {
+            int columns = n->columns;
+            int rows = (n->childCount + columns - 1) / columns;
+            float cellWidth = (width - n->spacing * (columns - 1)) / columns;
+            float cellHeight = n->rowHeight > 0 ? n->rowHeight : (height - n->spacing * (rows - 1)) / rows;
+            if (cellWidth < 0) cellWidth = 0;
+            if (cellHeight < 0) cellHeight = 0;
+            int i = 0;
+            for (int c = n->firstChild; c >= 0; c = l->nodes[c].next, i++) {
+                _rayui_LayoutNode* child = &l->nodes[c];
+                float cellX = x + (i % columns) * (cellWidth + n->spacing);
+                float cellY = y + (i / columns) * (cellHeight + n->spacing);
+                float w = child->width > 0 ? child->width : cellWidth;
+                float h = child->height > 0 ? child->height : cellHeight;
+                _rayui_PlaceLayoutNode(child, cellX + (cellWidth - w) / 2, cellY + (cellHeight - h) / 2, w, h);
+            }
+        } break;
+        case LAYOUT_KIND_ANCHOR: {
+            for (int c = n->firstChild; c >= 0; c = l->nodes[c].next) {
+                _rayui_LayoutNode* child = &l->nodes[c];
+                float w = child->width > 0 ? child->width : width;
+                float h = child->height > 0 ? child->height : height;
+                float cx, cy;
+                switch (child->anchor % 3) {
+                    case 0: cx = x + child->offset.x; break;
+                    case 1: cx = x + (width - w) / 2 + child->offset.x; break;
+                    default: cx = x + width - w - child->offset.x; break;
+                }
+                switch (child->anchor / 3) {
+                    case 0: cy = y + child->offset.y; break;
+                    case 1: cy = y + (height - h) / 2 + child->offset.y; break;
+                    default: cy = y + height - h - child->offset.y; break;
+                }
+                _rayui_PlaceLayoutNode(child, cx, cy, w, h);
+            }
+        } break;
+        default: break;
+    }
+}
+
+static void _rayui_VisitLayout(RAYUI_WITH_PREFIX(Layout)* l, int node) {
+    _rayui_LayoutNode* n = &l->nodes[node];
+    if (n->kind == LAYOUT_KIND_WIDGET) {
+        if (n->moved && n->widget) {
+            RAYUI_WITH_PREFIX(SetWidgetRect)(n->widgetType, n->widget, n->rect);
+            l->moved++;
+        }
+    } else {
+        if (n->dirty || n->moved) {
+            _rayui_ArrangeLayout(l, n);
+            l->arranged++;
+        }
+        for (int c = n->firstChild; c >= 0; c = l->nodes[c].next) {
+            _rayui_LayoutNode* child = &l->nodes[c];
+            if (child->moved || child->dirty || child->childDirty) _rayui_VisitLayout(l, c);
+        }
+    }
+    n->moved = n->dirty = n->childDirty = false;
+}
+
+void RAYUI_WITH_PREFIX(UpdateLayout)(RAYUI_WITH_PREFIX(Layout)* l) {
+    l->arranged = 0;
+    l->moved = 0;
+    if (l->count == 0) return;
+    _rayui_LayoutNode* root = &l->nodes[0];
+    if (root->moved || root->dirty || root->childDirty) _rayui_VisitLayout(l, 0);
+}
+
+void RAYUI_WITH_PREFIX(FreeLayout)(RAYUI_WITH_PREFIX(Layout)* l) {
+    RAYUI_FREE(l->nodes);
+    l->nodes = NULL;
+    l->count = 0;
+    l->capacity = 0;
+}
+
+// ---------------- PARALLEL UPDATE ----------------
+// UpdateWidgets splits a set into chunks of RAYUI_UPDATE_CHUNK widgets. Each
+// thread starts on its own run of chunks and steals chunks from the other runs
+// once it is done. A widget is only touched by the thread updating it; sounds
+// and tooltip changes are queued per chunk and replayed in widget order after
+// all threads finish, so the outcome is the same as updating the set serially.
+// Threads are only started when compiled with RAYUI_THREADS.
+
+typedef struct _rayui_UpdateEffect {
+    Sound sound;
+    unsigned int hoverHandle; // 0 for a sound
+    bool hovered;
+} _rayui_UpdateEffect;
+
+typedef struct _rayui_UpdateWorker {
+    struct _rayui_UpdatePool* pool;
+    int index;
+    int next; // next chunk of this worker's run, taken with an atomic add by any thread
+    int end;
+    _rayui_UpdateEffect* effects;
+    int effectCount;
+    int effectCapacity;
+#ifdef RAYUI_THREADS
+    pthread_t thread;
+#endif
+} _rayui_UpdateWorker;
+
+typedef struct _rayui_UpdateChunk {
+    int worker; // whose effects list holds this chunk's effects
+    int first;
+    int count;
+} _rayui_UpdateChunk;
+
+typedef struct _rayui_UpdatePool {
+    _rayui_UpdateWorker* workers; // workers[0] is the calling thread
+    int workerCount;
+    _rayui_UpdateChunk* chunks;
+    int chunkCapacity;
+    RAYUI_WITH_PREFIX(Context)* ctx;
+    RAYUI_WITH_PREFIX(WidgetSet)* set;
+    Vector2 mouse;
+#ifdef RAYUI_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned int generation;
+    int pending;
+    bool quit;
+#endif
+} _rayui_UpdatePool;
+
+static void _rayui_QueueEffect(Sound sound, unsigned int hoverHandle, bool hovered) {
+    _rayui_UpdateWorker* w = _rayui_CurrentWorker;
+    if (w->effectCount == w->effectCapacity) {
+        int capacity = w->effectCapacity ? w->effectCapacity * 2 : 64;
+        _rayui_UpdateEffect* effects = (_rayui_UpdateEffect*)RAYUI_REALLOC(w->effects, capacity * sizeof(_rayui_UpdateEffect));
+        if (!effects) return;
+        w->effects = effects;
+        w->effectCapacity = capacity;
+    }
+    _rayui_UpdateEffect* e = &w->effects[w->effectCount++];
+    e->sound = sound;
+    e->hoverHandle = hoverHandle;
+    e->hovered = hovered;
+}
+
+static bool _rayui_UpdateWidgetRef(RAYUI_WITH_PREFIX(WidgetRef)* r, Vector2 mouse) {
+    switch (r->type) {
+        case WIDGET_TYPE_BUTTON: return RAYUI_WITH_PREFIX(UpdateButtonWithMousePoint)((RAYUI_WITH_PREFIX(Button)*)r->widget, mouse);
+        case WIDGET_TYPE_TOGGLE: RAYUI_WITH_PREFIX(UpdateToggleLabel)((RAYUI_WITH_PREFIX(ToggleLabel)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_CHECKBOX: RAYUI_WITH_PREFIX(UpdateCheckbox)((RAYUI_WITH_PREFIX(Checkbox)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_SLIDER: RAYUI_WITH_PREFIX(UpdateSlider)((RAYUI_WITH_PREFIX(Slider)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_OPTION_SLIDER: RAYUI_WITH_PREFIX(UpdateOptionSlider)((RAYUI_WITH_PREFIX(OptionSlider)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_KEYBIND: return RAYUI_WITH_PREFIX(UpdateKeybindInput)((RAYUI_WITH_PREFIX(KeybindInput)*)r->widget, mouse);
+        case WIDGET_TYPE_TEXT_INPUT: RAYUI_WITH_PREFIX(UpdateTextInputWithMousePoint)((RAYUI_WITH_PREFIX(TextInput)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_PROGRESS_BAR: RAYUI_WITH_PREFIX(UpdateProgressBar)((RAYUI_WITH_PREFIX(ProgressBar)*)r->widget); return false;
+        case WIDGET_TYPE_DROPDOWN: return RAYUI_WITH_PREFIX(UpdateDropdownWithMousePoint)((RAYUI_WITH_PREFIX(Dropdown)*)r->widget, mouse);
+        case WIDGET_TYPE_COLOR_PICKER: RAYUI_WITH_PREFIX(UpdateColorPicker)((RAYUI_WITH_PREFIX(ColorPicker)*)r->widget); return false;
+        case WIDGET_TYPE_NUMERIC_INPUT: RAYUI_WITH_PREFIX(UpdateNumericInput)((RAYUI_WITH_PREFIX(NumericInput)*)r->widget); return false;
+        case WIDGET_TYPE_TEXT_AREA: RAYUI_WITH_PREFIX(UpdateTextAreaWithMousePoint)((RAYUI_WITH_PREFIX(TextArea)*)r->widget, mouse); return false;
+        case WIDGET_TYPE_HOVER_TEXT: RAYUI_WITH_PREFIX(UpdateHoverText)((RAYUI_WITH_PREFIX(HoverText)*)r->widget, mouse); return false;
+        default: return false;
+    }
+}
+
+RAYUI_WITH_PREFIX(WidgetSet) RAYUI_WITH_PREFIX(CreateWidgetSet)(void) {
+    RAYUI_WITH_PREFIX(WidgetSet) set = { NULL, 0, 0 };
+    return set;
+}
+
+int RAYUI_WITH_PREFIX(AddWidget)(RAYUI_WITH_PREFIX(WidgetSet)* set, RAYUI_WITH_PREFIX(WidgetType) type, void* widget) {
+    if (!widget || type < 0 || type >= WIDGET_TYPE_TOOLTIPS) return -1;
+    if (set->count == set->capacity) {
+        int capacity = set->capacity ? set->capacity * 2 : 64;
+        RAYUI_WITH_PREFIX(WidgetRef)* items = (RAYUI_WITH_PREFIX(WidgetRef)*)RAYUI_REALLOC(set->items, capacity * sizeof(RAYUI_WITH_PREFIX(WidgetRef)));
+        if (!items) return -1;
+        set->items = items;
+        set->capacity = capacity;
+    }
+    RAYUI_WITH_PREFIX(WidgetRef)* r = &set->items[set->count];
+    r->type = type;
+    r->widget = widget;
+    r->result = false;
+    return set->count++;
+}
+
+void RAYUI_WITH_PREFIX(ClearWidgetSet)(RAYUI_WITH_PREFIX(WidgetSet)* set) {
+    set->count = 0;
+}
+
+void RAYUI_WITH_PREFIX(FreeWidgetSet)(RAYUI_WITH_PREFIX(WidgetSet)* set) {
+    RAYUI_FREE(set->items);
+    set->items = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+#ifdef RAYUI_THREADS
+static void _rayui_RunUpdateChunk(_rayui_UpdatePool* pool, _rayui_UpdateWorker* w, int chunk) {
+    RAYUI_WITH_PREFIX(WidgetSet)* set = pool->set;
+    int first = chunk * RAYUI_UPDATE_CHUNK;
+    int end = first + RAYUI_UPDATE_CHUNK < set->count ? first + RAYUI_UPDATE_CHUNK : set->count;
+    _rayui_UpdateChunk* c = &pool->chunks[chunk];
+    c->worker = w->index;
+    c->first = w->effectCount;
+    for (int i = first; i < end; i++)
+        set->items[i].result = _rayui_UpdateWidgetRef(&set->items[i], pool->mouse);
+    c->count = w->effectCount - c->first;
+}
+
+static void _rayui_RunUpdateWorker(_rayui_UpdatePool* pool, _rayui_UpdateWorker* w) {
+    RAYUI_WITH_PREFIX(Context)* previous = _rayui_CurrentContext;
+    _rayui_CurrentContext = pool->ctx;
+    _rayui_CurrentWorker = w;
+    w->effectCount = 0;
+
+    // Own run first, then the other runs in order
+    for (int k = 0; k < pool->workerCount; k++) {
+        _rayui_UpdateWorker* victim = &pool->workers[(w->index + k) % pool->workerCount];
+        int chunk;
+        while ((chunk = __atomic_fetch_add(&victim->next, 1, __ATOMIC_RELAXED)) < victim->end)
+            _rayui_RunUpdateChunk(pool, w, chunk);
+    }
+
+    _rayui_CurrentWorker = NULL;
+    _rayui_CurrentContext = previous;
+}
+
+static void* _rayui_UpdateThread(void* arg) {
+    _rayui_UpdateWorker* w = (_rayui_UpdateWorker*)arg;
+    _rayui_UpdatePool* pool = w->pool;
+    unsigned int seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->quit) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        _rayui_RunUpdateWorker(pool, w);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void _rayui_FreeUpdatePool(_rayui_UpdatePool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->workerCount; i++) pthread_join(pool->workers[i].thread, NULL);
+    for (int i = 0; i < pool->workerCount; i++) RAYUI_FREE(pool->workers[i].effects);
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    RAYUI_FREE(pool->chunks);
+    RAYUI_FREE(pool->workers);
+    RAYUI_FREE(pool);
+}
+
+// Starts count - 1 threads, fewer if the system refuses some
+static _rayui_UpdatePool* _rayui_CreateUpdatePool(int count) {
+    _rayui_UpdatePool* pool = (_rayui_UpdatePool*)RAYUI_CALLOC(1, sizeof(_rayui_UpdatePool));
+    if (!pool) return NULL;
+    pool->workers = (_rayui_UpdateWorker*)RAYUI_CALLOC(count, sizeof(_rayui_UpdateWorker));
+    if (!pool->workers) { RAYUI_FREE(pool); return NULL; }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->workers[0].pool = pool;
+    pool->workerCount = 1;
+    for (int i = 1; i < count; i++) {
+        _rayui_UpdateWorker* w = &pool->workers[i];
+        w->pool = pool;
+        w->index = i;
+        if (pthread_create(&w->thread, NULL, _rayui_UpdateThread, w) != 0) break;
+        pool->workerCount++;
+    }
+    return pool;
+}
+
+static bool _rayui_UpdateWidgetsParallel(RAYUI_WITH_PREFIX(Context)* ctx, RAYUI_WITH_PREFIX(WidgetSet)* set, Vector2 mouse, int chunkCount) {
+    if (!ctx->updatePool) ctx->updatePool = _rayui_CreateUpdatePool(ctx->updateThreads);
+    _rayui_UpdatePool* pool = ctx->updatePool;
+    if (!pool || pool->workerCount < 2) return false;
+    if (chunkCount > pool->chunkCapacity) {
+        _rayui_UpdateChunk* chunks = (_rayui_UpdateChunk*)RAYUI_REALLOC(pool->chunks, chunkCount * sizeof(_rayui_UpdateChunk));
+        if (!chunks) return false;
+        pool->chunks = chunks;
+        pool->chunkCapacity = chunkCount;
+    }
+
+    pool->ctx = ctx;
+    pool->set = set;
+    pool->mouse = mouse;
+    for (int i = 0; i < pool->workerCount; i++) {
+        pool->workers[i].next = (int)((long long)chunkCount * i / pool->workerCount);
+        pool->workers[i].end = (int)((long long)chunkCount * (i + 1) / pool->workerCount);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->pending = pool->workerCount - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    _rayui_RunUpdateWorker(pool, &pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    // Replay the queued effects in widget order, as the serial loop would have applied them
+    for (int c = 0; c < chunkCount; c++) {
+        const _rayui_UpdateChunk* chunk = &pool->chunks[c];
+        const _rayui_UpdateEffect* e = pool->workers[chunk->worker].effects + chunk->first;
+        for (int i = 0; i < chunk->count; i++, e++) {
+            if (e->hoverHandle) _rayui_SetHovered(e->hoverHandle, e->hovered);
+            else _rayui_PlaySound(e->sound);
+        }
+    }
+    return true;
+}
+#endif
+
+void RAYUI_WITH_PREFIX(SetUpdateThreads)(int count) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (count < 1) count = 1;
+    if (count == ctx->updateThreads) return;
+#ifdef RAYUI_THREADS
+    _rayui_FreeUpdatePool(ctx->updatePool);
+    ctx->updatePool = NULL;
+#endif
+    ctx->updateThreads = count;
+}
+
+int RAYUI_WITH_PREFIX(GetUpdateThreads)(void) {
+#ifdef RAYUI_THREADS
+    return _rayui_Ctx()->updateThreads;
+#else
+    return 1;
+#endif
+}
+
+// Workers read input from the frame snapshot only, without one the set is updated serially
+void RAYUI_WITH_PREFIX(UpdateWidgets)(RAYUI_WITH_PREFIX(WidgetSet)* set, const RAYUI_WITH_PREFIX(Input)* input) {
+    RAYUI_WITH_PREFIX(Context)* ctx = _rayui_Ctx();
+    if (input) RAYUI_WITH_PREFIX(SetFrameInput)(input);
+    if (!set || set->count == 0) return;
+    Vector2 mouse = _rayui_MousePosition();
+
+#ifdef RAYUI_THREADS
+    int chunkCount = (set->count + RAYUI_UPDATE_CHUNK - 1) / RAYUI_UPDATE_CHUNK;
+    if (ctx->updateThreads > 1 && chunkCount > 1 && ctx->inputValid) {
+#ifdef RAYUI_STATS
+        double start = GetTime();
+#endif
+        if (_rayui_UpdateWidgetsParallel(ctx, set, mouse, chunkCount)) {
+#ifdef RAYUI_STATS
+            for (int i = 0; i < set->count; i++) ctx->statsCurrent.widgets[set->items[i].type].updates++;
+            ctx->statsCurrent.updates += set->count;
+            ctx->statsCurrent.updateTime += GetTime() - start;
+#endif
+            return;
+        }
+    }
+#else
+    (void)ctx;
+#endif
+
+    for (int i = 0; i < set->count; i++)
+        set->items[i].result = _rayui_UpdateWidgetRef(&set->items[i], mouse);
+}
+
 #endif // RAYUI_IMPLEMENTATION
 
 #ifdef __cplusplus